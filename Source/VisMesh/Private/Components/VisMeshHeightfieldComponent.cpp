@@ -0,0 +1,185 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Components/VisMeshHeightfieldComponent.h"
+
+#include "Components/VisMeshHeightfieldSceneProxy.h"
+#include "Async/ParallelFor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshHeightfieldComponent)
+
+UVisMeshHeightfieldComponent::UVisMeshHeightfieldComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Heights.SetNumZeroed(NumX * NumY);
+}
+
+void UVisMeshHeightfieldComponent::SetHeightfieldSize(int32 InNumX, int32 InNumY, float InGridSpacing)
+{
+	NumX = FMath::Max(InNumX, 2);
+	NumY = FMath::Max(InNumY, 2);
+	GridSpacing = InGridSpacing;
+
+	Heights.Reset();
+	Heights.SetNumZeroed(NumX * NumY);
+	MinHeight = 0.f;
+	MaxHeight = 0.f;
+
+	// 尺寸变化需要重建 Proxy (顶点数与索引都变了)
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void UVisMeshHeightfieldComponent::SetHeights(const TArray<float>& InHeights)
+{
+	SetHeights(TArray<float>(InHeights));
+}
+
+void UVisMeshHeightfieldComponent::SetHeights(TArray<float>&& InHeights)
+{
+	EnsureHeightsSize();
+	if (InHeights.Num() != NumX * NumY)
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetHeights: expected %d heights, got %d."), NumX * NumY, InHeights.Num());
+		return;
+	}
+
+	Heights = MoveTemp(InHeights);
+	UpdateHeightRange(Heights, false);
+	SendHeightRows(0, NumY);
+}
+
+void UVisMeshHeightfieldComponent::SetHeightRows(int32 FirstRow, const TArray<float>& RowHeights)
+{
+	EnsureHeightsSize();
+	const int32 RowCount = RowHeights.Num() / NumX;
+	if (RowCount <= 0 || RowHeights.Num() != RowCount * NumX || FirstRow < 0 || FirstRow + RowCount > NumY)
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetHeightRows: %d heights from row %d do not fit a %dx%d heightfield."), RowHeights.Num(), FirstRow, NumX, NumY);
+		return;
+	}
+
+	FMemory::Memcpy(Heights.GetData() + FirstRow * NumX, RowHeights.GetData(), RowHeights.Num() * sizeof(float));
+
+	// 部分更新只扩大包围盒，避免每次都扫描全部高度
+	UpdateHeightRange(RowHeights, true);
+	SendHeightRows(FirstRow, RowCount);
+}
+
+void UVisMeshHeightfieldComponent::EnsureHeightsSize()
+{
+	NumX = FMath::Max(NumX, 2);
+	NumY = FMath::Max(NumY, 2);
+	if (Heights.Num() == NumX * NumY)
+	{
+		return;
+	}
+
+	Heights.Reset();
+	Heights.SetNumZeroed(NumX * NumY);
+	MinHeight = 0.f;
+	MaxHeight = 0.f;
+}
+
+void UVisMeshHeightfieldComponent::SendHeightRows(int32 FirstRow, int32 RowCount)
+{
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	TArray<float> RowHeights(Heights.GetData() + FirstRow * NumX, RowCount * NumX);
+
+	FVisMeshHeightfieldSceneProxy* HeightfieldSceneProxy = (FVisMeshHeightfieldSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshHeightfieldUpdate)
+	([HeightfieldSceneProxy, FirstRow, RowHeights = MoveTemp(RowHeights)](FRHICommandListImmediate& RHICmdList)
+	{
+		HeightfieldSceneProxy->UpdateHeightRows_RenderThread(RHICmdList, FirstRow, RowHeights);
+	});
+}
+
+void UVisMeshHeightfieldComponent::UpdateHeightRange(TArrayView<const float> InHeights, bool bExpandOnly)
+{
+	if (InHeights.Num() == 0)
+	{
+		return;
+	}
+
+	// 1. 分块并行求最小/最大值
+	constexpr int32 ChunkSize = 4096;
+	const int32 NumChunks = FMath::DivideAndRoundUp(InHeights.Num(), ChunkSize);
+	TArray<float> ChunkMin, ChunkMax;
+	ChunkMin.SetNumUninitialized(NumChunks);
+	ChunkMax.SetNumUninitialized(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 Begin = ChunkIdx * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, InHeights.Num());
+		float LocalMin = InHeights[Begin];
+		float LocalMax = InHeights[Begin];
+		for (int32 i = Begin + 1; i < End; i++)
+		{
+			LocalMin = FMath::Min(LocalMin, InHeights[i]);
+			LocalMax = FMath::Max(LocalMax, InHeights[i]);
+		}
+		ChunkMin[ChunkIdx] = LocalMin;
+		ChunkMax[ChunkIdx] = LocalMax;
+	});
+
+	float NewMin = bExpandOnly ? MinHeight : MAX_flt;
+	float NewMax = bExpandOnly ? MaxHeight : -MAX_flt;
+	for (int32 ChunkIdx = 0; ChunkIdx < NumChunks; ChunkIdx++)
+	{
+		NewMin = FMath::Min(NewMin, ChunkMin[ChunkIdx]);
+		NewMax = FMath::Max(NewMax, ChunkMax[ChunkIdx]);
+	}
+
+	// 2. 范围变化时才更新包围盒
+	if (NewMin != MinHeight || NewMax != MaxHeight)
+	{
+		MinHeight = NewMin;
+		MaxHeight = NewMax;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+}
+
+FPrimitiveSceneProxy* UVisMeshHeightfieldComponent::CreateSceneProxy()
+{
+	return new FVisMeshHeightfieldSceneProxy(this);
+}
+
+int32 UVisMeshHeightfieldComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+FBoxSphereBounds UVisMeshHeightfieldComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// 网格以原点为中心，与 HeightfieldDisplace.usf 一致
+	const FVector HalfExtent(0.5 * (NumX - 1) * GridSpacing, 0.5 * (NumY - 1) * GridSpacing, 0.0);
+	const FBox LocalBox(FVector(-HalfExtent.X, -HalfExtent.Y, MinHeight), FVector(HalfExtent.X, HalfExtent.Y, MaxHeight));
+
+	FBoxSphereBounds Ret(FBoxSphereBounds(LocalBox).TransformBy(LocalToWorld));
+
+	Ret.BoxExtent *= BoundsScale;
+	Ret.SphereRadius *= BoundsScale;
+
+	return Ret;
+}
+
+void UVisMeshHeightfieldComponent::PostLoad()
+{
+	Super::PostLoad();
+
+	EnsureHeightsSize();
+}
+
+#if WITH_EDITOR
+void UVisMeshHeightfieldComponent::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// 先按新尺寸调整高度，基类随后重建 Proxy
+	EnsureHeightsSize();
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+#endif
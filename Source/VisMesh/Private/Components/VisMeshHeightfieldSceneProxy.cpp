@@ -0,0 +1,257 @@
+#include "Components/VisMeshHeightfieldSceneProxy.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#include "Components/VisMeshHeightfieldComponent.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "Utils/VisMeshUtils.h"
+
+FVisMeshHeightfieldSceneProxy::FVisMeshHeightfieldSceneProxy(UVisMeshHeightfieldComponent* Component)
+	: FVisMeshSceneProxyBase(Component)
+	  , NumX(Component->GetNumX())
+	  , NumY(Component->GetNumY())
+	  , GridSpacing(Component->GetGridSpacing())
+	  , InitialHeights(Component->GetHeights())
+	  , Material(Component->GetMaterial(0))
+	  , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	bVFRequiresPrimitiveUniformBuffer = true;
+
+	if (Material == nullptr)
+	{
+		Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	}
+
+	// 与 CreateGridMeshWelded 排布相同的索引，同尺寸的 Heightfield 共享一个 IndexBuffer
+	GridIndices = VisMeshGetGridIndices(NumX, NumY, EVisMeshGridIndexLayout::Welded);
+	if (GridIndices.IsValid())
+	{
+		GridIndices->BeginInitOnce();
+	}
+}
+
+SIZE_T FVisMeshHeightfieldSceneProxy::GetTypeHash() const
+{
+	static size_t UniquePointer;
+	return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+uint32 FVisMeshHeightfieldSceneProxy::GetMemoryFootprint() const
+{
+	return (sizeof(*this) + GetAllocatedSize());
+}
+
+FPrimitiveViewRelevance FVisMeshHeightfieldSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bShadowRelevance = IsShadowCast(View);
+	Result.bDynamicRelevance = true;
+	Result.bRenderInMainPass = ShouldRenderInMainPass();
+	Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+	Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+	return Result;
+}
+
+bool FVisMeshHeightfieldSceneProxy::CanBeOccluded() const
+{
+	return !MaterialRelevance.bDisableDepthTest;
+}
+
+void FVisMeshHeightfieldSceneProxy::CreateRenderThreadResources()
+{
+	check(VertexFactory == nullptr);
+
+	if (!GridIndices.IsValid())
+	{
+		return;
+	}
+
+	FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+	const int32 NumVerts = NumX * NumY;
+
+	// 1. 高度 (CPU 上传) 与顶点流 (Compute 写入)
+	HeightBuffer = new FVisMeshTypedVertexBuffer(NumVerts, PF_R32_FLOAT, false);
+	PositionBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 3, PF_R32_FLOAT, true);
+	TangentBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 2, PF_R8G8B8A8_SNORM, true);
+	TexCoordBuffer = new FVisMeshTypedVertexBuffer(NumVerts, PF_G32R32F, true);
+	HeightBuffer->InitResource(RHICmdList);
+	PositionBuffer->InitResource(RHICmdList);
+	TangentBuffer->InitResource(RHICmdList);
+	TexCoordBuffer->InitResource(RHICmdList);
+
+	if (InitialHeights.Num() != NumVerts)
+	{
+		InitialHeights.SetNumZeroed(NumVerts);
+	}
+	HeightBuffer->Update(RHICmdList, 0, InitialHeights.GetData(), NumVerts);
+	InitialHeights.Empty();
+
+	// 首帧重建全部行
+	DirtyRowBegin = 0;
+	DirtyRowEnd = NumY;
+
+	// 2. 顶点工厂直接读取 Compute 写入的 Buffer
+	VertexFactory = new FLocalVertexFactory(GetScene().GetFeatureLevel(), "VisMeshHeightfieldVertexFactory");
+	FLocalVertexFactory::FDataType NewData;
+	NewData.PositionComponent = FVertexStreamComponent(PositionBuffer, 0, sizeof(FVector3f), VET_Float3);
+	NewData.TangentBasisComponents[0] = FVertexStreamComponent(TangentBuffer, 0, 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.TangentBasisComponents[1] = FVertexStreamComponent(TangentBuffer, sizeof(FPackedNormal), 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.TextureCoordinates.Add(FVertexStreamComponent(TexCoordBuffer, 0, sizeof(FVector2f), VET_Float2));
+	NewData.NumTexCoords = 1;
+	NewData.LightMapCoordinateIndex = 0;
+	NewData.ColorComponent = FVertexStreamComponent(&GNullColorVertexBuffer, 0, 0, VET_Color, EVertexStreamUsage::ManualFetch);
+	NewData.ColorIndexMask = 0;
+
+	if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
+	{
+		NewData.PositionComponentSRV = PositionBuffer->GetSRV();
+		NewData.TangentsSRV = TangentBuffer->GetSRV();
+		NewData.TextureCoordinatesSRV = TexCoordBuffer->GetSRV();
+		NewData.ColorComponentsSRV = GNullColorVertexBuffer.VertexBufferSRV;
+	}
+
+	VertexFactory->SetData(NewData);
+	VertexFactory->InitResource(RHICmdList);
+}
+
+void FVisMeshHeightfieldSceneProxy::DestroyRenderThreadResources()
+{
+	if (VertexFactory != nullptr)
+	{
+		VertexFactory->ReleaseResource();
+		delete VertexFactory;
+		VertexFactory = nullptr;
+	}
+
+	FVisMeshTypedVertexBuffer** Buffers[] = { &HeightBuffer, &PositionBuffer, &TangentBuffer, &TexCoordBuffer };
+	for (FVisMeshTypedVertexBuffer** Buffer : Buffers)
+	{
+		if (*Buffer != nullptr)
+		{
+			(*Buffer)->ReleaseResource();
+			delete *Buffer;
+			*Buffer = nullptr;
+		}
+	}
+
+	// GridIndices 随 Proxy 析构释放，最后一个引用负责释放 GPU 资源
+}
+
+void FVisMeshHeightfieldSceneProxy::UpdateHeightRows_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstRow, const TArray<float>& RowHeights)
+{
+	check(IsInRenderingThread());
+
+	if (HeightBuffer == nullptr || NumX <= 0)
+	{
+		return;
+	}
+
+	const int32 RowCount = RowHeights.Num() / NumX;
+	if (FirstRow < 0 || RowCount <= 0 || FirstRow + RowCount > NumY)
+	{
+		return;
+	}
+
+	// 1. 只上传变化的行 (每顶点 4 字节)
+	HeightBuffer->Update(RHICmdList, FirstRow * NumX, RowHeights.GetData(), RowCount * NumX);
+
+	// 2. 相邻行的法线也依赖这些高度，一并重建
+	const int32 NewBegin = FMath::Max(FirstRow - 1, 0);
+	const int32 NewEnd = FMath::Min(FirstRow + RowCount + 1, NumY);
+	if (DirtyRowEnd > DirtyRowBegin)
+	{
+		DirtyRowBegin = FMath::Min(DirtyRowBegin, NewBegin);
+		DirtyRowEnd = FMath::Max(DirtyRowEnd, NewEnd);
+	}
+	else
+	{
+		DirtyRowBegin = NewBegin;
+		DirtyRowEnd = NewEnd;
+	}
+}
+
+void FVisMeshHeightfieldSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily)
+{
+	if (VertexFactory == nullptr || DirtyRowEnd <= DirtyRowBegin)
+	{
+		return;
+	}
+
+	AddHeightfieldDisplacePass(GraphBuilder, HeightBuffer->GetSRV(), PositionBuffer->GetUAV(), TangentBuffer->GetUAV(), TexCoordBuffer->GetUAV(),
+		NumX, NumY, GridSpacing, DirtyRowBegin, DirtyRowEnd - DirtyRowBegin);
+
+	DirtyRowBegin = 0;
+	DirtyRowEnd = 0;
+}
+
+void FVisMeshHeightfieldSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
+{
+	if (VertexFactory == nullptr || !GridIndices.IsValid())
+	{
+		return;
+	}
+
+	// Set up wireframe material (if needed)
+	const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+	FColoredMaterialRenderProxy* WireframeMaterialInstance = nullptr;
+	if (bWireframe)
+	{
+		WireframeMaterialInstance = new FColoredMaterialRenderProxy(GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : NULL, FLinearColor(0, 0.5f, 1.f));
+		Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+	}
+
+	FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Material->GetRenderProxy();
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = GridIndices.Get();
+			Mesh.bWireframe = bWireframe;
+			Mesh.VertexFactory = VertexFactory;
+			Mesh.MaterialRenderProxy = MaterialProxy;
+
+			bool bHasPrecomputedVolumetricLightmap;
+			FMatrix PreviousLocalToWorld;
+			int32 SingleCaptureIndex;
+			bool bOutputVelocity;
+			GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
+			bOutputVelocity |= AlwaysHasVelocity();
+
+			FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+			DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(),
+			                                  GetLocalBounds(), GetLocalBounds(), ReceivesDecals(),
+			                                  bHasPrecomputedVolumetricLightmap, bOutputVelocity,
+			                                  GetCustomPrimitiveData());
+			BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+
+			BatchElement.FirstIndex = 0;
+			BatchElement.NumPrimitives = GridIndices->GetIndices().Num() / 3;
+			BatchElement.MinVertexIndex = 0;
+			BatchElement.MaxVertexIndex = NumX * NumY - 1;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = false;
+			Collector.AddMesh(ViewIndex, Mesh);
+		}
+	}
+
+	// Draw bounds
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			RenderBounds(Collector.GetPDI(ViewIndex), ViewFamily.EngineShowFlags, GetBounds(), IsSelected());
+		}
+	}
+#endif
+}
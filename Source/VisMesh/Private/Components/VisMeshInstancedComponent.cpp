@@ -5,6 +5,7 @@
 
 #include "MaterialDomain.h"
 #include "Components/VisMeshInstancedSceneProxy.h"
+#include "Async/ParallelFor.h"
 
 
 // Sets default values for this component's properties
@@ -42,6 +43,243 @@ void UVisMeshInstancedComponent::TickComponent(float DeltaTime, ELevelTick TickT
 	// ...
 }
 
+void UVisMeshInstancedComponent::SetBarLayout(int32 InNumColumns, float InXSpace, float InYSpace, float InBarWidth)
+{
+	NumColumns = FMath::Max(InNumColumns, 1);
+	XSpace = InXSpace;
+	YSpace = InYSpace;
+	BarWidth = InBarWidth;
+	MarkRenderStateDirty();
+}
+
+void UVisMeshInstancedComponent::SetBarValues(const TArray<float>& Heights, const TArray<float>& ColorValues)
+{
+	if (ColorValues.Num() != 0 && ColorValues.Num() != Heights.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetBarValues: %d heights but %d color values."), Heights.Num(), ColorValues.Num());
+		return;
+	}
+
+	TArray<FVector2f> NewValues;
+	NewValues.SetNumUninitialized(Heights.Num());
+	const bool bHasColors = ColorValues.Num() != 0;
+	ParallelFor(Heights.Num(), [&](int32 i)
+	{
+		NewValues[i] = FVector2f(Heights[i], bHasColors ? ColorValues[i] : Heights[i]);
+	});
+
+	SetBarValues(MoveTemp(NewValues));
+}
+
+void UVisMeshInstancedComponent::SetBarValues(TArray<FVector2f>&& InBarValues)
+{
+	const bool bCountChanged = InBarValues.Num() != BarValues.Num() || BarCapacity > 0;
+	const bool bWasAnimating = GetTransitionAlpha() < 1.f;
+	BarValues = MoveTemp(InBarValues);
+	BarRects.Empty();
+	BarCapacity = 0;
+
+	// 直接设置数值会结束正在进行的过渡
+	PreviousBarValues.Empty();
+	TransitionDuration = 0.f;
+
+	// 柱子数量变化需要重建实例缓冲区，否则只上传数值
+	if (bCountChanged)
+	{
+		NumInstances = FMath::Max(BarValues.Num(), 1);
+		MarkRenderStateDirty();
+		return;
+	}
+
+	if (bWasAnimating && SceneProxy != nullptr && !IsRenderStateDirty())
+	{
+		FVisMeshInstancedSceneProxy* InstancedSceneProxy = (FVisMeshInstancedSceneProxy*)SceneProxy;
+		ENQUEUE_RENDER_COMMAND(FVisMeshBarTransitionStop)
+		([InstancedSceneProxy](FRHICommandListImmediate& RHICmdList)
+		{
+			InstancedSceneProxy->StartBarTransition_RenderThread(RHICmdList, {}, {}, 0.0, 0.f);
+		});
+	}
+
+	SendBarValueRanges({ FIntPoint(0, BarValues.Num()) });
+}
+
+void UVisMeshInstancedComponent::SetBarValuesAnimated(const TArray<float>& Heights, const TArray<float>& ColorValues, float Duration)
+{
+	if (ColorValues.Num() != 0 && ColorValues.Num() != Heights.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetBarValuesAnimated: %d heights but %d color values."), Heights.Num(), ColorValues.Num());
+		return;
+	}
+
+	TArray<FVector2f> NewValues;
+	NewValues.SetNumUninitialized(Heights.Num());
+	const bool bHasColors = ColorValues.Num() != 0;
+	ParallelFor(Heights.Num(), [&](int32 i)
+	{
+		NewValues[i] = FVector2f(Heights[i], bHasColors ? ColorValues[i] : Heights[i]);
+	});
+
+	SetBarValuesAnimated(MoveTemp(NewValues), Duration);
+}
+
+void UVisMeshInstancedComponent::SetBarValuesAnimated(TArray<FVector2f>&& InBarValues, float Duration)
+{
+	UWorld* World = GetWorld();
+	if (Duration <= 0.f || World == nullptr || InBarValues.Num() != BarValues.Num() || BarCapacity > 0)
+	{
+		SetBarValues(MoveTemp(InBarValues));
+		return;
+	}
+
+	// 1. 起始数值为当前显示的数值：上一次过渡未结束时按相同的缓动在 CPU 上插值
+	const float Alpha = GetTransitionAlpha();
+	if (Alpha < 1.f)
+	{
+		ParallelFor(BarValues.Num(), [&](int32 i)
+		{
+			PreviousBarValues[i] = FMath::Lerp(PreviousBarValues[i], BarValues[i], Alpha);
+		});
+	}
+	else
+	{
+		PreviousBarValues = MoveTemp(BarValues);
+	}
+	BarValues = MoveTemp(InBarValues);
+
+	TransitionStartTime = World->GetRealTimeSeconds();
+	TransitionDuration = Duration;
+
+	// 2. 两组数值只上传一次，之后由 Compute 每帧插值
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	FVisMeshInstancedSceneProxy* InstancedSceneProxy = (FVisMeshInstancedSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshBarTransitionStart)
+	([InstancedSceneProxy, Previous = PreviousBarValues, Target = BarValues, StartTime = TransitionStartTime, Duration](FRHICommandListImmediate& RHICmdList)
+	{
+		InstancedSceneProxy->StartBarTransition_RenderThread(RHICmdList, Previous, Target, StartTime, Duration);
+	});
+}
+
+void UVisMeshInstancedComponent::SetBarRects(TArray<FVector4f>&& InRects, TArray<FVector2f>&& InValues)
+{
+	if (InRects.Num() != InValues.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetBarRects: %d rects but %d values."), InRects.Num(), InValues.Num());
+		return;
+	}
+
+	// 自由布局不做过渡动画 (实例数量与含义每次都可能变化)
+	const bool bRecreate = InRects.Num() > BarCapacity;
+	BarRects = MoveTemp(InRects);
+	BarValues = MoveTemp(InValues);
+	PreviousBarValues.Empty();
+	TransitionDuration = 0.f;
+
+	// 1. 超出容量 (或从网格模式切换) 时按 2 的幂扩容并重建 Proxy
+	if (bRecreate)
+	{
+		BarCapacity = FMath::RoundUpToPowerOfTwo(FMath::Max(BarRects.Num(), 1));
+		NumInstances = BarRects.Num();
+		MarkRenderStateDirty();
+		return;
+	}
+
+	// 2. 容量足够：只上传数据并修改实例数量
+	NumInstances = BarRects.Num();
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	FVisMeshInstancedSceneProxy* InstancedSceneProxy = (FVisMeshInstancedSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshBarRectsUpdate)
+	([InstancedSceneProxy, Rects = BarRects, Values = BarValues](FRHICommandListImmediate& RHICmdList)
+	{
+		InstancedSceneProxy->UpdateBarRects_RenderThread(RHICmdList, Rects, Values);
+	});
+}
+
+float UVisMeshInstancedComponent::GetTransitionAlpha() const
+{
+	const UWorld* World = GetWorld();
+	if (TransitionDuration <= 0.f || World == nullptr)
+	{
+		return 1.f;
+	}
+
+	const float T = FMath::Clamp(float(World->GetRealTimeSeconds() - TransitionStartTime) / TransitionDuration, 0.f, 1.f);
+	return FMath::SmoothStep(0.f, 1.f, T);
+}
+
+void UVisMeshInstancedComponent::UpdateBarValueRanges(const TArray<FIntPoint>& Ranges, const TArray<FVector2f>& Values)
+{
+	// 1. 校验区间并写入 CPU 副本
+	int32 ValueOffset = 0;
+	for (const FIntPoint& Range : Ranges)
+	{
+		if (Range.X < 0 || Range.Y <= 0 || Range.X + Range.Y > BarValues.Num() || ValueOffset + Range.Y > Values.Num())
+		{
+			UE_LOG(LogVisComponent, Warning, TEXT("UpdateBarValueRanges: range (%d, %d) is out of bounds (%d bars, %d values)."), Range.X, Range.Y, BarValues.Num(), Values.Num());
+			return;
+		}
+		ValueOffset += Range.Y;
+	}
+
+	ValueOffset = 0;
+	for (const FIntPoint& Range : Ranges)
+	{
+		FMemory::Memcpy(BarValues.GetData() + Range.X, Values.GetData() + ValueOffset, Range.Y * sizeof(FVector2f));
+		ValueOffset += Range.Y;
+	}
+
+	// 2. 上传
+	SendBarValueRanges(Ranges);
+}
+
+void UVisMeshInstancedComponent::SendBarValueRanges(const TArray<FIntPoint>& Ranges)
+{
+	if (SceneProxy == nullptr || IsRenderStateDirty() || Ranges.Num() == 0)
+	{
+		return;
+	}
+
+	// 区间过多时合并为一个覆盖区间，避免大量小块 Lock
+	constexpr int32 MaxRangeUploads = 64;
+	TArray<FIntPoint> UploadRanges;
+	if (Ranges.Num() > MaxRangeUploads)
+	{
+		int32 First = MAX_int32;
+		int32 End = 0;
+		for (const FIntPoint& Range : Ranges)
+		{
+			First = FMath::Min(First, Range.X);
+			End = FMath::Max(End, Range.X + Range.Y);
+		}
+		UploadRanges.Add(FIntPoint(First, End - First));
+	}
+	else
+	{
+		UploadRanges = Ranges;
+	}
+
+	TArray<FVector2f> PackedValues;
+	for (const FIntPoint& Range : UploadRanges)
+	{
+		PackedValues.Append(BarValues.GetData() + Range.X, Range.Y);
+	}
+
+	FVisMeshInstancedSceneProxy* InstancedSceneProxy = (FVisMeshInstancedSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshBarValuesUpdate)
+	([InstancedSceneProxy, UploadRanges = MoveTemp(UploadRanges), PackedValues = MoveTemp(PackedValues)](FRHICommandListImmediate& RHICmdList)
+	{
+		InstancedSceneProxy->UpdateBarValues_RenderThread(RHICmdList, UploadRanges, PackedValues);
+	});
+}
+
 FPrimitiveSceneProxy* UVisMeshInstancedComponent::CreateSceneProxy()
 {
 	return new FVisMeshInstancedSceneProxy(this);
@@ -20,9 +20,36 @@ FVisMeshInstancedSceneProxy::FVisMeshInstancedSceneProxy(UVisMeshInstancedCompon
 	bVFRequiresPrimitiveUniformBuffer = true;
 
 	NumInstances = Owner->NumInstances > 1 ? Owner->NumInstances : 1;
+	InstanceCapacity = NumInstances;
 	XSpace = Owner->XSpace;
 	YSpace = Owner->YSpace;
 	NumColumns = Owner->NumColumns;
+
+	// 自由布局的实例数量可以为 0，以容量判断
+	if (Owner->GetBarValues().Num() > 0 || Owner->GetBarCapacity() > 0)
+	{
+		bDataDriven = true;
+		BarWidth = Owner->BarWidth;
+		NumColumns = FMath::Max(NumColumns, 1);
+		InitialBarValues = Owner->GetBarValues();
+		NumInstances = InitialBarValues.Num();
+		InstanceCapacity = NumInstances;
+
+		if (Owner->GetBarCapacity() > 0)
+		{
+			bUseBarRects = true;
+			InitialBarRects = Owner->GetBarRects();
+			InstanceCapacity = FMath::Max(NumInstances, Owner->GetBarCapacity());
+		}
+
+		// Proxy 在过渡途中重建时继续过渡
+		if (Owner->GetTransitionAlpha() < 1.f && Owner->GetPreviousBarValues().Num() == NumInstances)
+		{
+			InitialPreviousBarValues = Owner->GetPreviousBarValues();
+			TransitionStartTime = Owner->GetTransitionStartTime();
+			TransitionDuration = Owner->GetTransitionDuration();
+		}
+	}
 }
 
 SIZE_T FVisMeshInstancedSceneProxy::GetTypeHash() const
@@ -127,9 +154,37 @@ void FVisMeshInstancedSceneProxy::CreateRenderThreadResources()
 		IndexBuffer->InitResource(RHICmdList);  // 关键：调用 InitResource
 	}
 
-	InstanceBuffer = new FVisMeshInstanceBuffer(NumInstances);
+	InstanceBuffer = new FVisMeshInstanceBuffer(InstanceCapacity);
 	InstanceBuffer->InitResource(RHICmdList);
 
+	if (bDataDriven)
+	{
+		BarValueBuffer = new FVisMeshTypedVertexBuffer(InstanceCapacity, PF_G32R32F, false);
+		BarValueBuffer->InitResource(RHICmdList);
+
+		PreviousBarValueBuffer = new FVisMeshTypedVertexBuffer(InstanceCapacity, PF_G32R32F, false);
+		PreviousBarValueBuffer->InitResource(RHICmdList);
+
+		// 网格模式下只需要一个占位元素
+		BarRectBuffer = new FVisMeshTypedVertexBuffer(bUseBarRects ? InstanceCapacity : 1, PF_A32B32G32R32F, false);
+		BarRectBuffer->InitResource(RHICmdList);
+
+		if (NumInstances > 0)
+		{
+			BarValueBuffer->Update(RHICmdList, 0, InitialBarValues.GetData(), NumInstances);
+			const TArray<FVector2f>& PreviousValues = InitialPreviousBarValues.Num() == NumInstances ? InitialPreviousBarValues : InitialBarValues;
+			PreviousBarValueBuffer->Update(RHICmdList, 0, PreviousValues.GetData(), NumInstances);
+			if (bUseBarRects)
+			{
+				BarRectBuffer->Update(RHICmdList, 0, InitialBarRects.GetData(), NumInstances);
+			}
+		}
+
+		InitialBarValues.Empty();
+		InitialPreviousBarValues.Empty();
+		InitialBarRects.Empty();
+	}
+
 	VertexFactory = new FVisMeshInstancedVertexFactory(GetScene().GetFeatureLevel(), "VisMeshInstancedVertexFactory");
 	FLocalVertexFactory::FDataType NewData;
 	NewData.PositionComponent = FVertexStreamComponent(PositionBuffer, 0, sizeof(FVector3f), VET_Float3);
@@ -249,6 +304,74 @@ void FVisMeshInstancedSceneProxy::DestroyRenderThreadResources()
 		delete InstanceBuffer;
 		InstanceBuffer = nullptr;
 	}
+	if (BarValueBuffer)
+	{
+		BarValueBuffer->ReleaseResource();
+		delete BarValueBuffer;
+		BarValueBuffer = nullptr;
+	}
+	if (PreviousBarValueBuffer)
+	{
+		PreviousBarValueBuffer->ReleaseResource();
+		delete PreviousBarValueBuffer;
+		PreviousBarValueBuffer = nullptr;
+	}
+	if (BarRectBuffer)
+	{
+		BarRectBuffer->ReleaseResource();
+		delete BarRectBuffer;
+		BarRectBuffer = nullptr;
+	}
+}
+
+void FVisMeshInstancedSceneProxy::UpdateBarRects_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FVector4f>& Rects,
+	const TArray<FVector2f>& Values)
+{
+	if (!bUseBarRects || BarRectBuffer == nullptr || BarValueBuffer == nullptr)
+	{
+		return;
+	}
+
+	check(Rects.Num() == Values.Num() && Rects.Num() <= InstanceCapacity);
+	NumInstances = Rects.Num();
+	if (NumInstances > 0)
+	{
+		BarRectBuffer->Update(RHICmdList, 0, Rects.GetData(), NumInstances);
+		BarValueBuffer->Update(RHICmdList, 0, Values.GetData(), NumInstances);
+	}
+}
+
+void FVisMeshInstancedSceneProxy::StartBarTransition_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FVector2f>& PreviousValues,
+	const TArray<FVector2f>& TargetValues, double InStartTime, float InDuration)
+{
+	TransitionStartTime = InStartTime;
+	TransitionDuration = InDuration;
+	if (InDuration <= 0.f || BarValueBuffer == nullptr || PreviousBarValueBuffer == nullptr)
+	{
+		TransitionDuration = 0.f;
+		return;
+	}
+
+	check(PreviousValues.Num() == NumInstances && TargetValues.Num() == NumInstances);
+	PreviousBarValueBuffer->Update(RHICmdList, 0, PreviousValues.GetData(), NumInstances);
+	BarValueBuffer->Update(RHICmdList, 0, TargetValues.GetData(), NumInstances);
+}
+
+void FVisMeshInstancedSceneProxy::UpdateBarValues_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FIntPoint>& Ranges,
+	const TArray<FVector2f>& PackedValues)
+{
+	if (BarValueBuffer == nullptr)
+	{
+		return;
+	}
+
+	int32 ValueOffset = 0;
+	for (const FIntPoint& Range : Ranges)
+	{
+		check(Range.X >= 0 && Range.X + Range.Y <= NumInstances);
+		BarValueBuffer->Update(RHICmdList, Range.X, PackedValues.GetData() + ValueOffset, Range.Y);
+		ValueOffset += Range.Y;
+	}
 }
 
 void FVisMeshInstancedSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -312,6 +435,12 @@ FMeshBatch* FVisMeshInstancedSceneProxy::CreateMeshBatch(class FMeshElementColle
 void FVisMeshInstancedSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder,
                                                                    const FSceneViewFamily& ViewFamily)
 {
+	// 隐藏时 (如柱状图切回合并网格模式) 不展开实例，组件保留的数值不会每帧触发 Compute
+	if (ViewFamily.Views.Num() > 0 && !IsShown(ViewFamily.Views[0]))
+	{
+		return;
+	}
+
 	if (PositionBuffer && IndirectArgsBuffer && InstanceBuffer)
 	{
 		const float CurrentTime = ViewFamily.Time.GetRealTimeSeconds();
@@ -336,6 +465,30 @@ void FVisMeshInstancedSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder&
 		}
 		FMatrix44f ViewProjectionMatrix = FMatrix44f(ViewProjMatrix.GetTransposed());
 		FMatrix44f ModelMatrix = FMatrix44f(GetLocalToWorld());
+		if (bDataDriven && BarValueBuffer)
+		{
+			if (NumInstances == 0)
+			{
+				// 参数已清零，不绘制任何实例
+				return;
+			}
+
+			// 过渡进度：与 UVisMeshInstancedComponent::GetTransitionAlpha 相同的缓动
+			float TransitionAlpha = 1.f;
+			if (TransitionDuration > 0.f)
+			{
+				const float T = FMath::Clamp(float(ViewFamily.Time.GetRealTimeSeconds() - TransitionStartTime) / TransitionDuration, 0.f, 1.f);
+				TransitionAlpha = FMath::SmoothStep(0.f, 1.f, T);
+			}
+
+			// 数据驱动：由每根柱子的数值展开实例
+			AddBarChartInstancePass(GraphBuilder, BarValueBuffer->GetSRV(), PreviousBarValueBuffer->GetSRV(), TransitionAlpha,
+			                        BarRectBuffer->GetSRV(), bUseBarRects,
+			                        InstanceBuffer->GetOriginUAV(), InstanceBuffer->GetTransformUAV(),
+			                        IndirectArgsUAVRDG, XSpace, YSpace, BarWidth, NumColumns, NumInstances, ViewProjectionMatrix, ModelMatrix);
+			return;
+		}
+
 		// 调用具体的 Pass 添加函数 (这个函数可以是静态的，或者 VisMeshUtils 里的)
 		AddBoxChartFrustumCulledInstancePass(GraphBuilder,
 									InstanceBuffer->GetOriginUAV(),
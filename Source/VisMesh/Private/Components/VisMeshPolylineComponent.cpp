@@ -0,0 +1,489 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Components/VisMeshPolylineComponent.h"
+
+#include "Components/VisMeshPolylineSceneProxy.h"
+#include "Utils/VisMeshUtils.h"
+#include "Async/ParallelFor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshPolylineComponent)
+
+UVisMeshPolylineComponent::UVisMeshPolylineComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UVisMeshPolylineComponent::SetPolylines(const TArray<FVector>& Positions, const TArray<int32>& InStripOffsets, const TArray<float>& Widths, const TArray<FLinearColor>& InColors)
+{
+	TArray<FVector3f> Positions3f;
+	Positions3f.SetNumUninitialized(Positions.Num());
+	TArray<FColor> Colors8;
+	Colors8.SetNumUninitialized(InColors.Num());
+	ParallelFor(FMath::Max(Positions.Num(), InColors.Num()), [&](int32 i)
+	{
+		if (i < Positions.Num())
+		{
+			Positions3f[i] = FVector3f(Positions[i]);
+		}
+		if (i < InColors.Num())
+		{
+			Colors8[i] = InColors[i].ToFColor(true);
+		}
+	});
+
+	SetPolylines(Positions3f, InStripOffsets, Widths, Colors8);
+}
+
+void UVisMeshPolylineComponent::SetPolylines(TArrayView<const FVector3f> Positions, TArrayView<const int32> InStripOffsets, TArrayView<const float> Widths, TArrayView<const FColor> InColors)
+{
+	const int32 NumPoints = Positions.Num();
+	if ((Widths.Num() != 0 && Widths.Num() != NumPoints) || (InColors.Num() != 0 && InColors.Num() != NumPoints))
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetPolylines: %d positions but %d widths and %d colors."), NumPoints, Widths.Num(), InColors.Num());
+		return;
+	}
+
+	// 1. 检查分段：从 0 开始严格递增且不超过点数
+	TArray<int32> NewStripOffsets;
+	if (InStripOffsets.Num() == 0)
+	{
+		if (NumPoints > 0)
+		{
+			NewStripOffsets.Add(0);
+		}
+	}
+	else
+	{
+		for (int32 Strip = 0; Strip < InStripOffsets.Num(); Strip++)
+		{
+			const bool bValid = Strip == 0 ? InStripOffsets[0] == 0 : InStripOffsets[Strip] > InStripOffsets[Strip - 1];
+			if (!bValid || InStripOffsets[Strip] >= NumPoints)
+			{
+				UE_LOG(LogVisComponent, Warning, TEXT("SetPolylines: strip offset %d (%d) is not ascending from 0 within %d points."), Strip, InStripOffsets[Strip], NumPoints);
+				return;
+			}
+		}
+		NewStripOffsets = TArray<int32>(InStripOffsets.GetData(), InStripOffsets.Num());
+	}
+
+	// 2. 打包 (Position, Width)，并标记每条线的首尾点
+	Points.SetNumUninitialized(NumPoints);
+	Colors.SetNumUninitialized(NumPoints);
+	StripFlags.SetNumZeroed(NumPoints);
+	const bool bHasWidths = Widths.Num() != 0;
+	const bool bHasColors = InColors.Num() != 0;
+	ParallelFor(NumPoints, [&](int32 i)
+	{
+		Points[i] = FVector4f(Positions[i], bHasWidths ? Widths[i] : DefaultWidth);
+		Colors[i] = bHasColors ? InColors[i] : FColor::White;
+	});
+
+	StripOffsets = MoveTemp(NewStripOffsets);
+	for (int32 Strip = 0; Strip < StripOffsets.Num(); Strip++)
+	{
+		const int32 End = Strip + 1 < StripOffsets.Num() ? StripOffsets[Strip + 1] : NumPoints;
+		StripFlags[StripOffsets[Strip]] |= VisMeshPolyline_StripFirst;
+		StripFlags[End - 1] |= VisMeshPolyline_StripLast;
+	}
+
+	UpdatePolylineBounds(Points, false);
+	SendPoints(0, NumPoints, true);
+}
+
+void UVisMeshPolylineComponent::AppendPolyline(const TArray<FVector>& Positions, float Width, FLinearColor Color)
+{
+	TArray<FVector3f> Positions3f;
+	Positions3f.SetNumUninitialized(Positions.Num());
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		Positions3f[i] = FVector3f(Positions[i]);
+	}
+
+	TArray<float> Widths;
+	Widths.Init(Width, Positions.Num());
+	TArray<FColor> Colors8;
+	Colors8.Init(Color.ToFColor(true), Positions.Num());
+
+	AppendPolyline(Positions3f, Widths, Colors8);
+}
+
+void UVisMeshPolylineComponent::AppendPolyline(TArrayView<const FVector3f> Positions, TArrayView<const float> Widths, TArrayView<const FColor> InColors)
+{
+	const int32 NumNewPoints = Positions.Num();
+	if (NumNewPoints == 0 || (Widths.Num() != 0 && Widths.Num() != NumNewPoints) || (InColors.Num() != 0 && InColors.Num() != NumNewPoints))
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("AppendPolyline: %d positions but %d widths and %d colors."), NumNewPoints, Widths.Num(), InColors.Num());
+		return;
+	}
+
+	// 新的线段接在末尾，已有点的首尾标记不变
+	const int32 FirstPoint = Points.Num();
+	StripOffsets.Add(FirstPoint);
+	Points.Reserve(FirstPoint + NumNewPoints);
+	Colors.Reserve(FirstPoint + NumNewPoints);
+	StripFlags.Reserve(FirstPoint + NumNewPoints);
+	for (int32 i = 0; i < NumNewPoints; i++)
+	{
+		Points.Add(FVector4f(Positions[i], Widths.Num() != 0 ? Widths[i] : DefaultWidth));
+		Colors.Add(InColors.Num() != 0 ? InColors[i] : FColor::White);
+		StripFlags.Add(0);
+	}
+	StripFlags[FirstPoint] |= VisMeshPolyline_StripFirst;
+	StripFlags.Last() |= VisMeshPolyline_StripLast;
+
+	UpdatePolylineBounds(TArrayView<const FVector4f>(Points.GetData() + FirstPoint, NumNewPoints), true);
+	SendPoints(FirstPoint, NumNewPoints, true);
+}
+
+void UVisMeshPolylineComponent::UpdatePolylinePoints(int32 FirstPoint, TArrayView<const FVector3f> Positions)
+{
+	if (Positions.Num() == 0 || FirstPoint < 0 || FirstPoint + Positions.Num() > Points.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("UpdatePolylinePoints: %d points from %d do not fit %d points."), Positions.Num(), FirstPoint, Points.Num());
+		return;
+	}
+
+	for (int32 i = 0; i < Positions.Num(); i++)
+	{
+		FVector4f& Point = Points[FirstPoint + i];
+		Point = FVector4f(Positions[i], Point.W);
+	}
+
+	// 部分更新只扩大包围盒，避免每次都扫描全部点
+	UpdatePolylineBounds(TArrayView<const FVector4f>(Points.GetData() + FirstPoint, Positions.Num()), true);
+	SendPoints(FirstPoint, Positions.Num(), false);
+}
+
+void UVisMeshPolylineComponent::ClearPolylines()
+{
+	DecimationSource.Empty();
+	DecimationStripOffsets.Empty();
+	DecimationStripColors.Empty();
+	DecimationLevels.Empty();
+	bDecimationSubmitted = false;
+
+	SetPolylines(TArrayView<const FVector3f>(), TArrayView<const int32>(), TArrayView<const float>(), TArrayView<const FColor>());
+}
+
+void UVisMeshPolylineComponent::SetDecimationSource(const TArray<FVector>& Positions, const TArray<int32>& InStripOffsets, const TArray<FLinearColor>& StripColors, EVisMeshPolylineDecimation Mode)
+{
+	TArray<FVector3f> Positions3f;
+	Positions3f.SetNumUninitialized(Positions.Num());
+	ParallelFor(Positions.Num(), [&](int32 i)
+	{
+		Positions3f[i] = FVector3f(Positions[i]);
+	});
+
+	TArray<FColor> Colors8;
+	Colors8.SetNumUninitialized(StripColors.Num());
+	for (int32 Strip = 0; Strip < StripColors.Num(); Strip++)
+	{
+		Colors8[Strip] = StripColors[Strip].ToFColor(true);
+	}
+
+	SetDecimationSource(MoveTemp(Positions3f), TArray<int32>(InStripOffsets), MoveTemp(Colors8), Mode);
+}
+
+void UVisMeshPolylineComponent::SetDecimationSource(TArray<FVector3f>&& Positions, TArray<int32>&& InStripOffsets, TArray<FColor>&& StripColors, EVisMeshPolylineDecimation Mode)
+{
+	if (InStripOffsets.Num() == 0 && Positions.Num() > 0)
+	{
+		InStripOffsets.Add(0);
+	}
+	for (int32 Strip = 0; Strip < InStripOffsets.Num(); Strip++)
+	{
+		const bool bValid = Strip == 0 ? InStripOffsets[0] == 0 : InStripOffsets[Strip] > InStripOffsets[Strip - 1];
+		if (!bValid || InStripOffsets[Strip] >= Positions.Num())
+		{
+			UE_LOG(LogVisComponent, Warning, TEXT("SetDecimationSource: strip offset %d (%d) is not ascending from 0 within %d points."), Strip, InStripOffsets[Strip], Positions.Num());
+			return;
+		}
+	}
+	if (StripColors.Num() != 0 && StripColors.Num() != InStripOffsets.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetDecimationSource: %d polylines but %d colors."), InStripOffsets.Num(), StripColors.Num());
+		return;
+	}
+
+	DecimationSource = MoveTemp(Positions);
+	DecimationStripOffsets = MoveTemp(InStripOffsets);
+	DecimationStripColors = MoveTemp(StripColors);
+	DecimationMode = Mode;
+
+	// 分块并行求源数据的包围盒
+	constexpr int32 ChunkSize = 64 * 1024;
+	const int32 NumChunks = FMath::DivideAndRoundUp(DecimationSource.Num(), ChunkSize);
+	TArray<FBox3f> ChunkBounds;
+	ChunkBounds.SetNumUninitialized(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 Begin = ChunkIdx * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, DecimationSource.Num());
+		FBox3f LocalBox(ForceInit);
+		for (int32 i = Begin; i < End; i++)
+		{
+			LocalBox += DecimationSource[i];
+		}
+		ChunkBounds[ChunkIdx] = LocalBox;
+	});
+	DecimationBounds = FBox3f(ForceInit);
+	for (const FBox3f& Box : ChunkBounds)
+	{
+		DecimationBounds += Box;
+	}
+
+	// 源数据变化，缓存的级别全部失效，下一次 UpdateDecimationView 重新提交
+	DecimationLevels.Empty();
+	bDecimationSubmitted = false;
+}
+
+int32 UVisMeshPolylineComponent::GetDecimationLevel(float PixelSize) const
+{
+	// 时间序列按 X 分列，任意折线的误差按最大边长计算
+	const FVector3f Extent = DecimationBounds.IsValid ? DecimationBounds.GetSize() : FVector3f::ZeroVector;
+	const float Range = DecimationMode == EVisMeshPolylineDecimation::MinMaxColumns ? Extent.X : Extent.GetMax();
+	if (Range <= UE_SMALL_NUMBER || PixelSize <= UE_SMALL_NUMBER)
+	{
+		return INDEX_NONE;
+	}
+
+	// 级别 L 的列宽 (误差) = Range / 2^L 不超过一个像素，每个像素至多对应两列
+	const int32 Level = FMath::Clamp(FMath::CeilToInt32(FMath::Log2(Range / PixelSize)), 0, 24);
+
+	// 抽稀后的点数上界 (每列 4 个点) 不少于原始点数时直接绘制原始数据
+	if ((int64(4) << Level) >= DecimationSource.Num())
+	{
+		return INDEX_NONE;
+	}
+	return Level;
+}
+
+const UVisMeshPolylineComponent::FDecimationLevel& UVisMeshPolylineComponent::FindOrBuildDecimationLevel(int32 Level)
+{
+	if (const FDecimationLevel* Cached = DecimationLevels.Find(Level))
+	{
+		return *Cached;
+	}
+
+	// 1. 逐条线抽稀 (抽稀函数内部已并行)，列从整个源数据的最小 X 开始，平移时同一级别的结果不变
+	const FVector3f Extent = DecimationBounds.GetSize();
+	const float Range = DecimationMode == EVisMeshPolylineDecimation::MinMaxColumns ? Extent.X : Extent.GetMax();
+	const float ColumnWidth = Range / float(1 << Level);
+
+	FDecimationLevel NewLevel;
+	NewLevel.StripOffsets.SetNumUninitialized(DecimationStripOffsets.Num());
+	TArray<int32> StripIndices;
+	for (int32 Strip = 0; Strip < DecimationStripOffsets.Num(); Strip++)
+	{
+		const int32 Begin = DecimationStripOffsets[Strip];
+		const int32 End = Strip + 1 < DecimationStripOffsets.Num() ? DecimationStripOffsets[Strip + 1] : DecimationSource.Num();
+		const TArrayView<const FVector3f> StripPoints(DecimationSource.GetData() + Begin, End - Begin);
+
+		if (DecimationMode == EVisMeshPolylineDecimation::MinMaxColumns)
+		{
+			VisMeshDecimateMinMaxColumns(StripPoints, DecimationBounds.Min.X, ColumnWidth, StripIndices);
+		}
+		else
+		{
+			VisMeshDecimateDouglasPeucker(StripPoints, ColumnWidth, StripIndices);
+		}
+
+		// 2. 下标转换为源数据中的下标
+		NewLevel.StripOffsets[Strip] = NewLevel.Indices.Num();
+		for (int32 Index : StripIndices)
+		{
+			NewLevel.Indices.Add(Begin + Index);
+		}
+	}
+
+	return DecimationLevels.Add(Level, MoveTemp(NewLevel));
+}
+
+void UVisMeshPolylineComponent::UpdateDecimationView(float VisibleMinX, float VisibleMaxX, int32 PixelWidth)
+{
+	if (DecimationSource.Num() == 0 || VisibleMaxX <= VisibleMinX || PixelWidth <= 0)
+	{
+		return;
+	}
+
+	// 1. 选择级别：不需要抽稀时直接使用源数据
+	const int32 Level = GetDecimationLevel((VisibleMaxX - VisibleMinX) / PixelWidth);
+	const FDecimationLevel* LevelData = Level != INDEX_NONE ? &FindOrBuildDecimationLevel(Level) : nullptr;
+	const TArray<int32>& LevelStripOffsets = LevelData != nullptr ? LevelData->StripOffsets : DecimationStripOffsets;
+	const int32 LevelNum = LevelData != nullptr ? LevelData->Indices.Num() : DecimationSource.Num();
+	auto SourceIndex = [&](int32 K) { return LevelData != nullptr ? LevelData->Indices[K] : K; };
+
+	// 2. 时间序列只保留可见范围 (两侧各多保留一个点，使线段延伸到视口边缘)，任意折线保留全部
+	TArray<FIntPoint> Ranges;
+	Ranges.SetNumUninitialized(LevelStripOffsets.Num());
+	for (int32 Strip = 0; Strip < LevelStripOffsets.Num(); Strip++)
+	{
+		int32 Begin = LevelStripOffsets[Strip];
+		int32 End = Strip + 1 < LevelStripOffsets.Num() ? LevelStripOffsets[Strip + 1] : LevelNum;
+		if (DecimationMode == EVisMeshPolylineDecimation::MinMaxColumns)
+		{
+			auto LowerBoundX = [&](int32 First, int32 Last, float X)
+			{
+				while (First < Last)
+				{
+					const int32 Mid = (First + Last) / 2;
+					if (DecimationSource[SourceIndex(Mid)].X < X)
+					{
+						First = Mid + 1;
+					}
+					else
+					{
+						Last = Mid;
+					}
+				}
+				return First;
+			};
+			const int32 VisibleBegin = FMath::Max(LowerBoundX(Begin, End, VisibleMinX) - 1, Begin);
+			const int32 VisibleEnd = FMath::Min(LowerBoundX(Begin, End, VisibleMaxX) + 1, End);
+			Begin = VisibleBegin;
+			End = FMath::Max(VisibleEnd, VisibleBegin);
+		}
+		Ranges[Strip] = FIntPoint(Begin, End);
+	}
+
+	if (bDecimationSubmitted && Level == SubmittedDecimationLevel && Ranges == SubmittedDecimationRanges)
+	{
+		return;
+	}
+
+	// 3. 收集可见点并提交到绘制路径 (点数与像素宽度成正比)
+	TArray<FVector3f> Positions;
+	TArray<int32> NewStripOffsets;
+	TArray<FColor> NewColors;
+	for (int32 Strip = 0; Strip < Ranges.Num(); Strip++)
+	{
+		if (Ranges[Strip].Y - Ranges[Strip].X < 2)
+		{
+			continue;
+		}
+
+		NewStripOffsets.Add(Positions.Num());
+		for (int32 K = Ranges[Strip].X; K < Ranges[Strip].Y; K++)
+		{
+			Positions.Add(DecimationSource[SourceIndex(K)]);
+			if (DecimationStripColors.Num() != 0)
+			{
+				NewColors.Add(DecimationStripColors[Strip]);
+			}
+		}
+	}
+
+	SetPolylines(Positions, NewStripOffsets, TArrayView<const float>(), NewColors);
+
+	bDecimationSubmitted = true;
+	SubmittedDecimationLevel = Level;
+	SubmittedDecimationRanges = MoveTemp(Ranges);
+}
+
+void UVisMeshPolylineComponent::SetFaceCamera(bool bInFaceCamera)
+{
+	if (bFaceCamera != bInFaceCamera)
+	{
+		bFaceCamera = bInFaceCamera;
+		MarkRenderStateDirty();
+	}
+}
+
+void UVisMeshPolylineComponent::SendPoints(int32 FirstPoint, int32 Count, bool bTopologyChanged)
+{
+	// 1. 超出容量时重建 Proxy (容量按 2 的幂增长，逐条追加不会频繁重建)
+	if (Points.Num() > PointCapacity)
+	{
+		MarkRenderStateDirty();
+		return;
+	}
+
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	// 2. 只发送变化的一段；拓扑不变时不发送颜色与首尾标记
+	TArray<FVector4f> UploadPoints(Points.GetData() + FirstPoint, Count);
+	TArray<uint8> UploadFlags;
+	TArray<FColor> UploadColors;
+	if (bTopologyChanged)
+	{
+		UploadFlags = TArray<uint8>(StripFlags.GetData() + FirstPoint, Count);
+		UploadColors = TArray<FColor>(Colors.GetData() + FirstPoint, Count);
+	}
+
+	FVisMeshPolylineSceneProxy* PolylineSceneProxy = (FVisMeshPolylineSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshPolylinePointsUpdate)
+	([PolylineSceneProxy, FirstPoint, NewNumPoints = Points.Num(), UploadPoints = MoveTemp(UploadPoints), UploadFlags = MoveTemp(UploadFlags), UploadColors = MoveTemp(UploadColors)](FRHICommandListImmediate& RHICmdList)
+	{
+		PolylineSceneProxy->UpdatePoints_RenderThread(RHICmdList, FirstPoint, UploadPoints, UploadFlags, UploadColors, NewNumPoints);
+	});
+}
+
+void UVisMeshPolylineComponent::UpdatePolylineBounds(TArrayView<const FVector4f> InPoints, bool bExpandOnly)
+{
+	// 1. 分块并行求点位置的包围盒与最大宽度
+	constexpr int32 ChunkSize = 4096;
+	const int32 NumChunks = FMath::DivideAndRoundUp(InPoints.Num(), ChunkSize);
+	TArray<FBox3f> ChunkBounds;
+	TArray<float> ChunkMaxWidth;
+	ChunkBounds.SetNumUninitialized(NumChunks);
+	ChunkMaxWidth.SetNumUninitialized(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 Begin = ChunkIdx * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, InPoints.Num());
+		FBox3f LocalBox(ForceInit);
+		float LocalMaxWidth = 0.f;
+		for (int32 i = Begin; i < End; i++)
+		{
+			LocalBox += FVector3f(InPoints[i]);
+			LocalMaxWidth = FMath::Max(LocalMaxWidth, InPoints[i].W);
+		}
+		ChunkBounds[ChunkIdx] = LocalBox;
+		ChunkMaxWidth[ChunkIdx] = LocalMaxWidth;
+	});
+
+	FBox NewBounds = bExpandOnly ? PositionBounds : FBox(ForceInit);
+	float NewMaxWidth = bExpandOnly ? MaxWidth : 0.f;
+	for (int32 ChunkIdx = 0; ChunkIdx < NumChunks; ChunkIdx++)
+	{
+		NewBounds += FBox(ChunkBounds[ChunkIdx]);
+		NewMaxWidth = FMath::Max(NewMaxWidth, ChunkMaxWidth[ChunkIdx]);
+	}
+
+	// 2. 范围变化时才更新包围盒
+	if (NewBounds != PositionBounds || NewMaxWidth != MaxWidth)
+	{
+		PositionBounds = NewBounds;
+		MaxWidth = NewMaxWidth;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+}
+
+FPrimitiveSceneProxy* UVisMeshPolylineComponent::CreateSceneProxy()
+{
+	PointCapacity = Points.Num() > 0 ? (int32)FMath::RoundUpToPowerOfTwo(FMath::Max(Points.Num(), 64)) : 0;
+	return new FVisMeshPolylineSceneProxy(this);
+}
+
+int32 UVisMeshPolylineComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+FBoxSphereBounds UVisMeshPolylineComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// 斜接最长为 MITER_LIMIT (3) 倍的半宽
+	const FBox PointBox = PositionBounds.IsValid ? PositionBounds : FBox(FVector::ZeroVector, FVector::ZeroVector);
+	const FBox LocalBox = PointBox.ExpandBy(MaxWidth * 0.5f * 3.f);
+
+	FBoxSphereBounds Ret(FBoxSphereBounds(LocalBox).TransformBy(LocalToWorld));
+
+	Ret.BoxExtent *= BoundsScale;
+	Ret.SphereRadius *= BoundsScale;
+
+	return Ret;
+}
@@ -0,0 +1,275 @@
+#include "Components/VisMeshPolylineSceneProxy.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#include "Components/VisMeshPolylineComponent.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "Utils/VisMeshUtils.h"
+
+FVisMeshPolylineSceneProxy::FVisMeshPolylineSceneProxy(UVisMeshPolylineComponent* Component)
+	: FVisMeshSceneProxyBase(Component)
+	  , NumPoints(Component->GetNumPoints())
+	  , PointCapacity(Component->GetPointCapacity())
+	  , bFaceCamera(Component->bFaceCamera)
+	  , InitialPoints(Component->GetPoints())
+	  , InitialFlags(Component->GetStripFlags())
+	  , InitialColors(Component->GetColors())
+	  , Material(Component->GetMaterial(0))
+	  , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	bVFRequiresPrimitiveUniformBuffer = true;
+
+	if (Material == nullptr)
+	{
+		Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	}
+}
+
+SIZE_T FVisMeshPolylineSceneProxy::GetTypeHash() const
+{
+	static size_t UniquePointer;
+	return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+uint32 FVisMeshPolylineSceneProxy::GetMemoryFootprint() const
+{
+	return (sizeof(*this) + GetAllocatedSize());
+}
+
+FPrimitiveViewRelevance FVisMeshPolylineSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bShadowRelevance = IsShadowCast(View);
+	Result.bDynamicRelevance = true;
+	Result.bRenderInMainPass = ShouldRenderInMainPass();
+	Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+	Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+	return Result;
+}
+
+bool FVisMeshPolylineSceneProxy::CanBeOccluded() const
+{
+	return !MaterialRelevance.bDisableDepthTest;
+}
+
+void FVisMeshPolylineSceneProxy::CreateRenderThreadResources()
+{
+	check(VertexFactory == nullptr);
+
+	if (PointCapacity <= 0)
+	{
+		return;
+	}
+
+	FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+	const int32 NumVerts = PointCapacity * 2;
+
+	// 1. 点数据 (CPU 按段上传) 与顶点流 / 索引 (Compute 写入)，均按容量分配
+	PointBuffer = new FVisMeshTypedVertexBuffer(PointCapacity, PF_A32B32G32R32F, false);
+	FlagBuffer = new FVisMeshTypedVertexBuffer(PointCapacity, PF_R8_UINT, false);
+	PositionBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 3, PF_R32_FLOAT, true);
+	TangentBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 2, PF_R8G8B8A8_SNORM, true);
+	ColorBuffer = new FVisMeshTypedVertexBuffer(NumVerts, PF_R8G8B8A8, false);
+	IndexBuffer = new FVisMeshRWIndexBuffer(PointCapacity * 6);
+	PointBuffer->InitResource(RHICmdList);
+	FlagBuffer->InitResource(RHICmdList);
+	PositionBuffer->InitResource(RHICmdList);
+	TangentBuffer->InitResource(RHICmdList);
+	ColorBuffer->InitResource(RHICmdList);
+	IndexBuffer->InitResource(RHICmdList);
+
+	UpdatePoints_RenderThread(RHICmdList, 0, InitialPoints, InitialFlags, InitialColors, NumPoints);
+	InitialPoints.Empty();
+	InitialFlags.Empty();
+	InitialColors.Empty();
+
+	// 首帧展开全部顶点并写入索引
+	bExpandDirty = true;
+	bTopologyDirty = true;
+
+	// 2. 顶点工厂直接读取 Compute 写入的 Buffer
+	VertexFactory = new FLocalVertexFactory(GetScene().GetFeatureLevel(), "VisMeshPolylineVertexFactory");
+	FLocalVertexFactory::FDataType NewData;
+	NewData.PositionComponent = FVertexStreamComponent(PositionBuffer, 0, sizeof(FVector3f), VET_Float3);
+	NewData.TangentBasisComponents[0] = FVertexStreamComponent(TangentBuffer, 0, 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.TangentBasisComponents[1] = FVertexStreamComponent(TangentBuffer, sizeof(FPackedNormal), 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.ColorComponent = FVertexStreamComponent(ColorBuffer, 0, sizeof(FColor), VET_Color);
+
+	if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
+	{
+		NewData.PositionComponentSRV = PositionBuffer->GetSRV();
+		NewData.TangentsSRV = TangentBuffer->GetSRV();
+		NewData.ColorComponentsSRV = ColorBuffer->GetSRV();
+		NewData.TextureCoordinatesSRV = GNullColorVertexBuffer.VertexBufferSRV;
+	}
+
+	VertexFactory->SetData(NewData);
+	VertexFactory->InitResource(RHICmdList);
+}
+
+void FVisMeshPolylineSceneProxy::DestroyRenderThreadResources()
+{
+	if (VertexFactory != nullptr)
+	{
+		VertexFactory->ReleaseResource();
+		delete VertexFactory;
+		VertexFactory = nullptr;
+	}
+
+	FVisMeshTypedVertexBuffer** Buffers[] = { &PointBuffer, &FlagBuffer, &PositionBuffer, &TangentBuffer, &ColorBuffer };
+	for (FVisMeshTypedVertexBuffer** Buffer : Buffers)
+	{
+		if (*Buffer != nullptr)
+		{
+			(*Buffer)->ReleaseResource();
+			delete *Buffer;
+			*Buffer = nullptr;
+		}
+	}
+
+	if (IndexBuffer != nullptr)
+	{
+		IndexBuffer->ReleaseResource();
+		delete IndexBuffer;
+		IndexBuffer = nullptr;
+	}
+}
+
+void FVisMeshPolylineSceneProxy::UpdatePoints_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstPoint, const TArray<FVector4f>& InPoints,
+	const TArray<uint8>& InFlags, const TArray<FColor>& InColors, int32 NewNumPoints)
+{
+	check(IsInRenderingThread());
+
+	if (PointBuffer == nullptr)
+	{
+		return;
+	}
+
+	check(NewNumPoints <= PointCapacity && FirstPoint >= 0 && FirstPoint + InPoints.Num() <= NewNumPoints);
+	PointBuffer->Update(RHICmdList, FirstPoint, InPoints.GetData(), InPoints.Num());
+
+	// 1. 首尾标记变化后需要重写索引
+	if (InFlags.Num() == InPoints.Num() && InFlags.Num() > 0)
+	{
+		FlagBuffer->Update(RHICmdList, FirstPoint, InFlags.GetData(), InFlags.Num());
+		bTopologyDirty = true;
+	}
+
+	// 2. 每个点的两个顶点颜色相同
+	if (InColors.Num() == InPoints.Num() && InColors.Num() > 0)
+	{
+		TArray<FColor> VertexColors;
+		VertexColors.SetNumUninitialized(InColors.Num() * 2);
+		for (int32 i = 0; i < InColors.Num(); i++)
+		{
+			VertexColors[i * 2 + 0] = InColors[i];
+			VertexColors[i * 2 + 1] = InColors[i];
+		}
+		ColorBuffer->Update(RHICmdList, FirstPoint * 2, VertexColors.GetData(), VertexColors.Num());
+	}
+
+	NumPoints = NewNumPoints;
+	bExpandDirty = true;
+}
+
+void FVisMeshPolylineSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily)
+{
+	if (VertexFactory == nullptr || NumPoints <= 0 || ViewFamily.Views.Num() == 0)
+	{
+		return;
+	}
+
+	// 隐藏时不展开；脏标记保留，显示后的第一帧再展开
+	if (!IsShown(ViewFamily.Views[0]))
+	{
+		return;
+	}
+
+	// 朝向相机时每帧都要重新展开，否则只在点变化后展开
+	if (!bFaceCamera && !bExpandDirty && !bTopologyDirty)
+	{
+		return;
+	}
+
+	const FSceneView* MainView = ViewFamily.Views[0];
+	const FVector3f LocalCameraPosition = FVector3f(GetLocalToWorld().InverseTransformPosition(MainView->ViewMatrices.GetViewOrigin()));
+
+	AddPolylineExpandPass(GraphBuilder, PointBuffer->GetSRV(), FlagBuffer->GetSRV(), PositionBuffer->GetUAV(), TangentBuffer->GetUAV(),
+		IndexBuffer->GetUAV(), NumPoints, bFaceCamera, LocalCameraPosition, bTopologyDirty);
+
+	bExpandDirty = false;
+	bTopologyDirty = false;
+}
+
+void FVisMeshPolylineSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
+{
+	if (VertexFactory == nullptr || IndexBuffer == nullptr || NumPoints <= 0)
+	{
+		return;
+	}
+
+	// Set up wireframe material (if needed)
+	const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+	FColoredMaterialRenderProxy* WireframeMaterialInstance = nullptr;
+	if (bWireframe)
+	{
+		WireframeMaterialInstance = new FColoredMaterialRenderProxy(GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : NULL, FLinearColor(0, 0.5f, 1.f));
+		Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+	}
+
+	FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Material->GetRenderProxy();
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = IndexBuffer;
+			Mesh.bWireframe = bWireframe;
+			Mesh.VertexFactory = VertexFactory;
+			Mesh.MaterialRenderProxy = MaterialProxy;
+
+			bool bHasPrecomputedVolumetricLightmap;
+			FMatrix PreviousLocalToWorld;
+			int32 SingleCaptureIndex;
+			bool bOutputVelocity;
+			GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
+			bOutputVelocity |= AlwaysHasVelocity();
+
+			FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+			DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(),
+			                                  GetLocalBounds(), GetLocalBounds(), ReceivesDecals(),
+			                                  bHasPrecomputedVolumetricLightmap, bOutputVelocity,
+			                                  GetCustomPrimitiveData());
+			BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+
+			// 每个点一个四边形 (每条线的尾点为退化四边形)
+			BatchElement.FirstIndex = 0;
+			BatchElement.NumPrimitives = NumPoints * 2;
+			BatchElement.MinVertexIndex = 0;
+			BatchElement.MaxVertexIndex = NumPoints * 2 - 1;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = false;
+			Collector.AddMesh(ViewIndex, Mesh);
+		}
+	}
+
+	// Draw bounds
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			RenderBounds(Collector.GetPDI(ViewIndex), ViewFamily.EngineShowFlags, GetBounds(), IsSelected());
+		}
+	}
+#endif
+}
@@ -5,8 +5,11 @@
 #include "Components/VisMeshProceduralSceneProxy.h"
 #include "RenderBase/VisMeshRenderResources.h"
 #include "RenderBase/VisMeshSceneProxyBase.h"
+#include "Utils/VisMeshUtils.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Materials/MaterialInstanceDynamic.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshProceduralComponent)
 
@@ -89,19 +92,10 @@ void UVisMeshProceduralComponent::CreateMeshSection(int32 SectionIndex, FVisMesh
 	NewSection.Data = MoveTemp(MeshData);
 
 	// 2. 数据补齐 (保持 SOA 长度一致)
-	const int32 NumVerts = NewSection.Data.NumVertices();
-	auto& D = NewSection.Data; // 简写
-
-	if (D.Normals.Num() != NumVerts) D.Normals.Init(FVector(0, 0, 1), NumVerts);
-	if (D.Colors.Num() != NumVerts) D.Colors.Init(FColor::White, NumVerts);
-	if (D.Tangents.Num() != NumVerts) D.Tangents.Init(FVisMeshTangent(), NumVerts);
-	if (D.UV0.Num() != NumVerts) D.UV0.Init(FVector2D::ZeroVector, NumVerts);
-	if (D.UV1.Num() != NumVerts) D.UV1.Init(FVector2D::ZeroVector, NumVerts);
-	if (D.UV2.Num() != NumVerts) D.UV2.Init(FVector2D::ZeroVector, NumVerts);
-	if (D.UV3.Num() != NumVerts) D.UV3.Init(FVector2D::ZeroVector, NumVerts);
+	VisMeshPadAttributes(NewSection.Data);
 
 	// 3. 计算 Bounds (直接读 Data.Positions)
-	NewSection.SectionLocalBox = FBox(D.Positions);
+	NewSection.SectionLocalBox = VisMeshComputeBounds(NewSection.Data.Positions);
 	NewSection.bEnableCollision = bCreateCollision;
 
 	// 4. 触发后续更新
@@ -146,18 +140,31 @@ void UVisMeshProceduralComponent::UpdateMeshSection(int32 SectionIndex, FVisMesh
 	if (MeshData.UV2.Num() == NumVerts)       Section.Data.UV2       = MoveTemp(MeshData.UV2);
 	if (MeshData.UV3.Num() == NumVerts)       Section.Data.UV3       = MoveTemp(MeshData.UV3);
 
+	// 标量通道按下标替换
+	for (int32 ChannelIdx = 0; ChannelIdx < MeshData.Scalars.Num(); ++ChannelIdx)
+	{
+		if (MeshData.Scalars[ChannelIdx].Values.Num() != NumVerts) continue;
+		if (!Section.Data.Scalars.IsValidIndex(ChannelIdx)) Section.Data.Scalars.SetNum(ChannelIdx + 1);
+		Section.Data.Scalars[ChannelIdx] = MoveTemp(MeshData.Scalars[ChannelIdx]);
+	}
+
 	if (bPositionsChanged)
 	{
-		Section.SectionLocalBox = FBox(Section.Data.Positions);
+		Section.SectionLocalBox = VisMeshComputeBounds(Section.Data.Positions);
 		UpdateLocalBounds();
-		if (Section.bEnableCollision)
+		if (Section.bEnableCollision && bDeferCollisionUpdates)
+		{
+			// 碰撞推迟时只记录，结束时整体重新烹饪
+			UpdateCollision();
+		}
+		else if (Section.bEnableCollision)
 		{
 			BodyInstance.UpdateTriMeshVertices(Section.Data.Positions);
 		}
 	}
 
 	// --- 2. 物理更新 (直接引用) ---
-	if (Section.bEnableCollision)
+	if (Section.bEnableCollision && !bDeferCollisionUpdates)
 	{
 		// 直接传递 Section.Data.Positions
 		if (VisMeshSections.Num() == 1)
@@ -174,20 +181,152 @@ void UVisMeshProceduralComponent::UpdateMeshSection(int32 SectionIndex, FVisMesh
 	}
 
 	// --- 3. 生成 RenderData (ParallelFor) ---
+	SendSectionUpdate(SectionIndex);
+	MarkRenderTransformDirty();
+}
+
+void UVisMeshProceduralComponent::SendSectionUpdate(int32 SectionIndex)
+{
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	const FVisMeshSection& Section = VisMeshSections[SectionIndex];
+	FVisMeshSectionUpdateData* SectionData = new FVisMeshSectionUpdateData;
+	SectionData->TargetSection = SectionIndex;
+	// 渲染线程只使用顶点属性：不拷贝索引与全部标量通道，只拷贝激活的通道
+	const FVisMeshData& Src = Section.Data;
+	FVisMeshData& Dst = SectionData->Data;
+	Dst.Positions = Src.Positions;
+	Dst.Normals = Src.Normals;
+	Dst.Tangents = Src.Tangents;
+	Dst.Colors = Src.Colors;
+	Dst.UV0 = Src.UV0;
+	Dst.UV1 = Src.UV1;
+	Dst.UV2 = Src.UV2;
+	Dst.UV3 = Src.UV3;
+	if (const TArray<float>* ScalarValues = Section.GetActiveScalarValues())
+	{
+		SectionData->ScalarValues = *ScalarValues;
+	}
+
+	FVisMeshProceduralSceneProxy* ProcMeshSceneProxy = (FVisMeshProceduralSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshSectionUpdate)
+	([ProcMeshSceneProxy, SectionData](FRHICommandListImmediate& RHICmdList)
+	{
+		ProcMeshSceneProxy->UpdateSection_RenderThread(RHICmdList, SectionData);
+	});
+}
+
+void UVisMeshProceduralComponent::UpdateMeshSectionRanges(int32 SectionIndex, const TArray<FIntPoint>& Ranges, const FVisMeshData& RangeData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VisMesh_UpdateSectionGT);
+
+	if (!VisMeshSections.IsValidIndex(SectionIndex) || Ranges.Num() == 0) return;
+
+	FVisMeshSection& Section = VisMeshSections[SectionIndex];
+	const int32 NumVerts = Section.Data.NumVertices();
+
+	// --- 1. 校验区间：升序、互不重叠、不越界，并计算每个区间在 RangeData 中的偏移 ---
+	TArray<int32> RangeOffsets;
+	RangeOffsets.SetNumUninitialized(Ranges.Num());
+	int32 TotalVerts = 0;
+	int32 PrevEnd = 0;
+	for (int32 RangeIdx = 0; RangeIdx < Ranges.Num(); RangeIdx++)
+	{
+		const FIntPoint& Range = Ranges[RangeIdx];
+		if (Range.X < PrevEnd || Range.Y <= 0 || Range.X + Range.Y > NumVerts)
+		{
+			UE_LOG(LogVisComponent, Error, TEXT("UpdateMeshSectionRanges: invalid vertex range (%d, %d)."), Range.X, Range.Y);
+			return;
+		}
+		RangeOffsets[RangeIdx] = TotalVerts;
+		TotalVerts += Range.Y;
+		PrevEnd = Range.X + Range.Y;
+	}
+
+	// 拼接数据 <-> Section 数据，按区间并行拷贝
+	auto ScatterRanges = [&](auto& Dest, const auto& Src) -> bool
+	{
+		if (Src.Num() != TotalVerts || Dest.Num() != NumVerts) return false;
+		ParallelFor(Ranges.Num(), [&](int32 RangeIdx)
+		{
+			FMemory::Memcpy(Dest.GetData() + Ranges[RangeIdx].X, Src.GetData() + RangeOffsets[RangeIdx], Ranges[RangeIdx].Y * sizeof(*Src.GetData()));
+		});
+		return true;
+	};
+	auto GatherRanges = [&](auto& Dest, const auto& Src)
+	{
+		if (Src.Num() != NumVerts) return;
+		Dest.SetNumUninitialized(TotalVerts);
+		ParallelFor(Ranges.Num(), [&](int32 RangeIdx)
+		{
+			FMemory::Memcpy(Dest.GetData() + RangeOffsets[RangeIdx], Src.GetData() + Ranges[RangeIdx].X, Ranges[RangeIdx].Y * sizeof(*Src.GetData()));
+		});
+	};
+
+	// --- 2. 更新内部数据 (只覆盖提供的属性) ---
+	const bool bPositionsChanged = ScatterRanges(Section.Data.Positions, RangeData.Positions);
+	const bool bNormalsChanged = ScatterRanges(Section.Data.Normals, RangeData.Normals);
+	const bool bTangentsChanged = ScatterRanges(Section.Data.Tangents, RangeData.Tangents);
+	const bool bColorsChanged = ScatterRanges(Section.Data.Colors, RangeData.Colors);
+	bool bUVsChanged = ScatterRanges(Section.Data.UV0, RangeData.UV0);
+	bUVsChanged |= ScatterRanges(Section.Data.UV1, RangeData.UV1);
+	bUVsChanged |= ScatterRanges(Section.Data.UV2, RangeData.UV2);
+	bUVsChanged |= ScatterRanges(Section.Data.UV3, RangeData.UV3);
+
+	if (bPositionsChanged)
+	{
+		// 包围盒只扩大不收缩，避免每次扫描整个 Section
+		Section.SectionLocalBox += VisMeshComputeBounds(RangeData.Positions);
+		if (Section.bEnableCollision && bDeferCollisionUpdates)
+		{
+			UpdateCollision();
+		}
+		else if (Section.bEnableCollision)
+		{
+			TArray<FVector> AllPos;
+			for (const FVisMeshSection& S : VisMeshSections) if (S.bEnableCollision) AllPos.Append(S.Data.Positions);
+			BodyInstance.UpdateTriMeshVertices(AllPos);
+		}
+	}
+
+	// --- 3. 只把这些区间发送到渲染线程 ---
 	if (SceneProxy && !IsRenderStateDirty())
 	{
-		FVisMeshSectionUpdateData* SectionData = new FVisMeshSectionUpdateData;
-		SectionData->TargetSection = SectionIndex;
-		SectionData->Data = Section.Data; // Copy
+		FVisMeshSectionRangeUpdateData* UpdateData = new FVisMeshSectionRangeUpdateData;
+		UpdateData->TargetSection = SectionIndex;
+		UpdateData->Ranges = Ranges;
+		if (bPositionsChanged) UpdateData->Data.Positions = RangeData.Positions;
+		if (bColorsChanged) UpdateData->Data.Colors = RangeData.Colors;
+		if (bNormalsChanged || bTangentsChanged)
+		{
+			// 切线基由法线与切线共同决定，两者都从 Section 中取
+			GatherRanges(UpdateData->Data.Normals, Section.Data.Normals);
+			GatherRanges(UpdateData->Data.Tangents, Section.Data.Tangents);
+		}
+		if (bUVsChanged)
+		{
+			// UV 在 TexCoord Buffer 中交错存储，所有槽位一起上传
+			GatherRanges(UpdateData->Data.UV0, Section.Data.UV0);
+			GatherRanges(UpdateData->Data.UV1, Section.Data.UV1);
+			GatherRanges(UpdateData->Data.UV2, Section.Data.UV2);
+			GatherRanges(UpdateData->Data.UV3, Section.Data.UV3);
+		}
 
 		FVisMeshProceduralSceneProxy* ProcMeshSceneProxy = (FVisMeshProceduralSceneProxy*)SceneProxy;
-		ENQUEUE_RENDER_COMMAND(FVisMeshSectionUpdate)
-		([ProcMeshSceneProxy, SectionData](FRHICommandListImmediate& RHICmdList)
+		ENQUEUE_RENDER_COMMAND(FVisMeshSectionRangeUpdate)
+		([ProcMeshSceneProxy, UpdateData](FRHICommandListImmediate& RHICmdList)
 		{
-			ProcMeshSceneProxy->UpdateSection_RenderThread(RHICmdList, SectionData);
+			ProcMeshSceneProxy->UpdateSectionRanges_RenderThread(RHICmdList, UpdateData);
 		});
 	}
-	MarkRenderTransformDirty();
+
+	if (bPositionsChanged)
+	{
+		UpdateLocalBounds();
+	}
 }
 
 void UVisMeshProceduralComponent::CreateMeshSection_LinearColor(int32 SectionIndex, const TArray<FVector>& Vertices,const TArray<int32>& Triangles, const TArray<FVector>& Normals,const TArray<FVector2D>& UV0,const TArray<FVector2D>& UV1, const TArray<FVector2D>& UV2,const TArray<FVector2D>& UV3,const TArray<FLinearColor>& VertexColors,const TArray<FVisMeshTangent>& Tangents, bool bCreateCollision,bool bSRGBConversion)
@@ -197,11 +336,8 @@ void UVisMeshProceduralComponent::CreateMeshSection_LinearColor(int32 SectionInd
 	if (VertexColors.Num() > 0)
 	{
 		Colors.SetNumUninitialized(VertexColors.Num());
-		// ParallelFor 加速颜色转换
-		ParallelFor(VertexColors.Num(), [&](int32 i)
-		{
-			Colors[i] = VertexColors[i].ToFColor(bSRGBConversion);
-		});
+		// 批量 SIMD + 查找表转换，按块并行
+		VisMeshConvertLinearColors(VertexColors, Colors, bSRGBConversion);
 	}
 
 	CreateMeshSection(SectionIndex, Vertices, Triangles, Normals, UV0, UV1, UV2, UV3, Colors, Tangents, bCreateCollision);
@@ -242,10 +378,14 @@ void UVisMeshProceduralComponent::UpdateMeshSection(int32 SectionIndex, const TA
 	// 如果位置改变，需要更新 Bounds 和 Physics
 	if (bPositionsChanged)
 	{
-		Section.SectionLocalBox = FBox(Section.Data.Positions);
+		Section.SectionLocalBox = VisMeshComputeBounds(Section.Data.Positions);
 		UpdateLocalBounds();
 
-		if (Section.bEnableCollision)
+		if (Section.bEnableCollision && bDeferCollisionUpdates)
+		{
+			UpdateCollision();
+		}
+		else if (Section.bEnableCollision)
 		{
 			// 直接传递 Positions 数组，无需像 AOS 那样提取
 			if (VisMeshSections.Num() == 1)
@@ -265,24 +405,8 @@ void UVisMeshProceduralComponent::UpdateMeshSection(int32 SectionIndex, const TA
 		}
 	}
 
-	if (SceneProxy && !IsRenderStateDirty())
-	{
-		// 构造 SOA 更新包
-		FVisMeshSectionUpdateData* SectionData = new FVisMeshSectionUpdateData;
-		SectionData->TargetSection = SectionIndex;
-		
-		// 深拷贝需要更新的数据到 RenderPayload
-		// 这里为了简化逻辑，拷贝整个 SOA 结构 (实际 TArray Copy-on-write 机制在跨线程时会发生深拷贝)
-		// 优化点：可以只拷贝修改过的数组，但在 RenderThread 处理会变复杂
-		SectionData->Data = Section.Data; 
-
-		FVisMeshProceduralSceneProxy* ProcMeshSceneProxy = (FVisMeshProceduralSceneProxy*)SceneProxy;
-		ENQUEUE_RENDER_COMMAND(FVisMeshSectionUpdate)
-		([ProcMeshSceneProxy, SectionData](FRHICommandListImmediate& RHICmdList)
-		{
-			ProcMeshSceneProxy->UpdateSection_RenderThread(RHICmdList, SectionData);
-		});
-	}
+	// 与 FVisMeshData 版本相同，只发送顶点属性与激活的标量通道
+	SendSectionUpdate(SectionIndex);
 
 	MarkRenderTransformDirty();
 }
@@ -294,11 +418,8 @@ void UVisMeshProceduralComponent::UpdateMeshSection_LinearColor(int32 SectionInd
 	if (VertexColors.Num() > 0)
 	{
 		Colors.SetNumUninitialized(VertexColors.Num());
-		// ParallelFor 优化颜色转换
-		ParallelFor(VertexColors.Num(), [&](int32 i)
-		{
-			Colors[i] = VertexColors[i].ToFColor(bSRGBConversion);
-		});
+		// 批量 SIMD + 查找表转换，按块并行
+		VisMeshConvertLinearColors(VertexColors, Colors, bSRGBConversion);
 	}
 
 	UpdateMeshSection(SectionIndex, Vertices, Normals, UV0, UV1, UV2, UV3, Colors, Tangents);
@@ -360,6 +481,114 @@ void UVisMeshProceduralComponent::SetMeshSectionVisible(int32 SectionIndex, bool
 	}
 }
 
+void UVisMeshProceduralComponent::SetMeshSectionDrawRange(int32 SectionIndex, int32 FirstIndex, int32 NumIndices)
+{
+	if (SectionIndex < VisMeshSections.Num())
+	{
+		// Set game thread state
+		FVisMeshSection& Section = VisMeshSections[SectionIndex];
+		if (Section.DrawFirstIndex == FirstIndex && Section.DrawNumIndices == NumIndices)
+		{
+			return;
+		}
+		Section.DrawFirstIndex = FirstIndex;
+		Section.DrawNumIndices = NumIndices;
+
+		// 碰撞只包含绘制范围内的三角形
+		UpdateCollision();
+
+		if (SceneProxy)
+		{
+			// Enqueue command to modify render thread info
+			FVisMeshProceduralSceneProxy* ProcMeshSceneProxy = (FVisMeshProceduralSceneProxy*)SceneProxy;
+			ENQUEUE_RENDER_COMMAND(FProcMeshSectionDrawRangeUpdate)(
+				[ProcMeshSceneProxy, SectionIndex, FirstIndex, NumIndices](FRHICommandListImmediate& RHICmdList)
+				{
+					ProcMeshSceneProxy->SetSectionDrawRange_RenderThread(SectionIndex, FirstIndex, NumIndices);
+				});
+		}
+	}
+}
+
+void UVisMeshProceduralComponent::SetScalarChannel(int32 SectionIndex, int32 ChannelIndex, const TArray<float>& Values, FName ChannelName)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VisMesh_UpdateSectionGT);
+
+	if (!VisMeshSections.IsValidIndex(SectionIndex) || ChannelIndex < 0) return;
+
+	FVisMeshSection& Section = VisMeshSections[SectionIndex];
+	if (Values.Num() != Section.Data.NumVertices())
+	{
+		UE_LOG(LogVisComponent, Error, TEXT("SetScalarChannel vertex count mismatch."));
+		return;
+	}
+
+	if (!Section.Data.Scalars.IsValidIndex(ChannelIndex)) Section.Data.Scalars.SetNum(ChannelIndex + 1);
+	FVisMeshScalarChannel& Channel = Section.Data.Scalars[ChannelIndex];
+	Channel.Name = ChannelName;
+	Channel.Values = Values;
+
+	// 非激活通道只保存数据，激活后才上传
+	if (Section.ActiveScalarChannel == ChannelIndex && SceneProxy && !IsRenderStateDirty())
+	{
+		FVisMeshProceduralSceneProxy* ProcMeshSceneProxy = (FVisMeshProceduralSceneProxy*)SceneProxy;
+		ENQUEUE_RENDER_COMMAND(FVisMeshSectionScalarUpdate)
+		([ProcMeshSceneProxy, SectionIndex, ScalarValues = Channel.Values](FRHICommandListImmediate& RHICmdList)
+		{
+			ProcMeshSceneProxy->UpdateSectionScalars_RenderThread(RHICmdList, SectionIndex, ScalarValues);
+		});
+	}
+}
+
+void UVisMeshProceduralComponent::SetActiveScalarChannel(int32 SectionIndex, int32 ChannelIndex)
+{
+	if (!VisMeshSections.IsValidIndex(SectionIndex)) return;
+
+	FVisMeshSection& Section = VisMeshSections[SectionIndex];
+	if (Section.ActiveScalarChannel == ChannelIndex) return;
+
+	// 切换通道会改变 UV 布局，需要重建 Proxy
+	Section.ActiveScalarChannel = Section.Data.Scalars.IsValidIndex(ChannelIndex) ? ChannelIndex : INDEX_NONE;
+	ApplyColorMapParameters();
+	MarkRenderStateDirty();
+}
+
+void UVisMeshProceduralComponent::SetColorMap(UTexture* InColorMap)
+{
+	ColorMapTexture = InColorMap;
+	ApplyColorMapParameters();
+}
+
+void UVisMeshProceduralComponent::SetScalarRange(float InMin, float InMax)
+{
+	ScalarRangeMin = InMin;
+	ScalarRangeMax = InMax;
+	ApplyColorMapParameters();
+}
+
+void UVisMeshProceduralComponent::ApplyColorMapParameters()
+{
+	static const FName ColorMapParamName(TEXT("VisMeshColorMap"));
+	static const FName ScalarMinParamName(TEXT("VisMeshScalarMin"));
+	static const FName ScalarMaxParamName(TEXT("VisMeshScalarMax"));
+
+	for (int32 SectionIdx = 0; SectionIdx < VisMeshSections.Num(); SectionIdx++)
+	{
+		if (VisMeshSections[SectionIdx].ActiveScalarChannel == INDEX_NONE) continue;
+
+		// 首次调用时把 Section 材质替换为 MID，之后只更新参数，不触碰顶点数据
+		if (UMaterialInstanceDynamic* MID = CreateDynamicMaterialInstance(SectionIdx))
+		{
+			if (ColorMapTexture)
+			{
+				MID->SetTextureParameterValue(ColorMapParamName, ColorMapTexture);
+			}
+			MID->SetScalarParameterValue(ScalarMinParamName, ScalarRangeMin);
+			MID->SetScalarParameterValue(ScalarMaxParamName, ScalarRangeMax);
+		}
+	}
+}
+
 bool UVisMeshProceduralComponent::IsMeshSectionVisible(int32 SectionIndex) const
 {
 	return (SectionIndex < VisMeshSections.Num()) ? VisMeshSections[SectionIndex].bSectionVisible : false;
@@ -396,6 +625,12 @@ void UVisMeshProceduralComponent::ClearCollisionConvexMeshes()
 }
 
 void UVisMeshProceduralComponent::SetCollisionConvexMeshes(const TArray<TArray<FVector>>& ConvexMeshes)
+{
+	ReplaceCollisionConvexElems(ConvexMeshes);
+	UpdateCollision();
+}
+
+void UVisMeshProceduralComponent::ReplaceCollisionConvexElems(const TArray<TArray<FVector>>& ConvexMeshes)
 {
 	CollisionConvexElems.Reset();
 
@@ -408,50 +643,89 @@ void UVisMeshProceduralComponent::SetCollisionConvexMeshes(const TArray<TArray<F
 
 		CollisionConvexElems.Add(NewConvexElem);
 	}
+}
 
-	UpdateCollision();
+/** Section 是否参与复杂碰撞 (Trimesh)，只计绘制范围内的三角形 */
+static bool IsCollisionSection(const FVisMeshSection& Section, bool bUseAllTriData)
+{
+	return Section.GetDrawNumIndices() >= 3 && (bUseAllTriData || Section.bEnableCollision);
 }
 
 bool UVisMeshProceduralComponent::GetTriMeshSizeEstimates(struct FTriMeshCollisionDataEstimates& OutTriMeshEstimates,bool bInUseAllTriData) const
 {
-	return IInterface_CollisionDataProvider::GetTriMeshSizeEstimates(OutTriMeshEstimates, bInUseAllTriData);
+	// 精确统计：与 GetPhysicsTriMeshData 输出的顶点数完全一致
+	int64 NumVerts = 0;
+	for (const FVisMeshSection& Section : VisMeshSections)
+	{
+		if (IsCollisionSection(Section, bInUseAllTriData))
+		{
+			NumVerts += Section.Data.Positions.Num();
+		}
+	}
+	OutTriMeshEstimates.VerticeCount = NumVerts;
+	return true;
 }
 
 bool UVisMeshProceduralComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
 {
-	int32 VertexBase = 0; // 用于记录顶点偏移量
+	// 1. 先统计每个 Section 的顶点/三角形偏移，同时重建 Face -> Section 前缀和表
+	struct FSectionRange
+	{
+		int32 SectionIdx;
+		int32 VertexStart;
+		int32 FaceStart;
+	};
+	TArray<FSectionRange, TInlineAllocator<8>> Ranges;
+
+	int32 NumVerts = CollisionData->Vertices.Num();
+	int32 NumFaces = CollisionData->Indices.Num();
 
-	// 1. 遍历所有 Section
 	for (int32 SectionIdx = 0; SectionIdx < VisMeshSections.Num(); SectionIdx++)
 	{
 		const FVisMeshSection& Section = VisMeshSections[SectionIdx];
-		// 检查是否有数据 且 (强制全部使用 OR 开启了碰撞)
-		if (Section.Data.Triangles.Num() >= 3 && (InUseAllTriData || Section.bEnableCollision))
-		{
-			// 2. 拷贝顶点数据
-			// Append 将新顶点添加到物理网格的顶点数组末尾
-			CollisionData->Vertices.Append(Section.Data.Positions);
-
-			// 3. 拷贝三角形索引
-			// 注意：FVisMeshData 使用 TArray<int32>，物理数据使用 FTriIndices (struct {v0,v1,v2})
-			// 并且索引需要加上当前的 VertexBase 偏移量
-			const int32 NumTriangles = Section.Data.Triangles.Num() / 3;
-			for (int32 i = 0; i < NumTriangles; i++)
-			{
-				FTriIndices Triangle;
-				Triangle.v0 = Section.Data.Triangles[i * 3 + 0] + VertexBase;
-				Triangle.v1 = Section.Data.Triangles[i * 3 + 1] + VertexBase;
-				Triangle.v2 = Section.Data.Triangles[i * 3 + 2] + VertexBase;
+		if (!IsCollisionSection(Section, InUseAllTriData)) continue;
 
-				CollisionData->Indices.Add(Triangle);
+		Ranges.Add({ SectionIdx, NumVerts, NumFaces });
+		NumVerts += Section.Data.Positions.Num();
+		NumFaces += Section.GetDrawNumIndices() / 3;
+	}
+	BuildCollisionFaceTable(InUseAllTriData);
 
-				// 设置材质索引 (用于物理材质区分)
-				CollisionData->MaterialIndices.Add(SectionIdx);
-			}
+	// 2. 一次性分配，避免逐个 Add 的反复扩容
+	CollisionData->Vertices.SetNumUninitialized(NumVerts);
+	CollisionData->Indices.SetNumUninitialized(NumFaces);
+	CollisionData->MaterialIndices.SetNumUninitialized(NumFaces);
 
-			// 更新顶点偏移量，供下一个 Section 使用
-			VertexBase = CollisionData->Vertices.Num();
-		}
+	// 3. 并行填充 (各 Section 写入互不重叠的区间)
+	for (const FSectionRange& Range : Ranges)
+	{
+		const FVisMeshSection& Section = VisMeshSections[Range.SectionIdx];
+		const FVisMeshData& Data = Section.Data;
+
+		// 顶点：物理数据使用 FVector3f
+		FVector3f* DstVerts = CollisionData->Vertices.GetData() + Range.VertexStart;
+		ParallelFor(Data.Positions.Num(), [&](int32 i)
+		{
+			DstVerts[i] = FVector3f(Data.Positions[i]);
+		});
+
+		// 三角形：FVisMeshData 使用 TArray<int32>，物理数据使用 FTriIndices，并加上 VertexBase 偏移
+		const int32* Triangles = Data.GetTriangles().GetData() + Section.GetDrawFirstIndex();
+		const int32 NumTriangles = Section.GetDrawNumIndices() / 3;
+		const int32 VertexBase = Range.VertexStart;
+		const uint16 MaterialIndex = (uint16)Range.SectionIdx;
+		FTriIndices* DstTris = CollisionData->Indices.GetData() + Range.FaceStart;
+		uint16* DstMats = CollisionData->MaterialIndices.GetData() + Range.FaceStart;
+		ParallelFor(NumTriangles, [&](int32 i)
+		{
+			FTriIndices& Triangle = DstTris[i];
+			Triangle.v0 = Triangles[i * 3 + 0] + VertexBase;
+			Triangle.v1 = Triangles[i * 3 + 1] + VertexBase;
+			Triangle.v2 = Triangles[i * 3 + 2] + VertexBase;
+
+			// 设置材质索引 (用于物理材质区分)
+			DstMats[i] = MaterialIndex;
+		});
 	}
 
 	bool bResult = (CollisionData->Vertices.Num() > 0 && CollisionData->Indices.Num() > 0);
@@ -462,7 +736,7 @@ bool UVisMeshProceduralComponent::ContainsPhysicsTriMeshData(bool InUseAllTriDat
 {
 	for (const FVisMeshSection& Section : VisMeshSections)
 	{
-		if (Section.Data.Triangles.Num() >= 3 && (InUseAllTriData || Section.bEnableCollision))
+		if (IsCollisionSection(Section, InUseAllTriData))
 		{
 			return true;
 		}
@@ -497,6 +771,34 @@ void UVisMeshProceduralComponent::SetVisMeshSection(int32 SectionIndex, const FV
 	MarkRenderStateDirty(); // New section requires recreating scene proxy
 }
 
+void UVisMeshProceduralComponent::SetVisMeshSections(const TArray<int32>& SectionIndices, TArray<FVisMeshSection>&& Sections, const TArray<TArray<FVector>>* ConvexMeshes)
+{
+	check(SectionIndices.Num() == Sections.Num());
+
+	for (int32 i = 0; i < SectionIndices.Num(); i++)
+	{
+		const int32 SectionIndex = SectionIndices[i];
+		if (SectionIndex < 0) continue;
+
+		// Ensure sections array is long enough
+		if (SectionIndex >= VisMeshSections.Num())
+		{
+			VisMeshSections.SetNum(SectionIndex + 1, false);
+		}
+		VisMeshSections[SectionIndex] = MoveTemp(Sections[i]);
+	}
+
+	if (ConvexMeshes)
+	{
+		ReplaceCollisionConvexElems(*ConvexMeshes);
+	}
+
+	// 整批只更新一次
+	UpdateLocalBounds();
+	UpdateCollision();
+	MarkRenderStateDirty();
+}
+
 FPrimitiveSceneProxy* UVisMeshProceduralComponent::CreateSceneProxy()
 {
 	SCOPE_CYCLE_COUNTER(STAT_VisMesh_CreateSceneProxy);
@@ -510,6 +812,24 @@ class UBodySetup* UVisMeshProceduralComponent::GetBodySetup()
 	return VisMeshBodySetup;
 }
 
+void UVisMeshProceduralComponent::BuildCollisionFaceTable(bool bUseAllTriData) const
+{
+	CollisionFaceEnds.Reset();
+	CollisionFaceSections.Reset();
+	int32 TotalFaceCount = 0;
+	for (int32 SectionIdx = 0; SectionIdx < VisMeshSections.Num(); SectionIdx++)
+	{
+		const FVisMeshSection& Section = VisMeshSections[SectionIdx];
+		if (!IsCollisionSection(Section, bUseAllTriData)) continue;
+
+		TotalFaceCount += Section.GetDrawNumIndices() / 3;
+		CollisionFaceEnds.Add(TotalFaceCount);
+		CollisionFaceSections.Add(SectionIdx);
+	}
+	bCollisionFaceTableValid = true;
+	bCollisionFaceTableAllTriData = bUseAllTriData;
+}
+
 UMaterialInterface* UVisMeshProceduralComponent::GetMaterialFromCollisionFaceIndex(int32 FaceIndex, int32& SectionIndex) const
 {
 	UMaterialInterface* Result = nullptr;
@@ -517,19 +837,19 @@ UMaterialInterface* UVisMeshProceduralComponent::GetMaterialFromCollisionFaceInd
 
 	if (FaceIndex >= 0)
 	{
-		int32 TotalFaceCount = 0;
-		for (int32 SectionIdx = 0; SectionIdx < VisMeshSections.Num(); SectionIdx++)
+		// Section 变化后 (或碰撞数据从磁盘加载) 按当前 Section 重建，且与 BodySetup 导出三角形时的 bUseAllTriData 一致
+		const bool bUseAllTriData = VisMeshBodySetup != nullptr && VisMeshBodySetup->bMeshCollideAll;
+		if (!bCollisionFaceTableValid || bCollisionFaceTableAllTriData != bUseAllTriData)
 		{
-			const FVisMeshSection& Section = VisMeshSections[SectionIdx];
-			int32 NumFaces = Section.Data.Triangles.Num() / 3; // SOA change
-			TotalFaceCount += NumFaces;
+			BuildCollisionFaceTable(bUseAllTriData);
+		}
 
-			if (FaceIndex < TotalFaceCount)
-			{
-				Result = GetMaterial(SectionIdx);
-				SectionIndex = SectionIdx;
-				break;
-			}
+		// 前缀和表上二分查找：第一个 End > FaceIndex 的 Section
+		const int32 RangeIdx = Algo::UpperBound(CollisionFaceEnds, FaceIndex);
+		if (CollisionFaceSections.IsValidIndex(RangeIdx))
+		{
+			SectionIndex = CollisionFaceSections[RangeIdx];
+			Result = GetMaterial(SectionIndex);
 		}
 	}
 	return Result;
@@ -550,6 +870,20 @@ void UVisMeshProceduralComponent::PostLoad()
 	}
 }
 
+void UVisMeshProceduralComponent::Serialize(FArchive& Ar)
+{
+	// 共享索引不是 UPROPERTY，保存 (及复制、事务) 前先拷贝到 Triangles，否则写出的 Section 没有索引
+	if (Ar.IsSaving())
+	{
+		for (FVisMeshSection& Section : VisMeshSections)
+		{
+			Section.Data.MakeTrianglesUnique();
+		}
+	}
+
+	Super::Serialize(Ar);
+}
+
 FBoxSphereBounds UVisMeshProceduralComponent::CalcBounds(const FTransform& LocalToWorld) const
 {
 	FBoxSphereBounds Ret(LocalBounds.TransformBy(LocalToWorld));
@@ -560,8 +894,20 @@ FBoxSphereBounds UVisMeshProceduralComponent::CalcBounds(const FTransform& Local
 	return Ret;
 }
 
+void UVisMeshProceduralComponent::SetDeferCollisionUpdates(bool bDefer)
+{
+	bDeferCollisionUpdates = bDefer;
+	if (!bDefer && bCollisionUpdatePending)
+	{
+		UpdateCollision();
+	}
+}
+
 void UVisMeshProceduralComponent::UpdateLocalBounds()
 {
+	// 每次位置或拓扑变化都会经过这里
+	GeometryRevision++;
+
 	FBox LocalBox(ForceInit);
 
 	for (const FVisMeshSection& Section : VisMeshSections)
@@ -590,6 +936,17 @@ void UVisMeshProceduralComponent::UpdateCollision()
 {
 	SCOPE_CYCLE_COUNTER(STAT_VisMesh_UpdateCollision);
 
+	// 连续编辑期间只记录，结束时 (SetDeferCollisionUpdates(false)) 烹饪一次
+	if (bDeferCollisionUpdates)
+	{
+		bCollisionUpdatePending = true;
+		return;
+	}
+	bCollisionUpdatePending = false;
+
+	// Section 已变化，面 -> Section 表在下次导出三角形或查询时重建
+	bCollisionFaceTableValid = false;
+
 	UWorld* World = GetWorld();
 	const bool bUseAsyncCook = World && World->IsGameWorld() && bUseAsyncCooking;
 
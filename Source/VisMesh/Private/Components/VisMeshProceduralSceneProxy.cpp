@@ -27,7 +27,7 @@ FVisMeshProceduralSceneProxy::FVisMeshProceduralSceneProxy(UVisMeshProceduralCom
 	{
 		FVisMeshSection& SrcSection = Component->VisMeshSections[SectionIdx];
 		// 检查 SOA 数据是否有效 (Triangles 和 Positions 是必须的)
-		if (SrcSection.Data.Triangles.Num() > 0 && SrcSection.Data.Positions.Num() > 0)
+		if (SrcSection.Data.NumIndices() > 0 && SrcSection.Data.Positions.Num() > 0)
 		{
 			FVisMeshProxySection* NewSection = new FVisMeshProxySection(GetScene().GetFeatureLevel());
 
@@ -40,6 +40,7 @@ FVisMeshProceduralSceneProxy::FVisMeshProceduralSceneProxy(UVisMeshProceduralCom
 			// 2. 使用 ParallelFor 将 SOA 转为 AOS (FDynamicMeshVertex)
 			// 这样可以充分利用多核加速初始数据的构建
 			const FVisMeshData& Data = SrcSection.Data;
+			const TArray<float>* ScalarValues = SrcSection.GetActiveScalarValues();
 
 			ParallelFor(NumVerts, [&](int32 i)
 			{
@@ -67,21 +68,42 @@ FVisMeshProceduralSceneProxy::FVisMeshProceduralSceneProxy(UVisMeshProceduralCom
 				Vert.TextureCoordinate[1] = Data.UV1.IsValidIndex(i) ? (FVector2f)Data.UV1[i] : FVector2f::ZeroVector;
 				Vert.TextureCoordinate[2] = Data.UV2.IsValidIndex(i) ? (FVector2f)Data.UV2[i] : FVector2f::ZeroVector;
 				Vert.TextureCoordinate[3] = Data.UV3.IsValidIndex(i) ? (FVector2f)Data.UV3[i] : FVector2f::ZeroVector;
+
+				// 标量通道 (可选)，由材质通过 LUT 映射颜色
+				if (ScalarValues)
+				{
+					Vert.TextureCoordinate[GVisMeshScalarUVIndex] = FVector2f((*ScalarValues)[i], 0.f);
+				}
 			});
 
-			// Copy index buffer (int32 -> uint32 conversion via Memcpy)
+			// 共享索引 (例如同尺寸网格) 直接复用其 IndexBuffer，否则拷贝一份
 			const int32 NumIndices = SrcSection.Data.Triangles.Num();
-			NewSection->IndexBuffer.Indices.SetNumUninitialized(NumIndices);
-			FMemory::Memcpy(NewSection->IndexBuffer.Indices.GetData(), SrcSection.Data.Triangles.GetData(), NumIndices * sizeof(uint32));
+			const TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe>& SharedIndices = SrcSection.Data.SharedIndices;
+			if (SharedIndices.IsValid())
+			{
+				NewSection->SharedIndices = SharedIndices;
+				SharedIndices->BeginInitOnce();
+			}
+			else
+			{
+				// Copy index buffer (int32 -> uint32 conversion via Memcpy)
+				NewSection->IndexBuffer.Indices.SetNumUninitialized(NumIndices);
+				FMemory::Memcpy(NewSection->IndexBuffer.Indices.GetData(), SrcSection.Data.Triangles.GetData(), NumIndices * sizeof(uint32));
+				BeginInitResource(&NewSection->IndexBuffer);
+			}
 
 			// Init Vertex Buffers
-			NewSection->VertexBuffers.InitFromDynamicVertex(&NewSection->VertexFactory, Vertices, 4);
+			// 标量通道需要全精度 UV，否则半精度会损失原始数值
+			if (ScalarValues)
+			{
+				NewSection->VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
+			}
+			NewSection->VertexBuffers.InitFromDynamicVertex(&NewSection->VertexFactory, Vertices, ScalarValues ? GVisMeshScalarUVIndex + 1 : 4);
 
 			// Enqueue initialization of render resource
 			BeginInitResource(&NewSection->VertexBuffers.PositionVertexBuffer);
 			BeginInitResource(&NewSection->VertexBuffers.StaticMeshVertexBuffer);
 			BeginInitResource(&NewSection->VertexBuffers.ColorVertexBuffer);
-			BeginInitResource(&NewSection->IndexBuffer);
 			BeginInitResource(&NewSection->VertexFactory);
 
 			// Grab material
@@ -93,6 +115,8 @@ FVisMeshProceduralSceneProxy::FVisMeshProceduralSceneProxy(UVisMeshProceduralCom
 
 			// Copy visibility info
 			NewSection->bSectionVisible = SrcSection.bSectionVisible;
+			NewSection->DrawFirstIndex = SrcSection.DrawFirstIndex;
+			NewSection->DrawNumIndices = SrcSection.DrawNumIndices;
 
 			// Save ref to new section
 			Sections[SectionIdx] = NewSection;
@@ -133,6 +157,7 @@ void FVisMeshProceduralSceneProxy::UpdateSection_RenderThread(FRHICommandListBas
 			// 获取 SOA 数据
 			const FVisMeshData& NewData = SectionData->Data;
 			const int32 NumVerts = NewData.NumVertices();
+			const bool bUpdateScalars = SectionData->ScalarValues.Num() == NumVerts && Section->VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords() > GVisMeshScalarUVIndex;
 
 			// 确保顶点数匹配，否则无法仅更新 Buffer (需重建)
 			if (NumVerts == Section->VertexBuffers.PositionVertexBuffer.GetNumVertices())
@@ -168,6 +193,7 @@ void FVisMeshProceduralSceneProxy::UpdateSection_RenderThread(FRHICommandListBas
 					if (NewData.UV1.IsValidIndex(i)) Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 1, (FVector2f)NewData.UV1[i]);
 					if (NewData.UV2.IsValidIndex(i)) Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 2, (FVector2f)NewData.UV2[i]);
 					if (NewData.UV3.IsValidIndex(i)) Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 3, (FVector2f)NewData.UV3[i]);
+					if (bUpdateScalars) Section->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, GVisMeshScalarUVIndex, FVector2f(SectionData->ScalarValues[i], 0.f));
 				});
 
 				// --- 2. 提交到 GPU (RHI Unlock & Memcpy) ---
@@ -208,6 +234,139 @@ void FVisMeshProceduralSceneProxy::UpdateSection_RenderThread(FRHICommandListBas
 	}
 }
 
+void FVisMeshProceduralSceneProxy::UpdateSectionRanges_RenderThread(FRHICommandListBase& RHICmdList, FVisMeshSectionRangeUpdateData* RangeData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VisMesh_UpdateSectionRT);
+
+	if (RangeData == nullptr) return;
+
+	const TArray<FIntPoint>& Ranges = RangeData->Ranges;
+	if (Sections.IsValidIndex(RangeData->TargetSection) && Sections[RangeData->TargetSection] != nullptr && Ranges.Num() > 0)
+	{
+		FVisMeshProxySection* Section = Sections[RangeData->TargetSection];
+		FStaticMeshVertexBuffers& VertexBuffers = Section->VertexBuffers;
+		const FVisMeshData& NewData = RangeData->Data;
+		const int32 NumVerts = VertexBuffers.PositionVertexBuffer.GetNumVertices();
+
+		TArray<int32> RangeOffsets;
+		RangeOffsets.SetNumUninitialized(Ranges.Num());
+		int32 TotalVerts = 0;
+		for (int32 RangeIdx = 0; RangeIdx < Ranges.Num(); RangeIdx++)
+		{
+			RangeOffsets[RangeIdx] = TotalVerts;
+			TotalVerts += Ranges[RangeIdx].Y;
+		}
+
+		// 顶点数不一致说明 Section 已被重建，丢弃这次更新
+		if (Ranges.Last().X + Ranges.Last().Y <= NumVerts)
+		{
+			const bool bPositions = NewData.Positions.Num() == TotalVerts;
+			const bool bColors = NewData.Colors.Num() == TotalVerts && (int32)VertexBuffers.ColorVertexBuffer.GetNumVertices() == NumVerts;
+			const bool bTangents = NewData.Normals.Num() == TotalVerts;
+			const int32 NumTexCoords = FMath::Min((int32)VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords(), 4);
+			const TArray<FVector2D>* UVs[4] = { &NewData.UV0, &NewData.UV1, &NewData.UV2, &NewData.UV3 };
+			bool bUVs = false;
+			for (int32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+			{
+				bUVs |= UVs[UVIndex]->Num() == TotalVerts;
+			}
+
+			// --- 1. 并行写入 CPU 端数据，只触及区间内的顶点 ---
+			ParallelFor(Ranges.Num(), [&](int32 RangeIdx)
+			{
+				for (int32 k = 0; k < Ranges[RangeIdx].Y; k++)
+				{
+					const int32 Src = RangeOffsets[RangeIdx] + k;
+					const int32 Dst = Ranges[RangeIdx].X + k;
+
+					if (bPositions) VertexBuffers.PositionVertexBuffer.VertexPosition(Dst) = (FVector3f)NewData.Positions[Src];
+					if (bColors) VertexBuffers.ColorVertexBuffer.VertexColor(Dst) = NewData.Colors[Src];
+					if (bTangents)
+					{
+						FVector3f TangentX = NewData.Tangents.IsValidIndex(Src) ? (FVector3f)NewData.Tangents[Src].TangentX : FVector3f(1, 0, 0);
+						FVector3f TangentZ = (FVector3f)NewData.Normals[Src];
+						bool bFlip = NewData.Tangents.IsValidIndex(Src) ? NewData.Tangents[Src].bFlipTangentY : false;
+						FVector3f TangentY = (TangentZ ^ TangentX) * (bFlip ? -1.f : 1.f);
+						VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(Dst, TangentX, TangentY, TangentZ);
+					}
+					for (int32 UVIndex = 0; bUVs && UVIndex < NumTexCoords; UVIndex++)
+					{
+						if (UVs[UVIndex]->IsValidIndex(Src)) VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(Dst, UVIndex, (FVector2f)(*UVs[UVIndex])[Src]);
+					}
+				}
+			});
+
+			// --- 2. 只上传这些区间 ---
+			// 区间很多时 (大量零散的小区间) 合并为一次覆盖 [首, 尾) 的上传，避免成千上万次 Lock
+			constexpr int32 MaxRangeLocks = 64;
+			auto UploadRanges = [&](FRHIBuffer* BufferRHI, const void* CPUData, uint32 Stride)
+			{
+				auto Upload = [&](int32 FirstVertex, int32 Count)
+				{
+					void* BufferData = RHICmdList.LockBuffer(BufferRHI, FirstVertex * Stride, Count * Stride, RLM_WriteOnly);
+					FMemory::Memcpy(BufferData, (const uint8*)CPUData + FirstVertex * Stride, Count * Stride);
+					RHICmdList.UnlockBuffer(BufferRHI);
+				};
+
+				if (Ranges.Num() > MaxRangeLocks)
+				{
+					Upload(Ranges[0].X, Ranges.Last().X + Ranges.Last().Y - Ranges[0].X);
+				}
+				else
+				{
+					for (const FIntPoint& Range : Ranges)
+					{
+						Upload(Range.X, Range.Y);
+					}
+				}
+			};
+
+			auto& StaticMeshVertexBuffer = VertexBuffers.StaticMeshVertexBuffer;
+			if (bPositions)
+			{
+				UploadRanges(VertexBuffers.PositionVertexBuffer.VertexBufferRHI, VertexBuffers.PositionVertexBuffer.GetVertexData(), VertexBuffers.PositionVertexBuffer.GetStride());
+			}
+			if (bColors)
+			{
+				UploadRanges(VertexBuffers.ColorVertexBuffer.VertexBufferRHI, VertexBuffers.ColorVertexBuffer.GetVertexData(), VertexBuffers.ColorVertexBuffer.GetStride());
+			}
+			if (bTangents)
+			{
+				UploadRanges(StaticMeshVertexBuffer.TangentsVertexBuffer.VertexBufferRHI, StaticMeshVertexBuffer.GetTangentData(), StaticMeshVertexBuffer.GetTangentSize() / NumVerts);
+			}
+			if (bUVs)
+			{
+				UploadRanges(StaticMeshVertexBuffer.TexCoordVertexBuffer.VertexBufferRHI, StaticMeshVertexBuffer.GetTexCoordData(), StaticMeshVertexBuffer.GetTexCoordSize() / NumVerts);
+			}
+		}
+	}
+
+	delete RangeData;
+}
+
+void FVisMeshProceduralSceneProxy::UpdateSectionScalars_RenderThread(FRHICommandListBase& RHICmdList, int32 SectionIndex, const TArray<float>& ScalarValues)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VisMesh_UpdateSectionRT);
+
+	if (!Sections.IsValidIndex(SectionIndex) || Sections[SectionIndex] == nullptr) return;
+
+	FVisMeshProxySection* Section = Sections[SectionIndex];
+	auto& VertexBuffer = Section->VertexBuffers.StaticMeshVertexBuffer;
+
+	// 只有创建时带标量通道的 Section 才有对应的 UV 槽位
+	if (ScalarValues.Num() != (int32)VertexBuffer.GetNumVertices() || VertexBuffer.GetNumTexCoords() <= GVisMeshScalarUVIndex) return;
+
+	ParallelFor(ScalarValues.Num(), [&](int32 i)
+	{
+		VertexBuffer.SetVertexUV(i, GVisMeshScalarUVIndex, FVector2f(ScalarValues[i], 0.f));
+	});
+
+	// UV 在 TexCoord Buffer 中是交错存储的，只需上传这一个 Buffer
+	void* TexCoordBufferData = RHICmdList.LockBuffer(VertexBuffer.TexCoordVertexBuffer.VertexBufferRHI, 0, VertexBuffer.GetTexCoordSize(), RLM_WriteOnly);
+	FMemory::Memcpy(TexCoordBufferData, VertexBuffer.GetTexCoordData(), VertexBuffer.GetTexCoordSize());
+	RHICmdList.UnlockBuffer(VertexBuffer.TexCoordVertexBuffer.VertexBufferRHI);
+}
+
 void FVisMeshProceduralSceneProxy::SetSectionVisibility_RenderThread(int32 SectionIndex, bool bNewVisibility)
 {
 	check(IsInRenderingThread());
@@ -218,6 +377,17 @@ void FVisMeshProceduralSceneProxy::SetSectionVisibility_RenderThread(int32 Secti
 	}
 }
 
+void FVisMeshProceduralSceneProxy::SetSectionDrawRange_RenderThread(int32 SectionIndex, int32 FirstIndex, int32 NumIndices)
+{
+	check(IsInRenderingThread());
+
+	if (SectionIndex < Sections.Num() && Sections[SectionIndex] != nullptr)
+	{
+		Sections[SectionIndex]->DrawFirstIndex = FirstIndex;
+		Sections[SectionIndex]->DrawNumIndices = NumIndices;
+	}
+}
+
 void FVisMeshProceduralSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
 {
 	// Set up wireframe material (if needed)
@@ -234,6 +404,15 @@ void FVisMeshProceduralSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 	{
 		if (Section != nullptr && Section->bSectionVisible)
 		{
+			// 绘制范围裁剪到索引缓冲区内，空范围直接跳过
+			const int32 NumSectionIndices = Section->GetNumIndices();
+			const int32 FirstIndex = FMath::Clamp(Section->DrawFirstIndex, 0, NumSectionIndices);
+			const int32 NumDrawIndices = Section->DrawNumIndices == INDEX_NONE ? NumSectionIndices - FirstIndex : FMath::Min(Section->DrawNumIndices, NumSectionIndices - FirstIndex);
+			if (NumDrawIndices < 3)
+			{
+				continue;
+			}
+
 			FMaterialRenderProxy* MaterialProxy = bWireframe? WireframeMaterialInstance: Section->Material->GetRenderProxy();
 
 			// For each view..
@@ -245,7 +424,7 @@ void FVisMeshProceduralSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 					// Draw the mesh
 					FMeshBatch& Mesh = Collector.AllocateMesh();
 					FMeshBatchElement& BatchElement = Mesh.Elements[0];
-					BatchElement.IndexBuffer = &Section->IndexBuffer;
+					BatchElement.IndexBuffer = Section->GetIndexBuffer();
 					Mesh.bWireframe = bWireframe;
 					Mesh.VertexFactory = &Section->VertexFactory;
 					Mesh.MaterialRenderProxy = MaterialProxy;
@@ -264,8 +443,8 @@ void FVisMeshProceduralSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 					                                  GetCustomPrimitiveData());
 					BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
 
-					BatchElement.FirstIndex = 0;
-					BatchElement.NumPrimitives = Section->IndexBuffer.Indices.Num() / 3;
+					BatchElement.FirstIndex = FirstIndex;
+					BatchElement.NumPrimitives = NumDrawIndices / 3;
 					BatchElement.MinVertexIndex = 0;
 					BatchElement.MaxVertexIndex = Section->VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
 					Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
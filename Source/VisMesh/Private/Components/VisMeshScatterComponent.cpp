@@ -0,0 +1,165 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Components/VisMeshScatterComponent.h"
+
+#include "Components/VisMeshScatterSceneProxy.h"
+#include "Async/ParallelFor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshScatterComponent)
+
+UVisMeshScatterComponent::UVisMeshScatterComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UVisMeshScatterComponent::SetPoints(const TArray<FVector>& Positions, const TArray<float>& Radii, const TArray<float>& Scalars)
+{
+	if ((Radii.Num() != 0 && Radii.Num() != Positions.Num()) || (Scalars.Num() != 0 && Scalars.Num() != Positions.Num()))
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("SetPoints: %d positions but %d radii and %d scalars."), Positions.Num(), Radii.Num(), Scalars.Num());
+		return;
+	}
+
+	TArray<FVisMeshScatterPoint> NewPoints;
+	NewPoints.SetNumUninitialized(Positions.Num());
+	const bool bHasRadii = Radii.Num() != 0;
+	const bool bHasScalars = Scalars.Num() != 0;
+	ParallelFor(Positions.Num(), [&](int32 i)
+	{
+		NewPoints[i].Position = FVector3f(Positions[i]);
+		NewPoints[i].Radius = bHasRadii ? Radii[i] : DefaultRadius;
+		NewPoints[i].Scalar = bHasScalars ? Scalars[i] : 0.f;
+	});
+
+	SetPoints(MoveTemp(NewPoints));
+}
+
+void UVisMeshScatterComponent::SetPoints(TArray<FVisMeshScatterPoint>&& InPoints)
+{
+	Points = MoveTemp(InPoints);
+	UpdatePointBounds(Points, false);
+
+	// 点数变化需要重建点缓冲区与实例缓冲区，否则只上传点数据
+	if (Points.Num() != ProxyNumPoints)
+	{
+		ProxyNumPoints = Points.Num();
+		MarkRenderStateDirty();
+		return;
+	}
+
+	SendPoints(0, Points.Num());
+}
+
+void UVisMeshScatterComponent::UpdatePoints(int32 FirstPoint, TArrayView<const FVisMeshScatterPoint> InPoints)
+{
+	if (InPoints.Num() == 0 || FirstPoint < 0 || FirstPoint + InPoints.Num() > Points.Num())
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("UpdatePoints: %d points from %d do not fit %d points."), InPoints.Num(), FirstPoint, Points.Num());
+		return;
+	}
+
+	FMemory::Memcpy(Points.GetData() + FirstPoint, InPoints.GetData(), InPoints.Num() * sizeof(FVisMeshScatterPoint));
+
+	// 部分更新只扩大包围盒，避免每次都扫描全部点
+	UpdatePointBounds(InPoints, true);
+	SendPoints(FirstPoint, InPoints.Num());
+}
+
+void UVisMeshScatterComponent::ClearPoints()
+{
+	SetPoints(TArray<FVisMeshScatterPoint>());
+}
+
+void UVisMeshScatterComponent::SetUseImpostors(bool bInUseImpostors)
+{
+	if (bUseImpostors != bInUseImpostors)
+	{
+		// 实例网格不同，需要重建 Proxy (点数据随之重新上传)
+		bUseImpostors = bInUseImpostors;
+		MarkRenderStateDirty();
+	}
+}
+
+void UVisMeshScatterComponent::SendPoints(int32 FirstPoint, int32 Count)
+{
+	if (SceneProxy == nullptr || IsRenderStateDirty() || Count <= 0)
+	{
+		return;
+	}
+
+	TArray<FVisMeshScatterPoint> UploadPoints(Points.GetData() + FirstPoint, Count);
+
+	FVisMeshScatterSceneProxy* ScatterSceneProxy = (FVisMeshScatterSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshScatterPointsUpdate)
+	([ScatterSceneProxy, FirstPoint, UploadPoints = MoveTemp(UploadPoints)](FRHICommandListImmediate& RHICmdList)
+	{
+		ScatterSceneProxy->UpdatePoints_RenderThread(RHICmdList, FirstPoint, UploadPoints);
+	});
+}
+
+void UVisMeshScatterComponent::UpdatePointBounds(TArrayView<const FVisMeshScatterPoint> InPoints, bool bExpandOnly)
+{
+	// 1. 分块并行求点中心的包围盒与最大半径
+	constexpr int32 ChunkSize = 4096;
+	const int32 NumChunks = FMath::DivideAndRoundUp(InPoints.Num(), ChunkSize);
+	TArray<FBox3f> ChunkBounds;
+	TArray<float> ChunkMaxRadius;
+	ChunkBounds.SetNumUninitialized(NumChunks);
+	ChunkMaxRadius.SetNumUninitialized(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 Begin = ChunkIdx * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, InPoints.Num());
+		FBox3f LocalBox(ForceInit);
+		float LocalMaxRadius = 0.f;
+		for (int32 i = Begin; i < End; i++)
+		{
+			LocalBox += InPoints[i].Position;
+			LocalMaxRadius = FMath::Max(LocalMaxRadius, InPoints[i].Radius);
+		}
+		ChunkBounds[ChunkIdx] = LocalBox;
+		ChunkMaxRadius[ChunkIdx] = LocalMaxRadius;
+	});
+
+	FBox NewBounds = bExpandOnly ? PositionBounds : FBox(ForceInit);
+	float NewMaxRadius = bExpandOnly ? MaxRadius : 0.f;
+	for (int32 ChunkIdx = 0; ChunkIdx < NumChunks; ChunkIdx++)
+	{
+		NewBounds += FBox(ChunkBounds[ChunkIdx]);
+		NewMaxRadius = FMath::Max(NewMaxRadius, ChunkMaxRadius[ChunkIdx]);
+	}
+
+	// 2. 范围变化时才更新包围盒
+	if (NewBounds != PositionBounds || NewMaxRadius != MaxRadius)
+	{
+		PositionBounds = NewBounds;
+		MaxRadius = NewMaxRadius;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+}
+
+FPrimitiveSceneProxy* UVisMeshScatterComponent::CreateSceneProxy()
+{
+	ProxyNumPoints = Points.Num();
+	return new FVisMeshScatterSceneProxy(this);
+}
+
+int32 UVisMeshScatterComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+FBoxSphereBounds UVisMeshScatterComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// 点中心的包围盒按最大半径 (GPU 上乘以 RadiusScale) 扩展
+	const FBox CenterBox = PositionBounds.IsValid ? PositionBounds : FBox(FVector::ZeroVector, FVector::ZeroVector);
+	const FBox LocalBox = CenterBox.ExpandBy(MaxRadius * RadiusScale);
+
+	FBoxSphereBounds Ret(FBoxSphereBounds(LocalBox).TransformBy(LocalToWorld));
+
+	Ret.BoxExtent *= BoundsScale;
+	Ret.SphereRadius *= BoundsScale;
+
+	return Ret;
+}
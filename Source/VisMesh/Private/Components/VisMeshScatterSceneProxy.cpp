@@ -0,0 +1,382 @@
+#include "Components/VisMeshScatterSceneProxy.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#include "RenderGraphUtils.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "RenderBase/VisMeshInstancedVertexFactory.h"
+#include "Utils/VisMeshUtils.h"
+
+/** 以原点为中心的单位 Icosphere (Subdivisions 次细分)，绕序与 GetUnitCubeIndices 相同 (从外侧看为顺时针) */
+static void BuildUnitIcosphere(int32 Subdivisions, TArray<FVector3f>& OutVertices, TArray<uint32>& OutIndices)
+{
+	// 1. 正二十面体
+	const float T = (1.f + FMath::Sqrt(5.f)) * 0.5f;
+	OutVertices = {
+		FVector3f(-1, T, 0), FVector3f(1, T, 0), FVector3f(-1, -T, 0), FVector3f(1, -T, 0),
+		FVector3f(0, -1, T), FVector3f(0, 1, T), FVector3f(0, -1, -T), FVector3f(0, 1, -T),
+		FVector3f(T, 0, -1), FVector3f(T, 0, 1), FVector3f(-T, 0, -1), FVector3f(-T, 0, 1)
+	};
+	for (FVector3f& Vertex : OutVertices)
+	{
+		Vertex.Normalize();
+	}
+
+	OutIndices = {
+		0, 11, 5,  0, 5, 1,   0, 1, 7,   0, 7, 10,  0, 10, 11,
+		1, 5, 9,   5, 11, 4,  11, 10, 2, 10, 7, 6,  7, 1, 8,
+		3, 9, 4,   3, 4, 2,   3, 2, 6,   3, 6, 8,   3, 8, 9,
+		4, 9, 5,   2, 4, 11,  6, 2, 10,  8, 6, 7,   9, 8, 1
+	};
+
+	// 2. 每次细分把一个三角形拆成四个，边中点投影回球面 (共享边只生成一个中点)
+	for (int32 Level = 0; Level < Subdivisions; Level++)
+	{
+		TMap<uint64, uint32> MidpointCache;
+		auto GetMidpoint = [&](uint32 A, uint32 B)
+		{
+			const uint64 Key = (uint64(FMath::Min(A, B)) << 32) | FMath::Max(A, B);
+			if (const uint32* Found = MidpointCache.Find(Key))
+			{
+				return *Found;
+			}
+			const uint32 NewIndex = OutVertices.Add((OutVertices[A] + OutVertices[B]).GetSafeNormal());
+			MidpointCache.Add(Key, NewIndex);
+			return NewIndex;
+		};
+
+		TArray<uint32> NewIndices;
+		NewIndices.Reserve(OutIndices.Num() * 4);
+		for (int32 i = 0; i < OutIndices.Num(); i += 3)
+		{
+			const uint32 V0 = OutIndices[i], V1 = OutIndices[i + 1], V2 = OutIndices[i + 2];
+			const uint32 M01 = GetMidpoint(V0, V1), M12 = GetMidpoint(V1, V2), M20 = GetMidpoint(V2, V0);
+			NewIndices.Append({ V0, M01, M20,  V1, M12, M01,  V2, M20, M12,  M01, M12, M20 });
+		}
+		OutIndices = MoveTemp(NewIndices);
+	}
+
+	// 3. 统一绕序：(V2 - V0) x (V1 - V0) 指向外侧
+	for (int32 i = 0; i < OutIndices.Num(); i += 3)
+	{
+		const FVector3f& P0 = OutVertices[OutIndices[i]];
+		const FVector3f& P1 = OutVertices[OutIndices[i + 1]];
+		const FVector3f& P2 = OutVertices[OutIndices[i + 2]];
+		if (FVector3f::DotProduct((P2 - P0) ^ (P1 - P0), P0 + P1 + P2) < 0.f)
+		{
+			Swap(OutIndices[i + 1], OutIndices[i + 2]);
+		}
+	}
+}
+
+/** Impostor 四边形：顶点 (±1, ±1, -1)，与 VisMeshExpandSphereImpostor 的角点顺序相同，从 -Z 一侧看为正面 */
+static void BuildImpostorQuad(TArray<FVector3f>& OutVertices, TArray<uint32>& OutIndices)
+{
+	OutVertices = { FVector3f(-1, -1, -1), FVector3f(1, -1, -1), FVector3f(-1, 1, -1), FVector3f(1, 1, -1) };
+	// 与 GenerateBoxMesh 的 -Y 面相同的绕序
+	OutIndices = { 0, 1, 2,  1, 3, 2 };
+}
+
+FVisMeshScatterSceneProxy::FVisMeshScatterSceneProxy(UVisMeshScatterComponent* Component)
+	: FVisMeshSceneProxyBase(Component)
+	  , NumPoints(Component->GetNumPoints())
+	  , RadiusScale(Component->RadiusScale)
+	  , SphereSubdivisions(FMath::Clamp(Component->SphereSubdivisions, 0, 2))
+	  , bUseImpostors(Component->bUseImpostors)
+	  , InitialPoints(Component->GetPoints())
+	  , Material(Component->GetMaterial(0))
+	  , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	bVFRequiresPrimitiveUniformBuffer = true;
+
+	if (Material == nullptr)
+	{
+		Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	}
+}
+
+SIZE_T FVisMeshScatterSceneProxy::GetTypeHash() const
+{
+	static size_t UniquePointer;
+	return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+uint32 FVisMeshScatterSceneProxy::GetMemoryFootprint() const
+{
+	return (sizeof(*this) + GetAllocatedSize());
+}
+
+FPrimitiveViewRelevance FVisMeshScatterSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bShadowRelevance = IsShadowCast(View);
+	Result.bDynamicRelevance = true;
+	Result.bRenderInMainPass = ShouldRenderInMainPass();
+	Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+	Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+	return Result;
+}
+
+bool FVisMeshScatterSceneProxy::CanBeOccluded() const
+{
+	return !MaterialRelevance.bDisableDepthTest;
+}
+
+void FVisMeshScatterSceneProxy::CreateRenderThreadResources()
+{
+	check(VertexFactory == nullptr);
+
+	if (NumPoints <= 0)
+	{
+		return;
+	}
+
+	FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+
+	// 1. 点数据只在这里与 UpdatePoints_RenderThread 中上传
+	PointBuffer = new FVisMeshStructuredBuffer(NumPoints, sizeof(FVisMeshScatterPoint));
+	PointBuffer->InitResource(RHICmdList);
+	PointBuffer->Update(RHICmdList, 0, InitialPoints.GetData(), NumPoints);
+	InitialPoints.Empty();
+
+	// 2. 实例网格：单位球的法线即位置；Impostor 四边形朝向 -Z (实例变换后朝向相机)，法线由材质求交得到
+	{
+		TArray<FVector3f> Vertices;
+		TArray<uint32> Indices;
+		TArray<FPackedNormal> Tangents;
+		if (bUseImpostors)
+		{
+			BuildImpostorQuad(Vertices, Indices);
+			NumMeshVertices = Vertices.Num();
+			Tangents.SetNumUninitialized(NumMeshVertices * 2);
+			for (int32 i = 0; i < NumMeshVertices; i++)
+			{
+				Tangents[i * 2 + 0] = FPackedNormal(FVector3f(1.f, 0.f, 0.f));
+				Tangents[i * 2 + 1] = FPackedNormal(FVector4f(0.f, 0.f, -1.f, 1.f));
+			}
+		}
+		else
+		{
+			BuildUnitIcosphere(SphereSubdivisions, Vertices, Indices);
+			NumMeshVertices = Vertices.Num();
+			Tangents.SetNumUninitialized(NumMeshVertices * 2);
+			for (int32 i = 0; i < NumMeshVertices; i++)
+			{
+				const FVector3f Normal = Vertices[i];
+				FVector3f TangentX = FVector3f::CrossProduct(FVector3f::UpVector, Normal);
+				TangentX = TangentX.SizeSquared() > UE_SMALL_NUMBER ? TangentX.GetUnsafeNormal() : FVector3f::ForwardVector;
+				Tangents[i * 2 + 0] = FPackedNormal(TangentX);
+				Tangents[i * 2 + 1] = FPackedNormal(FVector4f(Normal, 1.f));
+			}
+		}
+
+		MeshPositionBuffer = new FVisMeshTypedVertexBuffer(NumMeshVertices * 3, PF_R32_FLOAT, false);
+		MeshTangentBuffer = new FVisMeshTypedVertexBuffer(NumMeshVertices * 2, PF_R8G8B8A8_SNORM, false);
+		MeshPositionBuffer->InitResource(RHICmdList);
+		MeshTangentBuffer->InitResource(RHICmdList);
+		MeshPositionBuffer->Update(RHICmdList, 0, Vertices.GetData(), NumMeshVertices * 3);
+		MeshTangentBuffer->Update(RHICmdList, 0, Tangents.GetData(), NumMeshVertices * 2);
+
+		MeshIndexBuffer = new FVisMeshIndexBuffer(Indices);
+		MeshIndexBuffer->InitResource(RHICmdList);
+	}
+
+	// 3. 可见实例 (Compute 写入)
+	InstanceBuffer = new FVisMeshInstanceBuffer(NumPoints);
+	InstanceBuffer->InitResource(RHICmdList);
+
+	VertexFactory = new FVisMeshInstancedVertexFactory(GetScene().GetFeatureLevel(), "VisMeshScatterVertexFactory");
+	FLocalVertexFactory::FDataType NewData;
+	NewData.PositionComponent = FVertexStreamComponent(MeshPositionBuffer, 0, sizeof(FVector3f), VET_Float3);
+	NewData.TangentBasisComponents[0] = FVertexStreamComponent(MeshTangentBuffer, 0, 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.TangentBasisComponents[1] = FVertexStreamComponent(MeshTangentBuffer, sizeof(FPackedNormal), 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.ColorComponent = FVertexStreamComponent(&GNullColorVertexBuffer, 0, 0, VET_Color, EVertexStreamUsage::ManualFetch);
+
+	if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
+	{
+		NewData.PositionComponentSRV = MeshPositionBuffer->GetSRV();
+		NewData.TangentsSRV = MeshTangentBuffer->GetSRV();
+		NewData.ColorComponentsSRV = GNullColorVertexBuffer.VertexBufferSRV;
+		NewData.TextureCoordinatesSRV = GNullColorVertexBuffer.VertexBufferSRV;
+	}
+
+	FInstancedVisMeshDataType InstanceData;
+	InstanceBuffer->BindToDataType(InstanceData);
+
+	VertexFactory->SetData(NewData, &InstanceData);
+	VertexFactory->InitResource(RHICmdList);
+
+	// 4. Indirect 参数 (Compute 中 InterlockedAdd 实例数)
+	const uint32 NumArgs = sizeof(FRHIDrawIndexedIndirectParameters) / sizeof(uint32);
+	FRDGBufferDesc IndirectDesc = FRDGBufferDesc::CreateIndirectDesc(NumArgs);
+	IndirectDesc.Usage |= EBufferUsageFlags::UnorderedAccess;
+
+	FRHIResourceCreateInfo IndirectCreateInfo(TEXT("VisMeshScatterIndirectArgs"));
+	FBufferRHIRef RawIndirectBuffer = RHICmdList.CreateBuffer(
+		sizeof(FRHIDrawIndexedIndirectParameters),
+		EBufferUsageFlags::UnorderedAccess | EBufferUsageFlags::DrawIndirect | EBufferUsageFlags::ShaderResource,
+		IndirectDesc.BytesPerElement,
+		ERHIAccess::IndirectArgs,
+		IndirectCreateInfo);
+
+	IndirectArgsBuffer = new FRDGPooledBuffer(RHICmdList, RawIndirectBuffer, IndirectDesc, IndirectDesc.NumElements, TEXT("VisMeshScatterIndirectArgs"));
+}
+
+void FVisMeshScatterSceneProxy::DestroyRenderThreadResources()
+{
+	if (VertexFactory != nullptr)
+	{
+		VertexFactory->ReleaseResource();
+		delete VertexFactory;
+		VertexFactory = nullptr;
+	}
+
+	FVisMeshTypedVertexBuffer** Buffers[] = { &MeshPositionBuffer, &MeshTangentBuffer };
+	for (FVisMeshTypedVertexBuffer** Buffer : Buffers)
+	{
+		if (*Buffer != nullptr)
+		{
+			(*Buffer)->ReleaseResource();
+			delete *Buffer;
+			*Buffer = nullptr;
+		}
+	}
+
+	if (MeshIndexBuffer != nullptr)
+	{
+		MeshIndexBuffer->ReleaseResource();
+		delete MeshIndexBuffer;
+		MeshIndexBuffer = nullptr;
+	}
+	if (InstanceBuffer != nullptr)
+	{
+		InstanceBuffer->ReleaseResource();
+		delete InstanceBuffer;
+		InstanceBuffer = nullptr;
+	}
+	if (PointBuffer != nullptr)
+	{
+		PointBuffer->ReleaseResource();
+		delete PointBuffer;
+		PointBuffer = nullptr;
+	}
+
+	IndirectArgsBuffer.SafeRelease();
+}
+
+void FVisMeshScatterSceneProxy::UpdatePoints_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstPoint, const TArray<FVisMeshScatterPoint>& InPoints)
+{
+	check(IsInRenderingThread());
+
+	if (PointBuffer == nullptr)
+	{
+		return;
+	}
+
+	check(FirstPoint >= 0 && FirstPoint + InPoints.Num() <= NumPoints);
+	PointBuffer->Update(RHICmdList, FirstPoint, InPoints.GetData(), InPoints.Num());
+}
+
+void FVisMeshScatterSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily)
+{
+	if (VertexFactory == nullptr || !IndirectArgsBuffer || ViewFamily.Views.Num() == 0)
+	{
+		return;
+	}
+
+	// 隐藏时不清零、不剔除也不展开，显示后的第一帧重新计算
+	if (!IsShown(ViewFamily.Views[0]))
+	{
+		return;
+	}
+
+	// 1. 清零实例计数
+	FRDGBufferRef IndirectArgsRDG = GraphBuilder.RegisterExternalBuffer(IndirectArgsBuffer);
+	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(IndirectArgsRDG, PF_R32_UINT), 0);
+
+	// 2. 按主视图剔除并展开实例 (点数据本身不变，不重新上传)；Impostor 朝向主视图相机 (组件局部空间)
+	const FSceneView* MainView = ViewFamily.Views[0];
+	const FMatrix44f ViewProjectionMatrix = FMatrix44f(MainView->ViewMatrices.GetViewProjectionMatrix().GetTransposed());
+	const FMatrix44f ModelMatrix = FMatrix44f(GetLocalToWorld());
+	const FVector3f LocalCameraPosition = FVector3f(GetLocalToWorld().InverseTransformPosition(MainView->ViewMatrices.GetViewOrigin()));
+
+	AddScatterPointInstancePass(GraphBuilder, PointBuffer->GetSRV(), InstanceBuffer->GetOriginUAV(), InstanceBuffer->GetTransformUAV(),
+		GraphBuilder.CreateUAV(IndirectArgsRDG, PF_R32_UINT), NumPoints, RadiusScale, MeshIndexBuffer->Indices.Num(),
+		bUseImpostors, LocalCameraPosition, ViewProjectionMatrix, ModelMatrix);
+}
+
+void FVisMeshScatterSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
+{
+	if (VertexFactory == nullptr || !IndirectArgsBuffer)
+	{
+		return;
+	}
+
+	// Set up wireframe material (if needed)
+	const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+	FColoredMaterialRenderProxy* WireframeMaterialInstance = nullptr;
+	if (bWireframe)
+	{
+		WireframeMaterialInstance = new FColoredMaterialRenderProxy(GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : NULL, FLinearColor(0, 0.5f, 1.f));
+		Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+	}
+
+	FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Material->GetRenderProxy();
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = MeshIndexBuffer;
+			Mesh.bWireframe = bWireframe;
+			Mesh.VertexFactory = VertexFactory;
+			Mesh.MaterialRenderProxy = MaterialProxy;
+
+			bool bHasPrecomputedVolumetricLightmap;
+			FMatrix PreviousLocalToWorld;
+			int32 SingleCaptureIndex;
+			bool bOutputVelocity;
+			GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
+			bOutputVelocity |= AlwaysHasVelocity();
+
+			FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+			DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(),
+			                                  GetLocalBounds(), GetLocalBounds(), ReceivesDecals(),
+			                                  bHasPrecomputedVolumetricLightmap, bOutputVelocity,
+			                                  GetCustomPrimitiveData());
+			BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+
+			// 实例数量与索引数量都来自 Indirect 参数
+			BatchElement.FirstIndex = 0;
+			BatchElement.NumPrimitives = 0;
+			BatchElement.NumInstances = 1;
+			BatchElement.IndirectArgsBuffer = IndirectArgsBuffer->GetRHI();
+			BatchElement.IndirectArgsOffset = 0;
+			BatchElement.MinVertexIndex = 0;
+			BatchElement.MaxVertexIndex = NumMeshVertices - 1;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = false;
+			Collector.AddMesh(ViewIndex, Mesh);
+		}
+	}
+
+	// Draw bounds
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			RenderBounds(Collector.GetPDI(ViewIndex), ViewFamily.EngineShowFlags, GetBounds(), IsSelected());
+		}
+	}
+#endif
+}
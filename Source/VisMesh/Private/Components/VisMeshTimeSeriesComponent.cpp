@@ -0,0 +1,168 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Components/VisMeshTimeSeriesComponent.h"
+
+#include "Components/VisMeshTimeSeriesSceneProxy.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshTimeSeriesComponent)
+
+UVisMeshTimeSeriesComponent::UVisMeshTimeSeriesComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Samples.SetNumZeroed(NumChannels * Capacity);
+}
+
+void UVisMeshTimeSeriesComponent::SetStreamLayout(int32 InNumChannels, int32 InCapacity)
+{
+	NumChannels = FMath::Max(InNumChannels, 1);
+	Capacity = FMath::Max(InCapacity, 2);
+
+	Samples.Reset();
+	Samples.SetNumZeroed(NumChannels * Capacity);
+	Head = 0;
+	Count = 0;
+	MinValue = 0.f;
+	MaxValue = 0.f;
+
+	// 尺寸变化需要重建 Proxy (顶点数与索引都变了)
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void UVisMeshTimeSeriesComponent::AppendSamples(const TArray<float>& Frames)
+{
+	if (Frames.Num() == 0 || Frames.Num() % NumChannels != 0)
+	{
+		UE_LOG(LogVisComponent, Warning, TEXT("AppendSamples: %d values is not a whole number of %d-channel frames."), Frames.Num(), NumChannels);
+		return;
+	}
+
+	// 属性在编辑器中被修改过时按新尺寸重置
+	if (Samples.Num() != NumChannels * Capacity)
+	{
+		SetStreamLayout(NumChannels, Capacity);
+	}
+
+	// 1. 超过容量时只保留最新的 Capacity 帧
+	int32 NumFrames = Frames.Num() / NumChannels;
+	const float* Src = Frames.GetData();
+	if (NumFrames > Capacity)
+	{
+		Src += (NumFrames - Capacity) * NumChannels;
+		NumFrames = Capacity;
+	}
+
+	// 2. 写入 CPU 环形缓冲区 (在环尾拆成两段)
+	const int32 FirstSlot = Head;
+	const int32 FirstPart = FMath::Min(NumFrames, Capacity - Head);
+	FMemory::Memcpy(Samples.GetData() + Head * NumChannels, Src, FirstPart * NumChannels * sizeof(float));
+	FMemory::Memcpy(Samples.GetData(), Src + FirstPart * NumChannels, (NumFrames - FirstPart) * NumChannels * sizeof(float));
+	Head = (Head + NumFrames) % Capacity;
+	Count = FMath::Min(Count + NumFrames, Capacity);
+
+	// 3. 包围盒只扩大，避免每次扫描整个缓冲区
+	float NewMin = MinValue;
+	float NewMax = MaxValue;
+	for (int32 i = 0; i < NumFrames * NumChannels; i++)
+	{
+		NewMin = FMath::Min(NewMin, Src[i]);
+		NewMax = FMath::Max(NewMax, Src[i]);
+	}
+	if (NewMin != MinValue || NewMax != MaxValue)
+	{
+		MinValue = NewMin;
+		MaxValue = NewMax;
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+
+	// 4. 只上传新的帧
+	SendFrames(FirstSlot, NumFrames);
+}
+
+void UVisMeshTimeSeriesComponent::ClearSamples()
+{
+	Head = 0;
+	Count = 0;
+
+	// 值域随数据一起清空，否则包围盒仍覆盖已丢弃的样本
+	MinValue = 0.f;
+	MaxValue = 0.f;
+	UpdateBounds();
+	MarkRenderTransformDirty();
+
+	SendFrames(0, 0);
+}
+
+void UVisMeshTimeSeriesComponent::SetChannelColors(const TArray<FLinearColor>& InColors)
+{
+	ChannelColors = InColors;
+
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	TArray<FColor> Colors;
+	Colors.SetNumUninitialized(NumChannels);
+	for (int32 Channel = 0; Channel < NumChannels; Channel++)
+	{
+		Colors[Channel] = ChannelColors.Num() > 0 ? ChannelColors[Channel % ChannelColors.Num()].ToFColor(true) : FColor::White;
+	}
+
+	FVisMeshTimeSeriesSceneProxy* TimeSeriesSceneProxy = (FVisMeshTimeSeriesSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshTimeSeriesColors)
+	([TimeSeriesSceneProxy, Colors = MoveTemp(Colors)](FRHICommandListImmediate& RHICmdList)
+	{
+		TimeSeriesSceneProxy->UpdateChannelColors_RenderThread(RHICmdList, Colors);
+	});
+}
+
+void UVisMeshTimeSeriesComponent::SendFrames(int32 FirstSlot, int32 NumFrames)
+{
+	if (SceneProxy == nullptr || IsRenderStateDirty())
+	{
+		return;
+	}
+
+	// 按写入顺序拷贝 (跨过环尾时拼接)
+	TArray<float> NewFrames;
+	NewFrames.SetNumUninitialized(NumFrames * NumChannels);
+	const int32 FirstPart = FMath::Min(NumFrames, Capacity - FirstSlot);
+	FMemory::Memcpy(NewFrames.GetData(), Samples.GetData() + FirstSlot * NumChannels, FirstPart * NumChannels * sizeof(float));
+	FMemory::Memcpy(NewFrames.GetData() + FirstPart * NumChannels, Samples.GetData(), (NumFrames - FirstPart) * NumChannels * sizeof(float));
+
+	FVisMeshTimeSeriesSceneProxy* TimeSeriesSceneProxy = (FVisMeshTimeSeriesSceneProxy*)SceneProxy;
+	ENQUEUE_RENDER_COMMAND(FVisMeshTimeSeriesAppend)
+	([TimeSeriesSceneProxy, FirstSlot, NewFrames = MoveTemp(NewFrames), NewHead = Head, NewCount = Count](FRHICommandListImmediate& RHICmdList)
+	{
+		TimeSeriesSceneProxy->AppendFrames_RenderThread(RHICmdList, FirstSlot, NewFrames, NewHead, NewCount);
+	});
+}
+
+FPrimitiveSceneProxy* UVisMeshTimeSeriesComponent::CreateSceneProxy()
+{
+	return new FVisMeshTimeSeriesSceneProxy(this);
+}
+
+int32 UVisMeshTimeSeriesComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+FBoxSphereBounds UVisMeshTimeSeriesComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// 与 UpdateTimeSeriesRibbon.usf 的排布一致，四周留出线宽
+	const float ZA = MinValue * ValueScale;
+	const float ZB = MaxValue * ValueScale;
+	const FBox LocalBox(
+		FVector(-LineWidth, -LineWidth, FMath::Min(ZA, ZB) - LineWidth),
+		FVector((Capacity - 1) * SampleSpacing + LineWidth, (NumChannels - 1) * ChannelSpacing + LineWidth, FMath::Max(ZA, ZB) + LineWidth));
+
+	FBoxSphereBounds Ret(FBoxSphereBounds(LocalBox).TransformBy(LocalToWorld));
+
+	Ret.BoxExtent *= BoundsScale;
+	Ret.SphereRadius *= BoundsScale;
+
+	return Ret;
+}
@@ -0,0 +1,296 @@
+#include "Components/VisMeshTimeSeriesSceneProxy.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#include "Components/VisMeshTimeSeriesComponent.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "Utils/VisMeshUtils.h"
+
+FVisMeshTimeSeriesSceneProxy::FVisMeshTimeSeriesSceneProxy(UVisMeshTimeSeriesComponent* Component)
+	: FVisMeshSceneProxyBase(Component)
+	  , NumChannels(Component->GetNumChannels())
+	  , Capacity(Component->GetCapacity())
+	  , Head(Component->GetHead())
+	  , Count(Component->GetCount())
+	  , SampleSpacing(Component->SampleSpacing)
+	  , ChannelSpacing(Component->ChannelSpacing)
+	  , ValueScale(Component->ValueScale)
+	  , LineWidth(Component->LineWidth)
+	  , InitialSamples(Component->GetSamples())
+	  , Material(Component->GetMaterial(0))
+	  , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	bVFRequiresPrimitiveUniformBuffer = true;
+
+	if (Material == nullptr)
+	{
+		Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	}
+
+	const TArray<FLinearColor>& ChannelColors = Component->GetChannelColors();
+	InitialChannelColors.SetNumUninitialized(NumChannels);
+	for (int32 Channel = 0; Channel < NumChannels; Channel++)
+	{
+		InitialChannelColors[Channel] = ChannelColors.Num() > 0 ? ChannelColors[Channel % ChannelColors.Num()].ToFColor(true) : FColor::White;
+	}
+}
+
+SIZE_T FVisMeshTimeSeriesSceneProxy::GetTypeHash() const
+{
+	static size_t UniquePointer;
+	return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+uint32 FVisMeshTimeSeriesSceneProxy::GetMemoryFootprint() const
+{
+	return (sizeof(*this) + GetAllocatedSize());
+}
+
+FPrimitiveViewRelevance FVisMeshTimeSeriesSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bShadowRelevance = IsShadowCast(View);
+	Result.bDynamicRelevance = true;
+	Result.bRenderInMainPass = ShouldRenderInMainPass();
+	Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+	Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+	return Result;
+}
+
+bool FVisMeshTimeSeriesSceneProxy::CanBeOccluded() const
+{
+	return !MaterialRelevance.bDisableDepthTest;
+}
+
+void FVisMeshTimeSeriesSceneProxy::CreateRenderThreadResources()
+{
+	check(VertexFactory == nullptr);
+
+	FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+	const int32 NumSamples = NumChannels * Capacity;
+	const int32 NumVerts = NumSamples * 2;
+
+	// 1. 采样 (CPU 按帧上传) 与顶点流 (Compute 写入)
+	SampleBuffer = new FVisMeshTypedVertexBuffer(NumSamples, PF_R32_FLOAT, false);
+	PositionBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 3, PF_R32_FLOAT, true);
+	TangentBuffer = new FVisMeshTypedVertexBuffer(NumVerts * 2, PF_R8G8B8A8_SNORM, true);
+	ColorBuffer = new FVisMeshTypedVertexBuffer(NumVerts, PF_R8G8B8A8, false);
+	SampleBuffer->InitResource(RHICmdList);
+	PositionBuffer->InitResource(RHICmdList);
+	TangentBuffer->InitResource(RHICmdList);
+	ColorBuffer->InitResource(RHICmdList);
+
+	if (InitialSamples.Num() != NumSamples)
+	{
+		InitialSamples.SetNumZeroed(NumSamples);
+		Head = 0;
+		Count = 0;
+	}
+	SampleBuffer->Update(RHICmdList, 0, InitialSamples.GetData(), NumSamples);
+	InitialSamples.Empty();
+
+	UpdateChannelColors_RenderThread(RHICmdList, InitialChannelColors);
+	InitialChannelColors.Empty();
+
+	// 2. 每个通道一条 Ribbon：相邻采样之间一个四边形 (与 GenerateBoxMesh 的 -Y 面相同的绕序)
+	{
+		TArray<uint32> Indices;
+		Indices.SetNumUninitialized(NumChannels * (Capacity - 1) * 6);
+		for (int32 Channel = 0; Channel < NumChannels; Channel++)
+		{
+			for (int32 K = 0; K < Capacity - 1; K++)
+			{
+				const uint32 V0 = (Channel * Capacity + K) * 2;
+				uint32* Out = &Indices[(Channel * (Capacity - 1) + K) * 6];
+				Out[0] = V0;     Out[1] = V0 + 1; Out[2] = V0 + 2;
+				Out[3] = V0 + 1; Out[4] = V0 + 3; Out[5] = V0 + 2;
+			}
+		}
+
+		IndexBuffer = new FVisMeshIndexBuffer(Indices);
+		IndexBuffer->InitResource(RHICmdList);
+	}
+
+	// 首帧重建全部顶点
+	bRibbonDirty = true;
+
+	// 3. 顶点工厂直接读取 Compute 写入的 Buffer
+	VertexFactory = new FLocalVertexFactory(GetScene().GetFeatureLevel(), "VisMeshTimeSeriesVertexFactory");
+	FLocalVertexFactory::FDataType NewData;
+	NewData.PositionComponent = FVertexStreamComponent(PositionBuffer, 0, sizeof(FVector3f), VET_Float3);
+	NewData.TangentBasisComponents[0] = FVertexStreamComponent(TangentBuffer, 0, 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.TangentBasisComponents[1] = FVertexStreamComponent(TangentBuffer, sizeof(FPackedNormal), 2 * sizeof(FPackedNormal), VET_PackedNormal);
+	NewData.ColorComponent = FVertexStreamComponent(ColorBuffer, 0, sizeof(FColor), VET_Color);
+
+	if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
+	{
+		NewData.PositionComponentSRV = PositionBuffer->GetSRV();
+		NewData.TangentsSRV = TangentBuffer->GetSRV();
+		NewData.ColorComponentsSRV = ColorBuffer->GetSRV();
+		NewData.TextureCoordinatesSRV = GNullColorVertexBuffer.VertexBufferSRV;
+	}
+
+	VertexFactory->SetData(NewData);
+	VertexFactory->InitResource(RHICmdList);
+}
+
+void FVisMeshTimeSeriesSceneProxy::DestroyRenderThreadResources()
+{
+	if (VertexFactory != nullptr)
+	{
+		VertexFactory->ReleaseResource();
+		delete VertexFactory;
+		VertexFactory = nullptr;
+	}
+
+	FVisMeshTypedVertexBuffer** Buffers[] = { &SampleBuffer, &PositionBuffer, &TangentBuffer, &ColorBuffer };
+	for (FVisMeshTypedVertexBuffer** Buffer : Buffers)
+	{
+		if (*Buffer != nullptr)
+		{
+			(*Buffer)->ReleaseResource();
+			delete *Buffer;
+			*Buffer = nullptr;
+		}
+	}
+
+	if (IndexBuffer != nullptr)
+	{
+		IndexBuffer->ReleaseResource();
+		delete IndexBuffer;
+		IndexBuffer = nullptr;
+	}
+}
+
+void FVisMeshTimeSeriesSceneProxy::AppendFrames_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstSlot, const TArray<float>& Frames, int32 NewHead, int32 NewCount)
+{
+	check(IsInRenderingThread());
+
+	if (SampleBuffer == nullptr)
+	{
+		return;
+	}
+
+	// 1. 只上传新的帧，跨过环尾时拆成两次
+	const int32 NumFrames = Frames.Num() / NumChannels;
+	check(NumFrames <= Capacity && FirstSlot >= 0 && FirstSlot < Capacity);
+	const int32 FirstPart = FMath::Min(NumFrames, Capacity - FirstSlot);
+	if (FirstPart > 0)
+	{
+		SampleBuffer->Update(RHICmdList, FirstSlot * NumChannels, Frames.GetData(), FirstPart * NumChannels);
+	}
+	if (NumFrames > FirstPart)
+	{
+		SampleBuffer->Update(RHICmdList, 0, Frames.GetData() + FirstPart * NumChannels, (NumFrames - FirstPart) * NumChannels);
+	}
+
+	// 2. 滚动只改变 Head，顶点在下一次 Compute 中按新的 Head 重建
+	Head = NewHead;
+	Count = NewCount;
+	bRibbonDirty = true;
+}
+
+void FVisMeshTimeSeriesSceneProxy::UpdateChannelColors_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FColor>& InChannelColors)
+{
+	if (ColorBuffer == nullptr || InChannelColors.Num() != NumChannels)
+	{
+		return;
+	}
+
+	// 同一通道的所有顶点颜色相同
+	TArray<FColor> Colors;
+	Colors.SetNumUninitialized(NumChannels * Capacity * 2);
+	for (int32 Channel = 0; Channel < NumChannels; Channel++)
+	{
+		for (int32 V = 0; V < Capacity * 2; V++)
+		{
+			Colors[Channel * Capacity * 2 + V] = InChannelColors[Channel];
+		}
+	}
+	ColorBuffer->Update(RHICmdList, 0, Colors.GetData(), Colors.Num());
+}
+
+void FVisMeshTimeSeriesSceneProxy::DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily)
+{
+	if (VertexFactory == nullptr || !bRibbonDirty)
+	{
+		return;
+	}
+
+	AddTimeSeriesRibbonPass(GraphBuilder, SampleBuffer->GetSRV(), PositionBuffer->GetUAV(), TangentBuffer->GetUAV(),
+		NumChannels, Capacity, Head, Count, SampleSpacing, ChannelSpacing, ValueScale, LineWidth);
+
+	bRibbonDirty = false;
+}
+
+void FVisMeshTimeSeriesSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const
+{
+	if (VertexFactory == nullptr || IndexBuffer == nullptr)
+	{
+		return;
+	}
+
+	// Set up wireframe material (if needed)
+	const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+	FColoredMaterialRenderProxy* WireframeMaterialInstance = nullptr;
+	if (bWireframe)
+	{
+		WireframeMaterialInstance = new FColoredMaterialRenderProxy(GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : NULL, FLinearColor(0, 0.5f, 1.f));
+		Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+	}
+
+	FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Material->GetRenderProxy();
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			FMeshBatch& Mesh = Collector.AllocateMesh();
+			FMeshBatchElement& BatchElement = Mesh.Elements[0];
+			BatchElement.IndexBuffer = IndexBuffer;
+			Mesh.bWireframe = bWireframe;
+			Mesh.VertexFactory = VertexFactory;
+			Mesh.MaterialRenderProxy = MaterialProxy;
+
+			bool bHasPrecomputedVolumetricLightmap;
+			FMatrix PreviousLocalToWorld;
+			int32 SingleCaptureIndex;
+			bool bOutputVelocity;
+			GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
+			bOutputVelocity |= AlwaysHasVelocity();
+
+			FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+			DynamicPrimitiveUniformBuffer.Set(GetLocalToWorld(), PreviousLocalToWorld, GetBounds(),
+			                                  GetLocalBounds(), GetLocalBounds(), ReceivesDecals(),
+			                                  bHasPrecomputedVolumetricLightmap, bOutputVelocity,
+			                                  GetCustomPrimitiveData());
+			BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+
+			BatchElement.FirstIndex = 0;
+			BatchElement.NumPrimitives = IndexBuffer->Indices.Num() / 3;
+			BatchElement.MinVertexIndex = 0;
+			BatchElement.MaxVertexIndex = NumChannels * Capacity * 2 - 1;
+			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+			Mesh.Type = PT_TriangleList;
+			Mesh.DepthPriorityGroup = SDPG_World;
+			Mesh.bCanApplyViewModeOverrides = false;
+			Collector.AddMesh(ViewIndex, Mesh);
+		}
+	}
+
+	// Draw bounds
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (VisibilityMap & (1 << ViewIndex))
+		{
+			RenderBounds(Collector.GetPDI(ViewIndex), ViewFamily.EngineShowFlags, GetBounds(), IsSelected());
+		}
+	}
+#endif
+}
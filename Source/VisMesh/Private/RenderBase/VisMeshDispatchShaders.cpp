@@ -8,6 +8,11 @@ IMPLEMENT_GLOBAL_SHADER(FPopulateBoxChartFrustumCulledInstanceBufferCS, "/VisMes
 IMPLEMENT_GLOBAL_SHADER(FPopulateBoxWireframeBufferCS, "/VisMeshPlugin/DispatchShaders/PopulateBoxWireframeBuffer.usf", "MainCS",SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FPopulateBoxWireframeMiterBufferCS, "/VisMeshPlugin/DispatchShaders/PopulateBoxWireframeBuffer_Miter.usf", "MainCS",SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FGenerateScatterPlotSphereCS, "/VisMeshPlugin/DispatchShaders/GenerateScatterPlotSpheres.usf", "MainCS",SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FPopulateBarChartInstanceBufferCS, "/VisMeshPlugin/DispatchShaders/PopulateBarChartInstanceBuffer.usf", "MainCS",SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FVisMeshHeightfieldDisplaceCS, "/VisMeshPlugin/DispatchShaders/HeightfieldDisplace.usf", "MainCS",SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FVisMeshTimeSeriesRibbonCS, "/VisMeshPlugin/DispatchShaders/UpdateTimeSeriesRibbon.usf", "MainCS",SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FPopulateScatterPointInstanceBufferCS, "/VisMeshPlugin/DispatchShaders/PopulateScatterPointInstanceBuffer.usf", "MainCS",SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FVisMeshPolylineExpandCS, "/VisMeshPlugin/DispatchShaders/ExpandPolylineMiter.usf", "MainCS",SF_Compute);
 
 void FPopulateVertexAndIndirectBufferCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
 {
@@ -45,3 +50,33 @@ void FGenerateScatterPlotSphereCS::ModifyCompilationEnvironment(const FGlobalSha
 	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
 	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
 }
+
+void FPopulateBarChartInstanceBufferCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
+}
+
+void FVisMeshHeightfieldDisplaceCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
+}
+
+void FVisMeshTimeSeriesRibbonCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
+}
+
+void FPopulateScatterPointInstanceBufferCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
+}
+
+void FVisMeshPolylineExpandCS::ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+{
+	FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	OutEnvironment.SetDefine(TEXT("THREAD_COUNT"), ThreadGroupSize);
+}
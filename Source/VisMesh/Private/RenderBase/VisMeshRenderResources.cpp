@@ -1,5 +1,40 @@
 #include "RenderBase/VisMeshRenderResources.h"
 
+TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> FVisMeshSharedIndices::Create(TArray<int32>&& InIndices)
+{
+	return TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe>(new FVisMeshSharedIndices(MoveTemp(InIndices)), [](FVisMeshSharedIndices* SharedIndices)
+	{
+		// 最后一个引用可能在游戏线程 (FVisMeshData) 或渲染线程 (Proxy) 上释放
+		ENQUEUE_RENDER_COMMAND(ReleaseVisMeshSharedIndices)([SharedIndices](FRHICommandListImmediate& RHICmdList)
+		{
+			SharedIndices->ReleaseResource();
+			delete SharedIndices;
+		});
+	});
+}
+
+void FVisMeshSharedIndices::BeginInitOnce()
+{
+	if (!bInitRequested.exchange(true))
+	{
+		BeginInitResource(this);
+	}
+}
+
+void FVisMeshSharedIndices::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	if (Indices.Num() > 0)
+	{
+		const uint32 Size = Indices.Num() * sizeof(uint32);
+		FRHIResourceCreateInfo CreateInfo(TEXT("VisMeshSharedIndexBuffer"));
+		IndexBufferRHI = RHICmdList.CreateIndexBuffer(sizeof(uint32), Size, BUF_Static, CreateInfo);
+
+		void* BufferData = RHICmdList.LockBuffer(IndexBufferRHI, 0, Size, RLM_WriteOnly);
+		FMemory::Memcpy(BufferData, Indices.GetData(), Size);
+		RHICmdList.UnlockBuffer(IndexBufferRHI);
+	}
+}
+
 const TCHAR* FPositionUAVVertexBuffer::GetName() const
 {
 	return TEXT("PositionUAVVertexBuffer");
@@ -80,6 +115,133 @@ void FPositionUAVVertexBuffer::ReleaseRHI()
 }
 
 
+void FVisMeshTypedVertexBuffer::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	const uint32 Size = NumElements * GetElementSize();
+	if (Size == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("VisMeshTypedVertexBuffer"));
+	EBufferUsageFlags Usage = EBufferUsageFlags::VertexBuffer | EBufferUsageFlags::ShaderResource | EBufferUsageFlags::Static;
+	if (bUnorderedAccess)
+	{
+		Usage |= EBufferUsageFlags::UnorderedAccess;
+	}
+
+	VertexBufferRHI = RHICmdList.CreateVertexBuffer(Size, Usage, CreateInfo);
+
+	if (VertexBufferRHI)
+	{
+		SRV = RHICmdList.CreateShaderResourceView(
+			VertexBufferRHI,
+			FRHIViewDesc::CreateBufferSRV()
+			.SetType(FRHIViewDesc::EBufferType::Typed)
+			.SetFormat(Format));
+
+		if (bUnorderedAccess)
+		{
+			UAV = RHICmdList.CreateUnorderedAccessView(
+				VertexBufferRHI,
+				FRHIViewDesc::CreateBufferUAV()
+				.SetType(FRHIViewDesc::EBufferType::Typed)
+				.SetFormat(Format));
+		}
+	}
+}
+
+void FVisMeshTypedVertexBuffer::ReleaseRHI()
+{
+	UAV.SafeRelease();
+	SRV.SafeRelease();
+	FVertexBuffer::ReleaseRHI();
+}
+
+void FVisMeshTypedVertexBuffer::Update(FRHICommandListBase& RHICmdList, int32 FirstElement, const void* Data, int32 Num)
+{
+	if (!VertexBufferRHI || Num <= 0 || FirstElement < 0 || FirstElement + Num > NumElements)
+	{
+		return;
+	}
+
+	// Static Buffer 的部分 Lock 只会覆盖这一段，其余内容保持不变
+	const uint32 Size = Num * GetElementSize();
+	void* BufferData = RHICmdList.LockBuffer(VertexBufferRHI, FirstElement * GetElementSize(), Size, RLM_WriteOnly);
+	FMemory::Memcpy(BufferData, Data, Size);
+	RHICmdList.UnlockBuffer(VertexBufferRHI);
+}
+
+void FVisMeshStructuredBuffer::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	const uint32 Size = NumElements * Stride;
+	if (Size == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("VisMeshStructuredBuffer"));
+	const EBufferUsageFlags Usage = EBufferUsageFlags::StructuredBuffer | EBufferUsageFlags::ShaderResource | EBufferUsageFlags::Static;
+
+	BufferRHI = RHICmdList.CreateBuffer(Size, Usage, Stride, ERHIAccess::SRVMask, CreateInfo);
+
+	if (BufferRHI)
+	{
+		SRV = RHICmdList.CreateShaderResourceView(
+			BufferRHI,
+			FRHIViewDesc::CreateBufferSRV()
+			.SetTypeFromBuffer(BufferRHI));
+	}
+}
+
+void FVisMeshStructuredBuffer::ReleaseRHI()
+{
+	SRV.SafeRelease();
+	BufferRHI.SafeRelease();
+}
+
+void FVisMeshStructuredBuffer::Update(FRHICommandListBase& RHICmdList, int32 FirstElement, const void* Data, int32 Num)
+{
+	if (!BufferRHI || Num <= 0 || FirstElement < 0 || FirstElement + Num > NumElements)
+	{
+		return;
+	}
+
+	const uint32 Size = Num * Stride;
+	void* BufferData = RHICmdList.LockBuffer(BufferRHI, FirstElement * Stride, Size, RLM_WriteOnly);
+	FMemory::Memcpy(BufferData, Data, Size);
+	RHICmdList.UnlockBuffer(BufferRHI);
+}
+
+void FVisMeshRWIndexBuffer::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	const uint32 Size = NumIndices * sizeof(uint32);
+	if (Size == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("VisMeshRWIndexBuffer"));
+	const EBufferUsageFlags Usage = EBufferUsageFlags::UnorderedAccess | EBufferUsageFlags::ShaderResource | EBufferUsageFlags::Static;
+
+	IndexBufferRHI = RHICmdList.CreateIndexBuffer(sizeof(uint32), Size, Usage, CreateInfo);
+
+	if (IndexBufferRHI)
+	{
+		UAV = RHICmdList.CreateUnorderedAccessView(
+			IndexBufferRHI,
+			FRHIViewDesc::CreateBufferUAV()
+			.SetType(FRHIViewDesc::EBufferType::Typed)
+			.SetFormat(PF_R32_UINT));
+	}
+}
+
+void FVisMeshRWIndexBuffer::ReleaseRHI()
+{
+	UAV.SafeRelease();
+	FIndexBuffer::ReleaseRHI();
+}
+
 void FVisMeshSubBuffer::InitRHI(FRHICommandListBase& RHICmdList)
 {
 	const uint32 Stride = Vector4CountPerInstance * sizeof(FVector4f);
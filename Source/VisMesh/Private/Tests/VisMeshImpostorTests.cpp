@@ -0,0 +1,81 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Utils/VisMeshUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVisMeshSphereImpostorTest, "VisMesh.Utils.ExpandSphereImpostor",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FVisMeshSphereImpostorTest::RunTest(const FString& Parameters)
+{
+	struct FCase
+	{
+		FVector3f Center;
+		float Radius;
+		FVector3f Camera;
+	};
+	const FCase Cases[] =
+	{
+		{ FVector3f(0.f, 0.f, 0.f), 1.f, FVector3f(-10.f, 0.f, 0.f) },
+		{ FVector3f(100.f, -50.f, 20.f), 25.f, FVector3f(-300.f, 400.f, 250.f) },
+		// 视线与 Z 轴平行：Right 退化，使用备用轴
+		{ FVector3f(5.f, 5.f, 0.f), 2.f, FVector3f(5.f, 5.f, 40.f) },
+		// 相机贴近球面：四边形很小但仍与轮廓相切
+		{ FVector3f(0.f, 0.f, 0.f), 10.f, FVector3f(0.f, 10.5f, 0.f) },
+	};
+
+	for (const FCase& Case : Cases)
+	{
+		FVector3f Rows[3];
+		FVector3f Corners[4];
+		if (!TestTrue(TEXT("Camera outside the sphere expands"), VisMeshExpandSphereImpostor(Case.Center, Case.Radius, Case.Camera, Rows, Corners)))
+		{
+			continue;
+		}
+
+		const FVector3f ToCenter = Case.Center - Case.Camera;
+		const float Distance = ToCenter.Size();
+		const FVector3f Forward = ToCenter / Distance;
+		const float Tolerance = 1e-4f * FMath::Max(Distance, 1.f);
+
+		// 1. 四边形位于球面最前端的平面上，并且正对相机
+		for (int32 Corner = 0; Corner < 4; Corner++)
+		{
+			TestEqual(TEXT("Corner lies on the front plane"), FVector3f::DotProduct(Corners[Corner] - Case.Camera, Forward), Distance - Case.Radius, Tolerance);
+		}
+		TestEqual(TEXT("Right is perpendicular to the view ray"), FVector3f::DotProduct(Rows[0], Forward), 0.f, Tolerance);
+		TestEqual(TEXT("Up is perpendicular to the view ray"), FVector3f::DotProduct(Rows[1], Forward), 0.f, Tolerance);
+		TestEqual(TEXT("Right is perpendicular to Up"), FVector3f::DotProduct(Rows[0], Rows[1]), 0.f, Tolerance);
+
+		// 2. 过各边中点的视线与球相切 (到球心的距离等于半径)：四边形的内切圆就是轮廓在该平面上的截面
+		const int32 Edges[4][2] = { { 0, 1 }, { 1, 3 }, { 3, 2 }, { 2, 0 } };
+		for (const int32 (&Edge)[2] : Edges)
+		{
+			const FVector3f Midpoint = (Corners[Edge[0]] + Corners[Edge[1]]) * 0.5f;
+			const FVector3f RayDir = (Midpoint - Case.Camera).GetSafeNormal();
+			const float RayDistance = FVector3f::CrossProduct(ToCenter, RayDir).Size();
+			TestEqual(TEXT("Edge midpoint ray is tangent to the sphere"), RayDistance, Case.Radius, Tolerance);
+		}
+
+		// 3. 过各角点的视线不与球相交，即四边形完整覆盖球的轮廓
+		for (int32 Corner = 0; Corner < 4; Corner++)
+		{
+			const FVector3f RayDir = (Corners[Corner] - Case.Camera).GetSafeNormal();
+			const float RayDistance = FVector3f::CrossProduct(ToCenter, RayDir).Size();
+			TestTrue(TEXT("Corner ray misses the sphere"), RayDistance > Case.Radius);
+		}
+	}
+
+	// 4. 相机在球内或球面上时不绘制
+	FVector3f Rows[3];
+	FVector3f Corners[4];
+	TestFalse(TEXT("Camera at the centre is rejected"), VisMeshExpandSphereImpostor(FVector3f::ZeroVector, 5.f, FVector3f::ZeroVector, Rows, Corners));
+	TestFalse(TEXT("Camera inside the sphere is rejected"), VisMeshExpandSphereImpostor(FVector3f(10.f, 0.f, 0.f), 5.f, FVector3f(12.f, 1.f, -1.f), Rows, Corners));
+	TestFalse(TEXT("Camera on the sphere is rejected"), VisMeshExpandSphereImpostor(FVector3f::ZeroVector, 5.f, FVector3f(0.f, 0.f, 5.f), Rows, Corners));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
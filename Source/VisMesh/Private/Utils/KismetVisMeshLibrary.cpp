@@ -7,11 +7,17 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/VisMeshProceduralComponent.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
 #include "Logging/MessageLog.h"
 #include "Materials/MaterialInterface.h"
 #include "Misc/UObjectToken.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "UObject/StrongObjectPtr.h"
 #include "RenderBase/VisMeshRenderResources.h"
+#include "Utils/VisMeshUtils.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(KismetVisMeshLibrary)
 
@@ -198,23 +204,150 @@ void UKismetVisMeshLibrary::GenerateBoxMesh(FVector BoxRadius, TArray<FVector>&
 	UVs[3] = UVs[7] = UVs[11] = UVs[15] = UVs[19] = UVs[23] = FVector2D(1.f, 0.f);
 }
 
-void VisMeshFindVertOverlaps(int32 TestVertIndex, const TArray<FVector>& Verts, TArray<int32>& VertOverlaps)
+/**
+ *	空间哈希查找位置重合的顶点 (UV 接缝处被拆分的顶点)
+ *	OutWeldRep[i] 为顶点 i 所在重合组的代表顶点 (组内最小下标)，判定与 FVector::Equals 相同 (逐分量容差)
+ */
+void VisMeshWeldOverlappingVerts(const TArray<FVector>& Verts, TArray<int32>& OutWeldRep, double Tolerance = UE_KINDA_SMALL_NUMBER)
 {
-	// Check if Verts is empty or test is outside range
-	if (TestVertIndex < Verts.Num())
+	const int32 NumVerts = Verts.Num();
+	OutWeldRep.SetNumUninitialized(NumVerts);
+
+	// 格子边长取 4 倍容差：绝大多数顶点只需查询自身所在的格子，
+	// 只有距离格子边界小于容差的分量才需要额外查询相邻格子
+	const double CellSize = FMath::Max(Tolerance * 4.0, UE_DOUBLE_SMALL_NUMBER);
+	const double InvCellSize = 1.0 / CellSize;
+
+	auto CellHash = [](int64 X, int64 Y, int64 Z)
+	{
+		return HashCombineFast(HashCombineFast(GetTypeHash(X), GetTypeHash(Y)), GetTypeHash(Z));
+	};
+
+	// 格子 -> 链表头，链表存在扁平数组 NextInCell 中；哈希冲突只会多比较几次，不会误判
+	TMap<uint32, int32> CellHeads;
+	CellHeads.Reserve(NumVerts);
+	TArray<int32> NextInCell;
+	NextInCell.SetNumUninitialized(NumVerts);
+
+	for (int32 VertIdx = 0; VertIdx < NumVerts; VertIdx++)
 	{
-		const FVector TestVert = Verts[TestVertIndex];
+		const FVector& P = Verts[VertIdx];
+
+		int64 Cell[3];
+		int32 Lo[3], Hi[3];
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const double Scaled = P[Axis] * InvCellSize;
+			Cell[Axis] = FMath::FloorToInt64(Scaled);
+			const double Offset = (Scaled - Cell[Axis]) * CellSize;
+			Lo[Axis] = Offset <= Tolerance ? -1 : 0;
+			Hi[Axis] = CellSize - Offset <= Tolerance ? 1 : 0;
+		}
 
-		for (int32 VertIdx = 0; VertIdx < Verts.Num(); VertIdx++)
+		int32 Rep = VertIdx;
+		for (int32 DX = Lo[0]; DX <= Hi[0] && Rep == VertIdx; DX++)
+		for (int32 DY = Lo[1]; DY <= Hi[1] && Rep == VertIdx; DY++)
+		for (int32 DZ = Lo[2]; DZ <= Hi[2] && Rep == VertIdx; DZ++)
 		{
-			// First see if we overlap, and smoothing groups are the same
-			if (TestVert.Equals(Verts[VertIdx]))
+			if (const int32* Head = CellHeads.Find(CellHash(Cell[0] + DX, Cell[1] + DY, Cell[2] + DZ)))
 			{
-				// If it, so we are at least considered an 'overlap' for normal gen
-				VertOverlaps.Add(VertIdx);
+				for (int32 Other = *Head; Other != INDEX_NONE; Other = NextInCell[Other])
+				{
+					if (P.Equals(Verts[Other], Tolerance))
+					{
+						Rep = OutWeldRep[Other];
+						break;
+					}
+				}
 			}
 		}
+		OutWeldRep[VertIdx] = Rep;
+
+		// 只有组代表需要入表，其余顶点总能通过代表找到
+		if (Rep == VertIdx)
+		{
+			int32& Head = CellHeads.FindOrAdd(CellHash(Cell[0], Cell[1], Cell[2]), INDEX_NONE);
+			NextInCell[VertIdx] = Head;
+			Head = VertIdx;
+		}
+	}
+}
+
+/**
+ *	构建 CSR 邻接表：Key -> 三角形角点 (TriIdx * 3 + CornerIdx)
+ *	VertKeys 为空时 Key 即顶点下标，否则 Key = VertKeys[顶点下标]；同一三角形中相同 Key 的角点只记录一次
+ */
+void VisMeshBuildCornerAdjacency(const TArray<int32>& Triangles, int32 NumVerts, const int32* VertKeys, TArray<int32>& OutOffsets, TArray<int32>& OutCorners)
+{
+	const int32 NumTris = Triangles.Num() / 3;
+
+	auto GetKey = [&](int32 Corner)
+	{
+		const int32 VertIdx = FMath::Clamp(Triangles[Corner], 0, NumVerts - 1);
+		return VertKeys ? VertKeys[VertIdx] : VertIdx;
+	};
+	auto IsFirstCornerWithKey = [&](int32 TriIdx, int32 CornerIdx, int32 Key)
+	{
+		for (int32 Prev = 0; Prev < CornerIdx; Prev++)
+		{
+			if (GetKey(TriIdx * 3 + Prev) == Key) return false;
+		}
+		return true;
+	};
+
+	// 1. 计数
+	OutOffsets.Reset();
+	OutOffsets.SetNumZeroed(NumVerts + 1);
+	for (int32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	{
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			const int32 Key = GetKey(TriIdx * 3 + CornerIdx);
+			if (IsFirstCornerWithKey(TriIdx, CornerIdx, Key)) OutOffsets[Key + 1]++;
+		}
+	}
+
+	// 2. 前缀和
+	for (int32 Key = 0; Key < NumVerts; Key++)
+	{
+		OutOffsets[Key + 1] += OutOffsets[Key];
+	}
+
+	// 3. 填充
+	OutCorners.SetNumUninitialized(OutOffsets[NumVerts]);
+	TArray<int32> Cursor(OutOffsets.GetData(), NumVerts);
+	for (int32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	{
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			const int32 Key = GetKey(TriIdx * 3 + CornerIdx);
+			if (IsFirstCornerWithKey(TriIdx, CornerIdx, Key)) OutCorners[Cursor[Key]++] = TriIdx * 3 + CornerIdx;
+		}
+	}
+}
+
+/**
+ *	由三角形三个顶点和 UV 求 dP/dU、dP/dV (未归一化)
+ *	等价于 ParameterToTexture.Inverse() * ParameterToLocal，UV 退化时与原实现一致退回到两条边
+ */
+static void VisMeshComputeFaceTangentBasis(const FVector3f P[3], const FVector2f T[3], FVector3f& OutTangentX, FVector3f& OutTangentY)
+{
+	const FVector3f Edge1 = P[1] - P[0];
+	const FVector3f Edge2 = P[2] - P[0];
+	const FVector2f DUV1 = T[1] - T[0];
+	const FVector2f DUV2 = T[2] - T[0];
+
+	const float Det = DUV1.X * DUV2.Y - DUV2.X * DUV1.Y;
+	if (Det == 0.f)
+	{
+		OutTangentX = Edge1;
+		OutTangentY = Edge2;
+		return;
 	}
+
+	const float InvDet = 1.f / Det;
+	OutTangentX = (Edge1 * DUV2.Y - Edge2 * DUV1.Y) * InvDet;
+	OutTangentY = (Edge2 * DUV1.X - Edge1 * DUV2.X) * InvDet;
 }
 
 void UKismetVisMeshLibrary::CalculateTangentsForMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles,const TArray<FVector2D>& UVs, TArray<FVector>& Normals, TArray<FVisMeshTangent>& Tangents)
@@ -229,57 +362,32 @@ void UKismetVisMeshLibrary::CalculateTangentsForMesh(const TArray<FVector>& Vert
 	const int32 NumTris = Triangles.Num() / 3;
 	// Number of verts
 	const int32 NumVerts = Vertices.Num();
+	const bool bHasUVs = UVs.Num() == NumVerts;
+
+	// 1. 空间哈希找出重合顶点 (不匹配 UV 但需要共享平滑法线的顶点)
+	TArray<int32> WeldRep;
+	VisMeshWeldOverlappingVerts(Vertices, WeldRep);
 
-	// Map of vertex to triangles in Triangles array
-	TMultiMap<int32, int32> VertToTriMap;
-	// Map of vertex to triangles to consider for normal calculation
-	TMultiMap<int32, int32> VertToTriSmoothMap;
+	// 2. CSR 邻接：顶点 -> 直接引用它的三角形
+	TArray<int32> VertCornerOffsets, VertCorners;
+	VisMeshBuildCornerAdjacency(Triangles, NumVerts, nullptr, VertCornerOffsets, VertCorners);
 
-	// Normal/tangents for each face
+	// 3. 每个面的 Normal/Tangent (并行)
 	TArray<FVector3f> FaceTangentX, FaceTangentY, FaceTangentZ;
-	FaceTangentX.AddUninitialized(NumTris);
-	FaceTangentY.AddUninitialized(NumTris);
-	FaceTangentZ.AddUninitialized(NumTris);
+	FaceTangentX.SetNumUninitialized(NumTris);
+	FaceTangentY.SetNumUninitialized(NumTris);
+	FaceTangentZ.SetNumUninitialized(NumTris);
 
-	// Iterate over triangles
-	for (int TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	ParallelFor(NumTris, [&](int32 TriIdx)
 	{
-		int32 CornerIndex[3];
 		FVector3f P[3];
-
+		FVector2f T[3];
 		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
 		{
 			// Find vert index (clamped within range)
-			int32 VertIndex = FMath::Min(Triangles[(TriIdx * 3) + CornerIdx], NumVerts - 1);
-
-			CornerIndex[CornerIdx] = VertIndex;
+			const int32 VertIndex = FMath::Clamp(Triangles[(TriIdx * 3) + CornerIdx], 0, NumVerts - 1);
 			P[CornerIdx] = (FVector3f)Vertices[VertIndex];
-
-			// Find/add this vert to index buffer
-			TArray<int32> VertOverlaps;
-			VisMeshFindVertOverlaps(VertIndex, Vertices, VertOverlaps);
-
-			// Remember which triangles map to this vert
-			VertToTriMap.AddUnique(VertIndex, TriIdx);
-			VertToTriSmoothMap.AddUnique(VertIndex, TriIdx);
-
-			// Also update map of triangles that 'overlap' this vert (ie don't match UV, but do match smoothing) and should be considered when calculating normal
-			for (int32 OverlapIdx = 0; OverlapIdx < VertOverlaps.Num(); OverlapIdx++)
-			{
-				// For each vert we overlap..
-				int32 OverlapVertIdx = VertOverlaps[OverlapIdx];
-
-				// Add this triangle to that vert
-				VertToTriSmoothMap.AddUnique(OverlapVertIdx, TriIdx);
-
-				// And add all of its triangles to us
-				TArray<int32> OverlapTris;
-				VertToTriMap.MultiFind(OverlapVertIdx, OverlapTris);
-				for (int32 OverlapTriIdx = 0; OverlapTriIdx < OverlapTris.Num(); OverlapTriIdx++)
-				{
-					VertToTriSmoothMap.AddUnique(VertIndex, OverlapTris[OverlapTriIdx]);
-				}
-			}
+			T[CornerIdx] = bHasUVs ? (FVector2f)UVs[VertIndex] : FVector2f::ZeroVector;
 		}
 
 		// Calculate triangle edge vectors and normal
@@ -288,31 +396,12 @@ void UKismetVisMeshLibrary::CalculateTangentsForMesh(const TArray<FVector>& Vert
 		const FVector3f TriNormal = (Edge21 ^ Edge20).GetSafeNormal();
 
 		// If we have UVs, use those to calc 
-		if (UVs.Num() == Vertices.Num())
+		if (bHasUVs)
 		{
-			const FVector2D T1 = UVs[CornerIndex[0]];
-			const FVector2D T2 = UVs[CornerIndex[1]];
-			const FVector2D T3 = UVs[CornerIndex[2]];
-
-			FMatrix	ParameterToLocal(
-				FPlane(P[1].X - P[0].X, P[1].Y - P[0].Y, P[1].Z - P[0].Z, 0),
-				FPlane(P[2].X - P[0].X, P[2].Y - P[0].Y, P[2].Z - P[0].Z, 0),
-				FPlane(P[0].X, P[0].Y, P[0].Z, 0),
-				FPlane(0, 0, 0, 1)
-				);
-
-			FMatrix ParameterToTexture(
-				FPlane(T2.X - T1.X, T2.Y - T1.Y, 0, 0),
-				FPlane(T3.X - T1.X, T3.Y - T1.Y, 0, 0),
-				FPlane(T1.X, T1.Y, 1, 0),
-				FPlane(0, 0, 0, 1)
-				);
-
-			// Use InverseSlow to catch singular matrices.  Inverse can miss this sometimes.
-			const FMatrix TextureToLocal = ParameterToTexture.Inverse() * ParameterToLocal;
-
-			FaceTangentX[TriIdx] = FVector4f(TextureToLocal.TransformVector(FVector(1, 0, 0)).GetSafeNormal());
-			FaceTangentY[TriIdx] = FVector4f(TextureToLocal.TransformVector(FVector(0, 1, 0)).GetSafeNormal());
+			FVector3f TangentX, TangentY;
+			VisMeshComputeFaceTangentBasis(P, T, TangentX, TangentY);
+			FaceTangentX[TriIdx] = TangentX.GetSafeNormal();
+			FaceTangentY[TriIdx] = TangentY.GetSafeNormal();
 		}
 		else
 		{
@@ -321,53 +410,49 @@ void UKismetVisMeshLibrary::CalculateTangentsForMesh(const TArray<FVector>& Vert
 		}
 
 		FaceTangentZ[TriIdx] = TriNormal;
-	}
+	});
 
+	// 4. 每个顶点累加直接相邻面的切线与法线 (并行 gather，无需原子操作)
+	TArray<FVector3f> VertexTangentXSum, VertexTangentYSum, VertexNormalSum;
+	VertexTangentXSum.SetNumUninitialized(NumVerts);
+	VertexTangentYSum.SetNumUninitialized(NumVerts);
+	VertexNormalSum.SetNumUninitialized(NumVerts);
 
-	// Arrays to accumulate tangents into
-	TArray<FVector3f> VertexTangentXSum, VertexTangentYSum, VertexTangentZSum;
-	VertexTangentXSum.AddZeroed(NumVerts);
-	VertexTangentYSum.AddZeroed(NumVerts);
-	VertexTangentZSum.AddZeroed(NumVerts);
-
-	// For each vertex..
-	for (int VertxIdx = 0; VertxIdx < Vertices.Num(); VertxIdx++)
+	ParallelFor(NumVerts, [&](int32 VertIdx)
 	{
-		// Find relevant triangles for normal
-		TArray<int32> SmoothTris;
-		VertToTriSmoothMap.MultiFind(VertxIdx, SmoothTris);
-
-		for (int i = 0; i < SmoothTris.Num(); i++)
-		{
-			int32 TriIdx = SmoothTris[i];
-			VertexTangentZSum[VertxIdx] += FaceTangentZ[TriIdx];
-		}
-
-		// Find relevant triangles for tangents
-		TArray<int32> TangentTris;
-		VertToTriMap.MultiFind(VertxIdx, TangentTris);
-
-		for (int i = 0; i < TangentTris.Num(); i++)
+		FVector3f SumX = FVector3f::ZeroVector, SumY = FVector3f::ZeroVector, SumZ = FVector3f::ZeroVector;
+		for (int32 Adj = VertCornerOffsets[VertIdx]; Adj < VertCornerOffsets[VertIdx + 1]; Adj++)
 		{
-			int32 TriIdx = TangentTris[i];
-			VertexTangentXSum[VertxIdx] += FaceTangentX[TriIdx];
-			VertexTangentYSum[VertxIdx] += FaceTangentY[TriIdx];
+			const int32 TriIdx = VertCorners[Adj] / 3;
+			SumX += FaceTangentX[TriIdx];
+			SumY += FaceTangentY[TriIdx];
+			SumZ += FaceTangentZ[TriIdx];
 		}
+		VertexTangentXSum[VertIdx] = SumX;
+		VertexTangentYSum[VertIdx] = SumY;
+		VertexNormalSum[VertIdx] = SumZ;
+	});
+
+	// 5. 法线在重合顶点组内共享：先归约到组代表
+	TArray<FVector3f> GroupNormalSum;
+	GroupNormalSum.SetNumZeroed(NumVerts);
+	for (int32 VertIdx = 0; VertIdx < NumVerts; VertIdx++)
+	{
+		GroupNormalSum[WeldRep[VertIdx]] += VertexNormalSum[VertIdx];
 	}
 
-	// Finally, normalize tangents and build output arrays
-
+	// 6. Finally, normalize tangents and build output arrays (并行)
 	Normals.Reset();
 	Normals.AddUninitialized(NumVerts);
 
 	Tangents.Reset();
 	Tangents.AddUninitialized(NumVerts);
 
-	for (int VertxIdx = 0; VertxIdx < NumVerts; VertxIdx++)
+	ParallelFor(NumVerts, [&](int32 VertxIdx)
 	{
-		FVector3f& TangentX = VertexTangentXSum[VertxIdx];
-		FVector3f& TangentY = VertexTangentYSum[VertxIdx];
-		FVector3f& TangentZ = VertexTangentZSum[VertxIdx];
+		FVector3f TangentX = VertexTangentXSum[VertxIdx];
+		const FVector3f& TangentY = VertexTangentYSum[VertxIdx];
+		FVector3f TangentZ = GroupNormalSum[WeldRep[VertxIdx]];
 
 		TangentX.Normalize();
 		TangentZ.Normalize();
@@ -382,7 +467,131 @@ void UKismetVisMeshLibrary::CalculateTangentsForMesh(const TArray<FVector>& Vert
 		const bool bFlipBitangent = ((TangentZ ^ TangentX) | TangentY) < 0.f;
 
 		Tangents[VertxIdx] = FVisMeshTangent((FVector)TangentX, bFlipBitangent);
+	});
+}
+
+void UKismetVisMeshLibrary::CalculateTangentsForMeshData(FVisMeshData& MeshData, float SmoothingAngle)
+{
+	const int32 NumVerts = MeshData.NumVertices();
+	if (NumVerts == 0)
+	{
+		return;
 	}
+
+	const TArray<FVector>& Positions = MeshData.Positions;
+	const TArray<int32>& Triangles = MeshData.GetTriangles();
+	const int32 NumTris = Triangles.Num() / 3;
+	const bool bHasUVs = MeshData.UV0.Num() == NumVerts;
+	const bool bSmoothAll = SmoothingAngle >= 180.f;
+	const float CosThreshold = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(SmoothingAngle, 0.f, 180.f)));
+
+	auto GetCornerVert = [&](int32 Corner) { return FMath::Clamp(Triangles[Corner], 0, NumVerts - 1); };
+
+	// 1. 重合顶点分组 + 两张 CSR 邻接表 (顶点 -> 角点，重合组 -> 角点)
+	TArray<int32> WeldRep;
+	VisMeshWeldOverlappingVerts(Positions, WeldRep);
+
+	TArray<int32> VertCornerOffsets, VertCorners;
+	VisMeshBuildCornerAdjacency(Triangles, NumVerts, nullptr, VertCornerOffsets, VertCorners);
+
+	TArray<int32> GroupCornerOffsets, GroupCorners;
+	VisMeshBuildCornerAdjacency(Triangles, NumVerts, WeldRep.GetData(), GroupCornerOffsets, GroupCorners);
+
+	// 2. 面数据 (并行)：单位法线、未归一化的 dP/dU 和 dP/dV、每个角点的内角 (MikkTSpace 权重)
+	TArray<FVector3f> FaceNormal, FaceTangent, FaceBitangent;
+	TArray<float> CornerAngle;
+	FaceNormal.SetNumUninitialized(NumTris);
+	FaceTangent.SetNumUninitialized(NumTris);
+	FaceBitangent.SetNumUninitialized(NumTris);
+	CornerAngle.SetNumUninitialized(NumTris * 3);
+
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		FVector3f P[3];
+		FVector2f T[3];
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			const int32 VertIdx = GetCornerVert(TriIdx * 3 + CornerIdx);
+			P[CornerIdx] = (FVector3f)Positions[VertIdx];
+			T[CornerIdx] = bHasUVs ? (FVector2f)MeshData.UV0[VertIdx] : FVector2f::ZeroVector;
+		}
+
+		const FVector3f Normal = ((P[1] - P[2]) ^ (P[0] - P[2])).GetSafeNormal();
+		FaceNormal[TriIdx] = Normal;
+
+		if (bHasUVs)
+		{
+			VisMeshComputeFaceTangentBasis(P, T, FaceTangent[TriIdx], FaceBitangent[TriIdx]);
+		}
+		else
+		{
+			FaceTangent[TriIdx] = P[0] - P[2];
+			FaceBitangent[TriIdx] = FaceTangent[TriIdx] ^ Normal;
+		}
+
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			const FVector3f ToNext = (P[(CornerIdx + 1) % 3] - P[CornerIdx]).GetSafeNormal();
+			const FVector3f ToPrev = (P[(CornerIdx + 2) % 3] - P[CornerIdx]).GetSafeNormal();
+			CornerAngle[TriIdx * 3 + CornerIdx] = FMath::Acos(FMath::Clamp(ToNext | ToPrev, -1.f, 1.f));
+		}
+	});
+
+	// 3. 顶点 (并行)：直接写入 SOA 的 Normals / Tangents
+	MeshData.Normals.SetNumUninitialized(NumVerts);
+	MeshData.Tangents.SetNumUninitialized(NumVerts);
+
+	ParallelFor(NumVerts, [&](int32 VertIdx)
+	{
+		// 3.1 参考法线：顶点自身所在面的角度加权法线
+		FVector3f RefNormal = FVector3f::ZeroVector;
+		for (int32 Adj = VertCornerOffsets[VertIdx]; Adj < VertCornerOffsets[VertIdx + 1]; Adj++)
+		{
+			const int32 Corner = VertCorners[Adj];
+			RefNormal += FaceNormal[Corner / 3] * CornerAngle[Corner];
+		}
+		RefNormal.Normalize();
+
+		// 3.2 平滑法线：重合组内与参考法线夹角不超过阈值的面
+		FVector3f Normal = FVector3f::ZeroVector;
+		for (int32 Adj = GroupCornerOffsets[WeldRep[VertIdx]]; Adj < GroupCornerOffsets[WeldRep[VertIdx] + 1]; Adj++)
+		{
+			const int32 Corner = GroupCorners[Adj];
+			const FVector3f& N = FaceNormal[Corner / 3];
+			if (bSmoothAll || GetCornerVert(Corner) == VertIdx || (N | RefNormal) >= CosThreshold)
+			{
+				Normal += N * CornerAngle[Corner];
+			}
+		}
+		if (!Normal.Normalize())
+		{
+			Normal = FVector3f(0, 0, 1);
+		}
+
+		// 3.3 切线：面切线投影到法线平面、归一化后按角度加权 (MikkTSpace)
+		FVector3f Tangent = FVector3f::ZeroVector;
+		FVector3f Bitangent = FVector3f::ZeroVector;
+		for (int32 Adj = VertCornerOffsets[VertIdx]; Adj < VertCornerOffsets[VertIdx + 1]; Adj++)
+		{
+			const int32 Corner = VertCorners[Adj];
+			const FVector3f& FT = FaceTangent[Corner / 3];
+			const FVector3f& FB = FaceBitangent[Corner / 3];
+			Tangent += (FT - Normal * (Normal | FT)).GetSafeNormal() * CornerAngle[Corner];
+			Bitangent += (FB - Normal * (Normal | FB)).GetSafeNormal() * CornerAngle[Corner];
+		}
+		if (!Tangent.Normalize())
+		{
+			// 没有有效 UV 方向时任取一个垂直于法线的方向
+			FVector3f AxisY;
+			Normal.FindBestAxisVectors(Tangent, AxisY);
+		}
+
+		// 副切线符号：与 Shader 中 TangentY = cross(Z, X) * Sign 的约定一致
+		const bool bFlipBitangent = ((Normal ^ Tangent) | Bitangent) < 0.f;
+
+		MeshData.Normals[VertIdx] = (FVector)Normal;
+		MeshData.Tangents[VertIdx] = FVisMeshTangent((FVector)Tangent, bFlipBitangent);
+	});
 }
 
 void UKismetVisMeshLibrary::ConvertQuadToTriangles(TArray<int32>& Triangles, int32 Vert0, int32 Vert1, int32 Vert2,
@@ -399,193 +608,282 @@ void UKismetVisMeshLibrary::ConvertQuadToTriangles(TArray<int32>& Triangles, int
 
 void UKismetVisMeshLibrary::CreateGridMeshTriangles(int32 NumX, int32 NumY, bool bWinding, TArray<int32>& Triangles)
 {
-	Triangles.Reset();
+	VisMeshCopyGridIndices(NumX, NumY, bWinding ? EVisMeshGridIndexLayout::Triangles : EVisMeshGridIndexLayout::TrianglesReversed, Triangles);
+}
+
+/** 写入 CreateGridMeshWelded 排布的顶点 (不含索引) */
+static void VisMeshWriteGridWeldedVertices(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing)
+{
+	OutData.Reset();
 
 	if (NumX >= 2 && NumY >= 2)
 	{
-		// Build Quads
-		for (int XIdx = 0; XIdx < NumX - 1; XIdx++)
+		const int32 NumVerts = NumX * NumY;
+		OutData.Positions.SetNumUninitialized(NumVerts);
+		OutData.Normals.SetNumUninitialized(NumVerts);
+		OutData.Tangents.SetNumUninitialized(NumVerts);
+		OutData.UV0.SetNumUninitialized(NumVerts);
+
+		FVector2D Extent = FVector2D((NumX - 1)* GridSpacing, (NumY - 1) * GridSpacing) / 2;
+
+		// 每行一个任务
+		ParallelFor(NumY, [&](int32 i)
 		{
-			for (int YIdx = 0; YIdx < NumY - 1; YIdx++)
+			for (int32 j = 0; j < NumX; j++)
 			{
-				const int32 I0 = (XIdx + 0)*NumY + (YIdx + 0);
-				const int32 I1 = (XIdx + 1)*NumY + (YIdx + 0);
-				const int32 I2 = (XIdx + 1)*NumY + (YIdx + 1);
-				const int32 I3 = (XIdx + 0)*NumY + (YIdx + 1);
-
-				if (bWinding)
-				{
-					ConvertQuadToTriangles(Triangles, I0, I1, I2, I3);
-				}
-				else
-				{
-					ConvertQuadToTriangles(Triangles, I0, I3, I2, I1);
-				}
+				const int32 VertIdx = j + i * NumX;
+				OutData.Positions[VertIdx] = FVector((float)j * GridSpacing - Extent.X, (float)i * GridSpacing - Extent.Y, 0);
+				OutData.Normals[VertIdx] = FVector(0, 0, 1);
+				OutData.Tangents[VertIdx] = FVisMeshTangent();
+				OutData.UV0[VertIdx] = FVector2D((float)j / ((float)NumX - 1), (float)i / ((float)NumY - 1));
 			}
-		}
+		});
 	}
 }
 
-void UKismetVisMeshLibrary::CreateGridMeshWelded(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, float GridSpacing)
+/** 写入 CreateGridMeshSplit 排布的顶点 (不含索引) */
+static void VisMeshWriteGridSplitVertices(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing)
 {
-	Triangles.Empty();
-	Vertices.Empty();
-	UVs.Empty();
+	OutData.Reset();
 
 	if (NumX >= 2 && NumY >= 2)
 	{
-		FVector2D Extent = FVector2D((NumX - 1)* GridSpacing, (NumY - 1) * GridSpacing) / 2;
+		const int32 NumVerts = (NumX - 1) * (NumY - 1) * 4;
+		OutData.Positions.SetNumUninitialized(NumVerts);
+		OutData.Normals.SetNumUninitialized(NumVerts);
+		OutData.Tangents.SetNumUninitialized(NumVerts);
+		OutData.UV0.SetNumUninitialized(NumVerts);
+		OutData.UV1.SetNumUninitialized(NumVerts);
 
-		for (int i = 0; i < NumY; i++)
-		{
-			for (int j = 0; j < NumX; j++)
-			{
-				Vertices.Add(FVector((float)j * GridSpacing - Extent.X, (float)i * GridSpacing - Extent.Y, 0));
-				UVs.Add(FVector2D((float)j / ((float)NumX - 1), (float)i / ((float)NumY - 1)));
-			}
-		}
+		FVector2D Extent = FVector2D(NumX * GridSpacing, NumY * GridSpacing) / 2;
 
-		for (int i = 0; i < NumY - 1; i++)
+		// 每个 Quad 4 个独立顶点，每行 Quad 一个任务
+		ParallelFor(NumY - 1, [&](int32 i)
 		{
-			for (int j = 0; j < NumX - 1; j++)
+			for (int32 j = 0; j < NumX - 1; j++)
 			{
-				int idx = j + (i * NumX);
-				Triangles.Add(idx);
-				Triangles.Add(idx + NumX);
-				Triangles.Add(idx + 1);
+				const int32 idx = j + (i * (NumX - 1));
+
+				float Z = FMath::Fmod(idx, 5.f) * GridSpacing;
+				FVector CornerVert = FVector((float)j * GridSpacing - Extent.X, (float)i * GridSpacing - Extent.Y, Z);
+				OutData.Positions[idx * 4 + 0] = CornerVert;
+				OutData.Positions[idx * 4 + 1] = CornerVert + FVector(GridSpacing, 0, 0);
+				OutData.Positions[idx * 4 + 2] = CornerVert + FVector(GridSpacing, GridSpacing, 0);
+				OutData.Positions[idx * 4 + 3] = CornerVert + FVector(0, GridSpacing, 0);
 
-				Triangles.Add(idx + 1);
-				Triangles.Add(idx + NumX);
-				Triangles.Add(idx + NumX + 1);
+				OutData.UV0[idx * 4 + 0] = FVector2D(0, 0);
+				OutData.UV0[idx * 4 + 1] = FVector2D(1, 0);
+				OutData.UV0[idx * 4 + 2] = FVector2D(1, 1);
+				OutData.UV0[idx * 4 + 3] = FVector2D(0, 1);
+
+				FVector2D QuadCenter = FVector2D(((float)j + 0.5) / ((float)NumX), ((float)i + 0.5) / ((float)NumY));
+				for (int32 Corner = 0; Corner < 4; Corner++)
+				{
+					OutData.UV1[idx * 4 + Corner] = QuadCenter;
+					OutData.Normals[idx * 4 + Corner] = FVector(0, 0, 1);
+					OutData.Tangents[idx * 4 + Corner] = FVisMeshTangent();
+				}
 			}
-		}
+		});
 	}
 }
 
+void UKismetVisMeshLibrary::CreateGridMeshWelded(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, float GridSpacing)
+{
+	FVisMeshData GridData;
+	VisMeshWriteGridWeldedVertices(NumX, NumY, GridData, GridSpacing);
+	VisMeshCopyGridIndices(NumX, NumY, EVisMeshGridIndexLayout::Welded, Triangles);
+
+	Vertices = MoveTemp(GridData.Positions);
+	UVs = MoveTemp(GridData.UV0);
+}
+
 void UKismetVisMeshLibrary::CreateGridMeshSplit(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, TArray<FVector2D>& UV1s, float GridSpacing)
 {
-	Triangles.Empty();
-	Vertices.Empty();
-	UVs.Empty();
-	UV1s.Empty();
+	FVisMeshData GridData;
+	VisMeshWriteGridSplitVertices(NumX, NumY, GridData, GridSpacing);
+	VisMeshCopyGridIndices(NumX, NumY, EVisMeshGridIndexLayout::Split, Triangles);
 
-	if (NumX >= 2 && NumY >= 2)
-	{
+	Vertices = MoveTemp(GridData.Positions);
+	UVs = MoveTemp(GridData.UV0);
+	UV1s = MoveTemp(GridData.UV1);
+}
 
-		FVector2D Extent = FVector2D(NumX * GridSpacing, NumY * GridSpacing) / 2;
+void UKismetVisMeshLibrary::CreateGridMeshWeldedData(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing)
+{
+	VisMeshWriteGridWeldedVertices(NumX, NumY, OutData, GridSpacing);
 
-		for (int i = 0; i < NumY - 1; i++)
-		{
-			for (int j = 0; j < NumX - 1; j++)
-			{
-				int idx = j + (i * (NumX - 1));
-				Triangles.Add(idx * 4 + 3);
-				Triangles.Add(idx * 4 + 1);
-				Triangles.Add(idx * 4);
+	// 索引：同尺寸网格共享同一份 CPU 数组与 GPU IndexBuffer，Triangles 保持为空
+	OutData.SharedIndices = VisMeshGetGridIndices(NumX, NumY, EVisMeshGridIndexLayout::Welded);
+}
 
-				Triangles.Add(idx * 4 + 3);
-				Triangles.Add(idx * 4 + 2);
-				Triangles.Add(idx * 4 + 1);
+void UKismetVisMeshLibrary::CreateGridMeshSplitData(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing)
+{
+	VisMeshWriteGridSplitVertices(NumX, NumY, OutData, GridSpacing);
 
-				float Z = FMath::Fmod(idx, 5.f) * GridSpacing;
-				FVector CornerVert = FVector((float)j * GridSpacing - Extent.X, (float)i * GridSpacing - Extent.Y, Z);
-				Vertices.Add(CornerVert);
-				Vertices.Add(CornerVert + FVector(GridSpacing, 0, 0));
-				Vertices.Add(CornerVert + FVector(GridSpacing, GridSpacing, 0));
-				Vertices.Add(CornerVert + FVector(0, GridSpacing, 0));
+	// 索引：同尺寸网格共享同一份 CPU 数组与 GPU IndexBuffer，Triangles 保持为空
+	OutData.SharedIndices = VisMeshGetGridIndices(NumX, NumY, EVisMeshGridIndexLayout::Split);
+}
 
-				FVector2D UVCorner = FVector2D((float)j / ((float)NumX - 1), (float)i / ((float)NumY - 1));
-				UVs.Add(FVector2D(0, 0));
-				UVs.Add(FVector2D(1, 0));
-				UVs.Add(FVector2D(1, 1));
-				UVs.Add(FVector2D(0, 1));
+/** 从 StaticMesh 顶点缓冲区读取一个顶点写入 Dest 的 DestIdx (Dest 需预先分配) */
+static void VisMeshReadStaticMeshVertex(FVisMeshData& Dest, int32 DestIdx, const FStaticMeshVertexBuffers& VertexBuffers, uint32 MeshVertIndex, int32 NumTexCoords, bool bCopyColor)
+{
+	Dest.Positions[DestIdx] = (FVector)VertexBuffers.PositionVertexBuffer.VertexPosition(MeshVertIndex);
+	Dest.Normals[DestIdx] = FVector4(VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(MeshVertIndex));
 
-				FVector2D QuadCenter = FVector2D(((float)j + 0.5) / ((float)NumX), ((float)i + 0.5) / ((float)NumY));
-				UV1s.Add(QuadCenter);
-				UV1s.Add(QuadCenter);
-				UV1s.Add(QuadCenter);
-				UV1s.Add(QuadCenter);
-			}
-		}
+	const FVector4 TangentX = (FVector4)VertexBuffers.StaticMeshVertexBuffer.VertexTangentX(MeshVertIndex);
+	Dest.Tangents[DestIdx] = FVisMeshTangent(TangentX, TangentX.W < 0.f);
+
+	TArray<FVector2D>* UVChannels[] = { &Dest.UV0, &Dest.UV1, &Dest.UV2, &Dest.UV3 };
+	for (int32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+	{
+		(*UVChannels[UVIndex])[DestIdx] = FVector2D(VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(MeshVertIndex, UVIndex));
+	}
+
+	if (bCopyColor)
+	{
+		Dest.Colors[DestIdx] = VertexBuffers.ColorVertexBuffer.VertexColor(MeshVertIndex);
 	}
 }
 
-static int32 GetNewIndexForOldVertIndex(int32 MeshVertIndex, TMap<int32, int32>& MeshToSectionVertMap, const FStaticMeshVertexBuffers& VertexBuffers, TArray<FVector>& Vertices, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents)
+/** 未开启 CPU Access 时提示 (Cooked 版本中无法读取顶点数据) */
+static void VisMeshWarnIfNoCPUAccess(UStaticMesh* InMesh)
 {
-	int32* NewIndexPtr = MeshToSectionVertMap.Find(MeshVertIndex);
-	if (NewIndexPtr != nullptr)
+	if (!InMesh->bAllowCPUAccess)
 	{
-		return *NewIndexPtr;
+		FMessageLog("PIE").Warning()
+			->AddToken(FTextToken::Create(LOCTEXT("GetSectionFromStaticMeshStart", "Calling GetSectionFromStaticMesh on")))
+			->AddToken(FUObjectToken::Create(InMesh))
+			->AddToken(FTextToken::Create(LOCTEXT("GetSectionFromStaticMeshEnd", "but 'Allow CPU Access' is not enabled. This is required for converting StaticMesh to VisMeshComponent in cooked builds.")));
 	}
-	else
+}
+
+bool VisMeshExtractStaticMeshSection(const FStaticMeshLODResources& LOD, int32 SectionIndex, FVisMeshData& OutData)
+{
+	OutData.Reset();
+
+	if (!LOD.Sections.IsValidIndex(SectionIndex))
 	{
-		// Copy position
-		int32 SectionVertIndex = Vertices.Add((FVector)VertexBuffers.PositionVertexBuffer.VertexPosition(MeshVertIndex));
+		return false;
+	}
 
-		// Copy normal
-		Normals.Add(FVector4(VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(MeshVertIndex)));
-		check(Normals.Num() == Vertices.Num());
+	const FStaticMeshSection& Section = LOD.Sections[SectionIndex];
+	const FStaticMeshVertexBuffers& VertexBuffers = LOD.VertexBuffers;
+	const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+	const int32 FirstIndex = (int32)Section.FirstIndex;
+	const int32 NumIndices = (int32)Section.NumTriangles * 3;
+	if (NumIndices == 0 || Section.MaxVertexIndex < Section.MinVertexIndex)
+	{
+		return true;
+	}
 
-		// Copy UVs
-		UVs.Add(FVector2D(VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(MeshVertIndex, 0)));
-		check(UVs.Num() == Vertices.Num());
+	// 1. 在 Section 的顶点范围 [MinVertexIndex, MaxVertexIndex] 内用扁平表标记被引用的顶点 (代替 TMap)
+	const int32 RangeFirst = (int32)Section.MinVertexIndex;
+	const int32 RangeNum = (int32)Section.MaxVertexIndex - RangeFirst + 1;
+	TArray<int32> Remap;
+	Remap.SetNumZeroed(RangeNum);
+	for (int32 i = 0; i < NumIndices; i++)
+	{
+		Remap[(int32)Indices[FirstIndex + i] - RangeFirst] = 1;
+	}
 
-		// Copy tangents
-		FVector4 TangentX = (FVector4)VertexBuffers.StaticMeshVertexBuffer.VertexTangentX(MeshVertIndex);
-		FVisMeshTangent NewTangent(TangentX, TangentX.W < 0.f);
-		Tangents.Add(NewTangent);
-		check(Tangents.Num() == Vertices.Num());
+	// 2. 前缀和得到新索引；范围内的顶点全部被引用时 (常见情况) Remap 为恒等映射
+	const int32 NumVerts = VisMeshExclusiveScan(Remap);
+	const bool bContiguous = (NumVerts == RangeNum);
 
-		MeshToSectionVertMap.Add(MeshVertIndex, SectionVertIndex);
+	// 3. 按 StaticMesh 实际拥有的属性分配 SOA
+	const int32 NumTexCoords = FMath::Min((int32)VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords(), 4);
+	const bool bHasColors = VertexBuffers.ColorVertexBuffer.GetNumVertices() > 0;
 
-		return SectionVertIndex;
+	OutData.Positions.SetNumUninitialized(NumVerts);
+	OutData.Normals.SetNumUninitialized(NumVerts);
+	OutData.Tangents.SetNumUninitialized(NumVerts);
+	TArray<FVector2D>* UVChannels[] = { &OutData.UV0, &OutData.UV1, &OutData.UV2, &OutData.UV3 };
+	for (int32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+	{
+		UVChannels[UVIndex]->SetNumUninitialized(NumVerts);
 	}
-}
+	if (bHasColors)
+	{
+		OutData.Colors.SetNumUninitialized(NumVerts);
+	}
+	OutData.Triangles.SetNumUninitialized(NumIndices);
 
-void UKismetVisMeshLibrary::GetSectionFromStaticMesh(UStaticMesh* InMesh, int32 LODIndex, int32 SectionIndex, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents)
-{
-	if(	InMesh != nullptr )
+	if (bContiguous)
 	{
-		if (!InMesh->bAllowCPUAccess)
+		// 4a. 连续快速路径：按范围整段拷贝，颜色格式一致直接 memcpy，索引只需减去偏移
+		ParallelFor(NumVerts, [&](int32 VertIdx)
+		{
+			VisMeshReadStaticMeshVertex(OutData, VertIdx, VertexBuffers, (uint32)(RangeFirst + VertIdx), NumTexCoords, false);
+		});
+
+		if (bHasColors)
 		{
-			FMessageLog("PIE").Warning()
-				->AddToken(FTextToken::Create(LOCTEXT("GetSectionFromStaticMeshStart", "Calling GetSectionFromStaticMesh on")))
-				->AddToken(FUObjectToken::Create(InMesh))
-				->AddToken(FTextToken::Create(LOCTEXT("GetSectionFromStaticMeshEnd", "but 'Allow CPU Access' is not enabled. This is required for converting StaticMesh to VisMeshComponent in cooked builds.")));
+			FMemory::Memcpy(OutData.Colors.GetData(), &VertexBuffers.ColorVertexBuffer.VertexColor(RangeFirst), NumVerts * sizeof(FColor));
 		}
 
-		if (InMesh->GetRenderData() != nullptr && InMesh->GetRenderData()->LODResources.IsValidIndex(LODIndex))
+		ParallelFor(NumIndices, [&](int32 i)
+		{
+			OutData.Triangles[i] = (int32)Indices[FirstIndex + i] - RangeFirst;
+		});
+	}
+	else
+	{
+		// 4b. 回退路径：反查新顶点对应的旧顶点，再并行拷贝属性与重映射索引
+		TArray<int32> NewToOld;
+		NewToOld.SetNumUninitialized(NumVerts);
+		ParallelFor(RangeNum, [&](int32 LocalIdx)
 		{
-			const FStaticMeshLODResources& LOD = InMesh->GetRenderData()->LODResources[LODIndex];
-			if (LOD.Sections.IsValidIndex(SectionIndex))
+			const int32 NextNewIdx = (LocalIdx + 1 < RangeNum) ? Remap[LocalIdx + 1] : NumVerts;
+			if (NextNewIdx != Remap[LocalIdx])
 			{
-				// Empty output buffers
-				Vertices.Reset();
-				Triangles.Reset();
-				Normals.Reset();
-				UVs.Reset();
-				Tangents.Reset();
+				NewToOld[Remap[LocalIdx]] = RangeFirst + LocalIdx;
+			}
+		});
 
-				// Map from vert buffer for whole mesh to vert buffer for section of interest
-				TMap<int32, int32> MeshToSectionVertMap;
+		ParallelFor(NumVerts, [&](int32 VertIdx)
+		{
+			VisMeshReadStaticMeshVertex(OutData, VertIdx, VertexBuffers, (uint32)NewToOld[VertIdx], NumTexCoords, bHasColors);
+		});
 
-				const FStaticMeshSection& Section = LOD.Sections[SectionIndex];
-				const uint32 OnePastLastIndex = Section.FirstIndex + Section.NumTriangles * 3;
-				FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+		ParallelFor(NumIndices, [&](int32 i)
+		{
+			OutData.Triangles[i] = Remap[(int32)Indices[FirstIndex + i] - RangeFirst];
+		});
+	}
 
-				// Iterate over section index buffer, copying verts as needed
-				for (uint32 i = Section.FirstIndex; i < OnePastLastIndex; i++)
-				{
-					uint32 MeshVertIndex = Indices[i];
+	return true;
+}
 
-					// See if we have this vert already in our section vert buffer, and copy vert in if not 
-					int32 SectionVertIndex = GetNewIndexForOldVertIndex(MeshVertIndex, MeshToSectionVertMap, LOD.VertexBuffers, Vertices, Normals, UVs, Tangents);
+bool UKismetVisMeshLibrary::GetSectionDataFromStaticMesh(UStaticMesh* InMesh, int32 LODIndex, int32 SectionIndex, FVisMeshData& OutData)
+{
+	OutData.Reset();
 
-					// Add to index buffer
-					Triangles.Add(SectionVertIndex);
-				}
-			}
-		}
+	if (InMesh == nullptr)
+	{
+		return false;
+	}
+
+	VisMeshWarnIfNoCPUAccess(InMesh);
+
+	if (InMesh->GetRenderData() == nullptr || !InMesh->GetRenderData()->LODResources.IsValidIndex(LODIndex))
+	{
+		return false;
+	}
+
+	return VisMeshExtractStaticMeshSection(InMesh->GetRenderData()->LODResources[LODIndex], SectionIndex, OutData);
+}
+
+void UKismetVisMeshLibrary::GetSectionFromStaticMesh(UStaticMesh* InMesh, int32 LODIndex, int32 SectionIndex, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents)
+{
+	FVisMeshData SectionData;
+	if (GetSectionDataFromStaticMesh(InMesh, LODIndex, SectionIndex, SectionData))
+	{
+		Vertices = MoveTemp(SectionData.Positions);
+		Triangles = MoveTemp(SectionData.Triangles);
+		Normals = MoveTemp(SectionData.Normals);
+		UVs = MoveTemp(SectionData.UV0);
+		Tangents = MoveTemp(SectionData.Tangents);
 	}
 }
 
@@ -602,22 +900,10 @@ void UKismetVisMeshLibrary::CopyVisMeshFromStaticMeshComponent(UStaticMeshCompon
 		int32 NumSections = StaticMesh->GetNumSections(LODIndex);
 		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
 		{
-			// Buffers for copying geom data
-			TArray<FVector> Vertices;
-			TArray<int32> Triangles;
-			TArray<FVector> Normals;
-			TArray<FVector2D> UVs;
-			TArray<FVector2D> UVs1;
-			TArray<FVector2D> UVs2;
-			TArray<FVector2D> UVs3;
-			TArray<FVisMeshTangent> Tangents;
-
-			// Get geom data from static mesh
-			GetSectionFromStaticMesh(StaticMesh, LODIndex, SectionIndex, Vertices, Triangles, Normals, UVs, Tangents);
-
-			// Create section using data
-			TArray<FLinearColor> DummyColors;
-			ProcMeshComponent->CreateMeshSection_LinearColor(SectionIndex, Vertices, Triangles, Normals, UVs, UVs1, UVs2, UVs3, DummyColors, Tangents, bCreateCollision);
+			// 直接输出到 SOA，并 Move 进组件
+			FVisMeshData SectionData;
+			GetSectionDataFromStaticMesh(StaticMesh, LODIndex, SectionIndex, SectionData);
+			ProcMeshComponent->CreateMeshSection(SectionIndex, MoveTemp(SectionData), bCreateCollision);
 		}
 
 		//// SIMPLE COLLISION
@@ -646,40 +932,147 @@ void UKismetVisMeshLibrary::CopyVisMeshFromStaticMeshComponent(UStaticMeshCompon
 	}
 }
 
-void UKismetVisMeshLibrary::GetSectionFromVisMesh(UVisMeshProceduralComponent* InProcMesh, int32 SectionIndex,TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs,TArray<FVisMeshTangent>& Tangents)
+/** 后台提取 StaticMesh 全部 LOD 的共享状态 */
+struct FVisMeshStaticMeshCopyState
 {
-	if (InProcMesh && SectionIndex >= 0 && SectionIndex < InProcMesh->GetNumSections())
+	/** 提取期间保证网格不被回收。State 的最后一个引用只由游戏线程任务持有，保证在游戏线程上释放 */
+	TStrongObjectPtr<UStaticMesh> StaticMesh;
+	/** 每个 LOD 提取出的 Section */
+	TArray<TArray<FVisMeshSection>> LODSections;
+};
+
+void UKismetVisMeshLibrary::CopyVisMeshFromStaticMeshComponentAsync(UStaticMeshComponent* StaticMeshComponent, const TArray<UVisMeshProceduralComponent*>& LODComponents, bool bCreateCollision, FOnVisMeshCopyFinished OnFinished)
+{
+	UStaticMesh* StaticMesh = StaticMeshComponent != nullptr ? StaticMeshComponent->GetStaticMesh() : nullptr;
+	if (StaticMesh == nullptr || StaticMesh->GetRenderData() == nullptr)
 	{
-		const FVisMeshSection* Section = InProcMesh->GetVisMeshSection(SectionIndex);
-		const FVisMeshData& Data = Section->Data;
+		OnFinished.ExecuteIfBound();
+		return;
+	}
 
-		Vertices = Data.Positions;
-		// Copy Attributes (with safety check if they exist)
-		const int32 NumVerts = Vertices.Num();
-		
-		if (Data.Normals.Num() == NumVerts) Normals = Data.Normals;
-		else Normals.Init(FVector(0, 0, 1), NumVerts);
+	VisMeshWarnIfNoCPUAccess(StaticMesh);
 
-		if (Data.UV0.Num() == NumVerts) UVs = Data.UV0;
-		else UVs.Init(FVector2D::ZeroVector, NumVerts);
+	// 1. 游戏线程：确定要提取的 LOD (LODComponents[i] 接收 LOD i)
+	const int32 NumLODs = FMath::Min(LODComponents.Num(), StaticMesh->GetRenderData()->LODResources.Num());
 
-		if (Data.Tangents.Num() == NumVerts) Tangents = Data.Tangents;
-		else Tangents.Init(FVisMeshTangent(), NumVerts);
+	// 使用 TSharedPtr 而不是 TSharedRef：后者的移动等同于拷贝，无法把引用真正移交出去
+	TSharedPtr<FVisMeshStaticMeshCopyState, ESPMode::ThreadSafe> State = MakeShared<FVisMeshStaticMeshCopyState, ESPMode::ThreadSafe>();
+	State->StaticMesh.Reset(StaticMesh);
+	State->LODSections.SetNum(NumLODs);
 
-		// Copy index buffer
-		Triangles = Data.Triangles;
+	TArray<TWeakObjectPtr<UVisMeshProceduralComponent>> WeakTargets;
+	for (int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++)
+	{
+		WeakTargets.Add(LODComponents[LODIndex]);
 	}
-}
-
-//////////////////////////////////////////////////////////////////////////
+	TWeakObjectPtr<UStaticMeshComponent> WeakSource(StaticMeshComponent);
 
-/** Util that returns 1 ir on positive side of plane, -1 if negative, or 0 if split by plane */
-int32 VisMeshBoxPlaneCompare(FBox InBox, const FPlane& InPlane)
-{
-	FVector BoxCenter, BoxExtents;
-	InBox.GetCenterAndExtents(BoxCenter, BoxExtents);
+	// 2. 工作线程：并行提取所有 LOD 的所有 Section
+	Async(EAsyncExecution::ThreadPool, [State = MoveTemp(State), WeakSource, WeakTargets = MoveTemp(WeakTargets), bCreateCollision, OnFinished]() mutable
+	{
+		const TArray<FStaticMeshLODResources>& LODResources = State->StaticMesh->GetRenderData()->LODResources;
 
-	// Find distance of box center from plane
+		TArray<FIntPoint> Jobs; // (LOD, Section)
+		for (int32 LODIndex = 0; LODIndex < State->LODSections.Num(); LODIndex++)
+		{
+			State->LODSections[LODIndex].SetNum(LODResources[LODIndex].Sections.Num());
+			for (int32 SectionIndex = 0; SectionIndex < LODResources[LODIndex].Sections.Num(); SectionIndex++)
+			{
+				Jobs.Add(FIntPoint(LODIndex, SectionIndex));
+			}
+		}
+
+		ParallelFor(Jobs.Num(), [&](int32 JobIdx)
+		{
+			const FIntPoint Job = Jobs[JobIdx];
+			FVisMeshSection& Section = State->LODSections[Job.X][Job.Y];
+			VisMeshExtractStaticMeshSection(LODResources[Job.X], Job.Y, Section.Data);
+
+			// 与 CreateMeshSection 一致：补齐缺失的属性，计算包围盒
+			VisMeshPadAttributes(Section.Data);
+			Section.SectionLocalBox = VisMeshComputeBounds(Section.Data.Positions);
+			Section.bEnableCollision = bCreateCollision;
+		});
+
+		// 3. 游戏线程：Move 进组件，每个组件只更新一次
+		//    State 整体移交给游戏线程任务，工作线程不再持有引用，StaticMesh 的强引用随该任务在游戏线程上析构
+		AsyncTask(ENamedThreads::GameThread, [State = MoveTemp(State), WeakSource, WeakTargets = MoveTemp(WeakTargets), OnFinished = MoveTemp(OnFinished)]()
+		{
+			UStaticMesh* Mesh = State->StaticMesh.Get();
+
+			TArray<TArray<FVector>> ConvexMeshes;
+			if (Mesh->GetBodySetup() != nullptr)
+			{
+				for (const FKConvexElem& MeshConvex : Mesh->GetBodySetup()->AggGeom.ConvexElems)
+				{
+					ConvexMeshes.Add(MeshConvex.VertexData);
+				}
+			}
+
+			for (int32 LODIndex = 0; LODIndex < WeakTargets.Num(); LODIndex++)
+			{
+				UVisMeshProceduralComponent* ProcMeshComponent = WeakTargets[LODIndex].Get();
+				if (ProcMeshComponent == nullptr)
+				{
+					continue;
+				}
+
+				TArray<int32> SectionIndices;
+				for (int32 SectionIndex = 0; SectionIndex < State->LODSections[LODIndex].Num(); SectionIndex++)
+				{
+					SectionIndices.Add(SectionIndex);
+				}
+				ProcMeshComponent->SetVisMeshSections(SectionIndices, MoveTemp(State->LODSections[LODIndex]), &ConvexMeshes);
+
+				if (UStaticMeshComponent* StaticMeshComponent = WeakSource.Get())
+				{
+					for (int32 MatIndex = 0; MatIndex < StaticMeshComponent->GetNumMaterials(); MatIndex++)
+					{
+						ProcMeshComponent->SetMaterial(MatIndex, StaticMeshComponent->GetMaterial(MatIndex));
+					}
+				}
+			}
+
+			State->StaticMesh.Reset();
+			OnFinished.ExecuteIfBound();
+		});
+	});
+}
+
+void UKismetVisMeshLibrary::GetSectionFromVisMesh(UVisMeshProceduralComponent* InProcMesh, int32 SectionIndex,TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs,TArray<FVisMeshTangent>& Tangents)
+{
+	if (InProcMesh && SectionIndex >= 0 && SectionIndex < InProcMesh->GetNumSections())
+	{
+		const FVisMeshSection* Section = InProcMesh->GetVisMeshSection(SectionIndex);
+		const FVisMeshData& Data = Section->Data;
+
+		Vertices = Data.Positions;
+		// Copy Attributes (with safety check if they exist)
+		const int32 NumVerts = Vertices.Num();
+		
+		if (Data.Normals.Num() == NumVerts) Normals = Data.Normals;
+		else Normals.Init(FVector(0, 0, 1), NumVerts);
+
+		if (Data.UV0.Num() == NumVerts) UVs = Data.UV0;
+		else UVs.Init(FVector2D::ZeroVector, NumVerts);
+
+		if (Data.Tangents.Num() == NumVerts) Tangents = Data.Tangents;
+		else Tangents.Init(FVisMeshTangent(), NumVerts);
+
+		// Copy index buffer
+		Triangles = Data.GetTriangles();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+/** Util that returns 1 ir on positive side of plane, -1 if negative, or 0 if split by plane */
+int32 VisMeshBoxPlaneCompare(FBox InBox, const FPlane& InPlane)
+{
+	FVector BoxCenter, BoxExtents;
+	InBox.GetCenterAndExtents(BoxCenter, BoxExtents);
+
+	// Find distance of box center from plane
 	FVector::FReal BoxCenterDist = InPlane.PlaneDot(BoxCenter);
 
 	// See size of box in plane normal direction
@@ -812,8 +1205,362 @@ bool VisMeshTriangulatePoly(TArray<int32>& OutTris, const FVisMeshData& PolyData
 	return true;
 }
 
+/**
+ *	带洞多边形三角化：扫描线单调分解 + 单调多边形栈式三角化
+ *	复杂度：排序 O(n log n)；扫描线状态是有序 TArray (二分查找定位，插入/删除 O(k)，k 为扫描线同时穿过的边数)，
+ *	截面轮廓的 k 通常远小于 n，但最坏为 O(n^2)；嵌套深度逐轮廓做点包含测试，O(L * n) (L 为轮廓数)
+ *	Loops 可以是任意方向的外轮廓与洞 (按嵌套深度自动判定)，输出为 Loops 顶点拼接后的下标
+ *	遇到无法处理的退化输入时返回 false 且不修改 OutTris
+ */
+bool VisMeshTriangulatePolygonSet(const TArray<TArray<FVector2D>>& Loops, TArray<int32>& OutTris)
+{
+	// 1. 拼接所有轮廓，Prev/Next 构成各自的环
+	TArray<FVector2D> P;
+	TArray<int32> Prev, Next, LoopStarts;
+	for (const TArray<FVector2D>& Loop : Loops)
+	{
+		if (Loop.Num() < 3)
+		{
+			continue;
+		}
+		const int32 Base = P.Num();
+		LoopStarts.Add(Base);
+		for (int32 i = 0; i < Loop.Num(); i++)
+		{
+			P.Add(Loop[i]);
+			Prev.Add(Base + (i + Loop.Num() - 1) % Loop.Num());
+			Next.Add(Base + (i + 1) % Loop.Num());
+		}
+	}
+	LoopStarts.Add(P.Num());
+
+	const int32 NumVerts = P.Num();
+	if (NumVerts < 3)
+	{
+		return false;
+	}
+
+	// 2. 按嵌套深度统一方向：外轮廓逆时针，洞顺时针 (内部始终在边的左侧)
+	const int32 NumLoops = LoopStarts.Num() - 1;
+	auto PointInLoop = [&](const FVector2D& Q, int32 LoopIdx)
+	{
+		bool bInside = false;
+		for (int32 i = LoopStarts[LoopIdx], j = LoopStarts[LoopIdx + 1] - 1; i < LoopStarts[LoopIdx + 1]; j = i++)
+		{
+			if ((P[i].Y > Q.Y) != (P[j].Y > Q.Y) && Q.X < (P[j].X - P[i].X) * (Q.Y - P[i].Y) / (P[j].Y - P[i].Y) + P[i].X)
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
+	};
+	for (int32 LoopIdx = 0; LoopIdx < NumLoops; LoopIdx++)
+	{
+		double Area = 0.0;
+		for (int32 i = LoopStarts[LoopIdx]; i < LoopStarts[LoopIdx + 1]; i++)
+		{
+			Area += FVector2D::CrossProduct(P[i], P[Next[i]]);
+		}
+
+		int32 Depth = 0;
+		for (int32 Other = 0; Other < NumLoops; Other++)
+		{
+			Depth += (Other != LoopIdx && PointInLoop(P[LoopStarts[LoopIdx]], Other)) ? 1 : 0;
+		}
+
+		if ((Area > 0.0) != (Depth % 2 == 0))
+		{
+			for (int32 i = LoopStarts[LoopIdx]; i < LoopStarts[LoopIdx + 1]; i++)
+			{
+				Swap(Prev[i], Next[i]);
+			}
+		}
+	}
+
+	// "更高" 的全序：先比 Y，再比 X，最后比下标
+	auto Above = [&P](int32 A, int32 B)
+	{
+		if (P[A].Y != P[B].Y) return P[A].Y > P[B].Y;
+		if (P[A].X != P[B].X) return P[A].X < P[B].X;
+		return A < B;
+	};
+	auto Orient = [&P](int32 A, int32 B, int32 C)
+	{
+		return FVector2D::CrossProduct(P[B] - P[A], P[C] - P[A]);
+	};
+
+	// 3. 顶点分类
+	enum class EVertexType : uint8 { Start, End, Split, Merge, Regular };
+	TArray<EVertexType> Types;
+	Types.SetNumUninitialized(NumVerts);
+	for (int32 V = 0; V < NumVerts; V++)
+	{
+		const bool bPrevBelow = Above(V, Prev[V]);
+		const bool bNextBelow = Above(V, Next[V]);
+		const bool bConvex = Orient(Prev[V], V, Next[V]) > 0.0;
+		if (bPrevBelow && bNextBelow) Types[V] = bConvex ? EVertexType::Start : EVertexType::Split;
+		else if (!bPrevBelow && !bNextBelow) Types[V] = bConvex ? EVertexType::End : EVertexType::Merge;
+		else Types[V] = EVertexType::Regular;
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumVerts);
+	for (int32 V = 0; V < NumVerts; V++)
+	{
+		Order[V] = V;
+	}
+	Order.Sort(Above);
+
+	// 4. 扫描线：状态中保存内部在右侧的边 (边 e 指 e -> Next[e])，按扫描线处的 X 有序
+	TArray<int32> Status;
+	TArray<int32> Helper;
+	Helper.Init(INDEX_NONE, NumVerts);
+	TArray<TPair<int32, int32>> Diagonals;
+
+	auto XAtY = [&](int32 Edge, double Y)
+	{
+		const FVector2D& A = P[Edge];
+		const FVector2D& B = P[Next[Edge]];
+		if (A.Y == B.Y)
+		{
+			return FMath::Max(A.X, B.X);
+		}
+		return A.X + (Y - A.Y) / (B.Y - A.Y) * (B.X - A.X);
+	};
+	auto InsertEdge = [&](int32 Edge, int32 V)
+	{
+		const int32 Pos = Algo::UpperBoundBy(Status, P[V].X, [&](int32 E) { return XAtY(E, P[V].Y); });
+		Status.Insert(Edge, Pos);
+		Helper[Edge] = V;
+	};
+	auto FindLeftEdge = [&](int32 V)
+	{
+		const int32 Pos = Algo::UpperBoundBy(Status, P[V].X, [&](int32 E) { return XAtY(E, P[V].Y); });
+		return Pos > 0 ? Status[Pos - 1] : INDEX_NONE;
+	};
+	auto ConnectIfMerge = [&](int32 V, int32 Edge)
+	{
+		if (Edge != INDEX_NONE && Helper[Edge] != INDEX_NONE && Types[Helper[Edge]] == EVertexType::Merge)
+		{
+			Diagonals.Emplace(V, Helper[Edge]);
+		}
+	};
+
+	for (const int32 V : Order)
+	{
+		const int32 PrevEdge = Prev[V];
+		switch (Types[V])
+		{
+		case EVertexType::Start:
+			InsertEdge(V, V);
+			break;
+		case EVertexType::End:
+			ConnectIfMerge(V, PrevEdge);
+			Status.Remove(PrevEdge);
+			break;
+		case EVertexType::Split:
+		{
+			const int32 LeftEdge = FindLeftEdge(V);
+			if (LeftEdge == INDEX_NONE)
+			{
+				return false;
+			}
+			Diagonals.Emplace(V, Helper[LeftEdge]);
+			Helper[LeftEdge] = V;
+			InsertEdge(V, V);
+			break;
+		}
+		case EVertexType::Merge:
+		{
+			ConnectIfMerge(V, PrevEdge);
+			Status.Remove(PrevEdge);
+			const int32 LeftEdge = FindLeftEdge(V);
+			if (LeftEdge == INDEX_NONE)
+			{
+				return false;
+			}
+			ConnectIfMerge(V, LeftEdge);
+			Helper[LeftEdge] = V;
+			break;
+		}
+		default:
+			// 内部在右侧 (沿边界向下走)
+			if (Above(Prev[V], V))
+			{
+				ConnectIfMerge(V, PrevEdge);
+				Status.Remove(PrevEdge);
+				InsertEdge(V, V);
+			}
+			else
+			{
+				const int32 LeftEdge = FindLeftEdge(V);
+				if (LeftEdge == INDEX_NONE)
+				{
+					return false;
+				}
+				ConnectIfMerge(V, LeftEdge);
+				Helper[LeftEdge] = V;
+			}
+			break;
+		}
+	}
+
+	// 5. 用对角线把区域切成单调多边形：每个顶点的出边按角度排序，沿 "顺时针下一条出边" 遍历每个面
+	TArray<TPair<int32, int32>> HalfEdges;
+	TArray<TArray<int32, TInlineAllocator<2>>> OutEdges;
+	OutEdges.SetNum(NumVerts);
+	auto AddHalfEdge = [&](int32 From, int32 To)
+	{
+		OutEdges[From].Add(HalfEdges.Emplace(From, To));
+	};
+	for (int32 V = 0; V < NumVerts; V++)
+	{
+		AddHalfEdge(V, Next[V]);
+	}
+	for (const TPair<int32, int32>& Diagonal : Diagonals)
+	{
+		AddHalfEdge(Diagonal.Key, Diagonal.Value);
+		AddHalfEdge(Diagonal.Value, Diagonal.Key);
+	}
+
+	auto Angle = [&](int32 From, int32 To)
+	{
+		const FVector2D D = P[To] - P[From];
+		return FMath::Atan2(D.Y, D.X);
+	};
+	for (int32 V = 0; V < NumVerts; V++)
+	{
+		OutEdges[V].Sort([&](int32 A, int32 B) { return Angle(V, HalfEdges[A].Value) < Angle(V, HalfEdges[B].Value); });
+	}
+
+	auto NextHalfEdge = [&](int32 HalfEdge)
+	{
+		const int32 From = HalfEdges[HalfEdge].Key;
+		const int32 To = HalfEdges[HalfEdge].Value;
+		const double BackAngle = Angle(To, From);
+		const TArray<int32, TInlineAllocator<2>>& Candidates = OutEdges[To];
+
+		// 反向边顺时针方向上的第一条出边
+		int32 Best = Candidates.Last();
+		for (int32 i = Candidates.Num() - 1; i >= 0; i--)
+		{
+			if (Angle(To, HalfEdges[Candidates[i]].Value) < BackAngle)
+			{
+				Best = Candidates[i];
+				break;
+			}
+		}
+		return Best;
+	};
+
+	TArray<int32> NewTris;
+	TBitArray<> HalfEdgeUsed(false, HalfEdges.Num());
+	TArray<int32> Face, Sorted, Stack;
+	TArray<bool> bLeftChain;
+	bLeftChain.SetNumZeroed(NumVerts);
+
+	auto EmitTriangle = [&](int32 A, int32 B, int32 C)
+	{
+		if (Orient(A, B, C) < 0.0)
+		{
+			Swap(B, C);
+		}
+		NewTris.Add(A);
+		NewTris.Add(B);
+		NewTris.Add(C);
+	};
+
+	for (int32 Start = 0; Start < HalfEdges.Num(); Start++)
+	{
+		if (HalfEdgeUsed[Start])
+		{
+			continue;
+		}
+
+		Face.Reset();
+		int32 HalfEdge = Start;
+		do
+		{
+			if (HalfEdgeUsed[HalfEdge] || Face.Num() > NumVerts)
+			{
+				return false;
+			}
+			HalfEdgeUsed[HalfEdge] = true;
+			Face.Add(HalfEdges[HalfEdge].Key);
+			HalfEdge = NextHalfEdge(HalfEdge);
+		} while (HalfEdge != Start);
+
+		if (Face.Num() < 3)
+		{
+			continue;
+		}
+
+		// 6. 单调多边形三角化：从最高点沿面的方向走到最低点为左链，其余为右链
+		int32 Top = 0, Bottom = 0;
+		for (int32 i = 1; i < Face.Num(); i++)
+		{
+			if (Above(Face[i], Face[Top])) Top = i;
+			if (Above(Face[Bottom], Face[i])) Bottom = i;
+		}
+		for (int32 i = 0; i < Face.Num(); i++)
+		{
+			bLeftChain[Face[i]] = false;
+		}
+		for (int32 i = (Top + 1) % Face.Num(); i != Bottom; i = (i + 1) % Face.Num())
+		{
+			bLeftChain[Face[i]] = true;
+		}
+
+		Sorted = Face;
+		Sorted.Sort(Above);
+
+		Stack.Reset();
+		Stack.Add(Sorted[0]);
+		Stack.Add(Sorted[1]);
+		for (int32 j = 2; j < Sorted.Num() - 1; j++)
+		{
+			const int32 U = Sorted[j];
+			if (bLeftChain[U] != bLeftChain[Stack.Last()])
+			{
+				for (int32 k = 0; k + 1 < Stack.Num(); k++)
+				{
+					EmitTriangle(U, Stack[k], Stack[k + 1]);
+				}
+				Stack.Reset();
+				Stack.Add(Sorted[j - 1]);
+				Stack.Add(U);
+			}
+			else
+			{
+				int32 Last = Stack.Pop();
+				while (Stack.Num() > 0)
+				{
+					const int32 Top2 = Stack.Last();
+					const bool bValid = bLeftChain[U] ? Orient(Top2, Last, U) > 0.0 : Orient(U, Last, Top2) > 0.0;
+					if (!bValid)
+					{
+						break;
+					}
+					EmitTriangle(Top2, Last, U);
+					Last = Stack.Pop();
+				}
+				Stack.Add(Last);
+				Stack.Add(U);
+			}
+		}
+		for (int32 k = 0; k + 1 < Stack.Num(); k++)
+		{
+			EmitTriangle(Sorted.Last(), Stack[k], Stack[k + 1]);
+		}
+	}
+
+	OutTris.Append(NewTris);
+	return true;
+}
+
 /** Util to slice a convex hull with a plane */
-void VisMeshSliceConvexElem(const FKConvexElem& InConvex, const FPlane& SlicePlane, TArray<FVector>& OutConvexVerts)
+/** Take a convex hull and clip it against a set of planes in one hull rebuild, keeping the positive side of every plane */
+void VisMeshClipConvexElem(const FKConvexElem& InConvex, TArrayView<const FPlane> ClipPlanes, TArray<FVector>& OutConvexVerts)
 {
 	// Get set of planes that make up hull
 	TArray<FPlane> ConvexPlanes;
@@ -821,8 +1568,11 @@ void VisMeshSliceConvexElem(const FKConvexElem& InConvex, const FPlane& SlicePla
 
 	if (ConvexPlanes.Num() >= 4)
 	{
-		// Add on the slicing plane (need to flip as it culls geom in the opposite sense to our geom culling code)
-		ConvexPlanes.Add(SlicePlane.Flip());
+		// Add on the slicing planes (need to flip as it culls geom in the opposite sense to our geom culling code)
+		for (const FPlane& ClipPlane : ClipPlanes)
+		{
+			ConvexPlanes.Add(ClipPlane.Flip());
+		}
 
 		// Create output convex based on new set of planes
 		FKConvexElem SlicedElem;
@@ -834,271 +1584,929 @@ void VisMeshSliceConvexElem(const FKConvexElem& InConvex, const FPlane& SlicePla
 	}
 }
 
-void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh, FVector PlanePosition,FVector PlaneNormal, bool bCreateOtherHalf, UVisMeshProceduralComponent*& OutOtherHalfProcMesh,EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial)
+/** Take a convex hull and cut it with a plane. Output is the new convex hull. */
+void VisMeshSliceConvexElem(const FKConvexElem& InConvex, const FPlane& SlicePlane, TArray<FVector>& OutConvexVerts)
 {
-	if (InProcMesh != nullptr)
+	VisMeshClipConvexElem(InConvex, MakeArrayView(&SlicePlane, 1), OutConvexVerts);
+}
+
+/** 按源数据的属性布局为目标 SOA 分配空间 (源数据中缺失或长度不足的属性在目标中保持为空) */
+void VisMeshAllocateLike(FVisMeshData& Dest, const FVisMeshData& Src, int32 NumVerts, int32 NumIndices)
+{
+	const int32 SrcVerts = Src.NumVertices();
+	Dest.Positions.SetNumUninitialized(NumVerts);
+	if (Src.Normals.Num() == SrcVerts) Dest.Normals.SetNumUninitialized(NumVerts);
+	if (Src.Tangents.Num() == SrcVerts) Dest.Tangents.SetNumUninitialized(NumVerts);
+	if (Src.Colors.Num() == SrcVerts) Dest.Colors.SetNumUninitialized(NumVerts);
+	if (Src.UV0.Num() == SrcVerts) Dest.UV0.SetNumUninitialized(NumVerts);
+	if (Src.UV1.Num() == SrcVerts) Dest.UV1.SetNumUninitialized(NumVerts);
+	if (Src.UV2.Num() == SrcVerts) Dest.UV2.SetNumUninitialized(NumVerts);
+	if (Src.UV3.Num() == SrcVerts) Dest.UV3.SetNumUninitialized(NumVerts);
+
+	Dest.Scalars.SetNum(Src.Scalars.Num());
+	for (int32 Channel = 0; Channel < Src.Scalars.Num(); Channel++)
 	{
-		// Transform plane from world to local space
-		FTransform ProcCompToWorld = InProcMesh->GetComponentToWorld();
-		FVector LocalPlanePos = ProcCompToWorld.InverseTransformPosition(PlanePosition);
-		FVector LocalPlaneNormal = ProcCompToWorld.InverseTransformVectorNoScale(PlaneNormal);
-		LocalPlaneNormal = LocalPlaneNormal.GetSafeNormal(); // Ensure normalized
+		Dest.Scalars[Channel].Name = Src.Scalars[Channel].Name;
+		if (Src.Scalars[Channel].Values.Num() == SrcVerts) Dest.Scalars[Channel].Values.SetNumUninitialized(NumVerts);
+	}
 
-		FPlane SlicePlane(LocalPlanePos, LocalPlaneNormal);
+	Dest.Triangles.SetNumUninitialized(NumIndices);
+}
 
-		// Set of sections to add to the 'other half' component
-		TArray<FVisMeshSection> OtherSections;
-		// Material for each section of other half
-		TArray<UMaterialInterface*> OtherMaterials;
+/** 将源顶点写入预分配好的目标 SOA (VisMeshCopyVertex 的定长版本，可并行调用) */
+void VisMeshWriteVertex(FVisMeshData& Dest, int32 DestIdx, const FVisMeshData& Src, int32 SrcIdx)
+{
+	Dest.Positions[DestIdx] = Src.Positions[SrcIdx];
+	if (Dest.Normals.Num() > 0) Dest.Normals[DestIdx] = Src.Normals[SrcIdx];
+	if (Dest.Tangents.Num() > 0) Dest.Tangents[DestIdx] = Src.Tangents[SrcIdx];
+	if (Dest.Colors.Num() > 0) Dest.Colors[DestIdx] = Src.Colors[SrcIdx];
+	if (Dest.UV0.Num() > 0) Dest.UV0[DestIdx] = Src.UV0[SrcIdx];
+	if (Dest.UV1.Num() > 0) Dest.UV1[DestIdx] = Src.UV1[SrcIdx];
+	if (Dest.UV2.Num() > 0) Dest.UV2[DestIdx] = Src.UV2[SrcIdx];
+	if (Dest.UV3.Num() > 0) Dest.UV3[DestIdx] = Src.UV3[SrcIdx];
+	for (int32 Channel = 0; Channel < Dest.Scalars.Num(); Channel++)
+	{
+		if (Dest.Scalars[Channel].Values.Num() > 0) Dest.Scalars[Channel].Values[DestIdx] = Src.Scalars[Channel].Values[SrcIdx];
+	}
+}
 
-		// Set of new edges created by clipping polys by plane
-		TArray<FUtilEdge3D> ClipEdges;
+/** 在两个源顶点之间插值并写入预分配好的目标 SOA (VisMeshInterpolateVertex 的定长版本，可并行调用) */
+void VisMeshWriteInterpolatedVertex(FVisMeshData& Dest, int32 DestIdx, const FVisMeshData& Src, int32 Idx0, int32 Idx1, float Alpha)
+{
+	Dest.Positions[DestIdx] = FMath::Lerp(Src.Positions[Idx0], Src.Positions[Idx1], Alpha);
+	if (Dest.Normals.Num() > 0) Dest.Normals[DestIdx] = FMath::Lerp(Src.Normals[Idx0], Src.Normals[Idx1], Alpha);
+	if (Dest.Tangents.Num() > 0)
+	{
+		Dest.Tangents[DestIdx].TangentX = FMath::Lerp(Src.Tangents[Idx0].TangentX, Src.Tangents[Idx1].TangentX, Alpha);
+		Dest.Tangents[DestIdx].bFlipTangentY = Src.Tangents[Idx0].bFlipTangentY;
+	}
+	if (Dest.Colors.Num() > 0)
+	{
+		const FColor& C0 = Src.Colors[Idx0];
+		const FColor& C1 = Src.Colors[Idx1];
+		FColor& Result = Dest.Colors[DestIdx];
+		Result.R = FMath::Clamp(FMath::TruncToInt(FMath::Lerp(float(C0.R), float(C1.R), Alpha)), 0, 255);
+		Result.G = FMath::Clamp(FMath::TruncToInt(FMath::Lerp(float(C0.G), float(C1.G), Alpha)), 0, 255);
+		Result.B = FMath::Clamp(FMath::TruncToInt(FMath::Lerp(float(C0.B), float(C1.B), Alpha)), 0, 255);
+		Result.A = FMath::Clamp(FMath::TruncToInt(FMath::Lerp(float(C0.A), float(C1.A), Alpha)), 0, 255);
+	}
+	if (Dest.UV0.Num() > 0) Dest.UV0[DestIdx] = FMath::Lerp(Src.UV0[Idx0], Src.UV0[Idx1], Alpha);
+	if (Dest.UV1.Num() > 0) Dest.UV1[DestIdx] = FMath::Lerp(Src.UV1[Idx0], Src.UV1[Idx1], Alpha);
+	if (Dest.UV2.Num() > 0) Dest.UV2[DestIdx] = FMath::Lerp(Src.UV2[Idx0], Src.UV2[Idx1], Alpha);
+	if (Dest.UV3.Num() > 0) Dest.UV3[DestIdx] = FMath::Lerp(Src.UV3[Idx0], Src.UV3[Idx1], Alpha);
+	for (int32 Channel = 0; Channel < Dest.Scalars.Num(); Channel++)
+	{
+		const TArray<float>& Values = Src.Scalars[Channel].Values;
+		if (Dest.Scalars[Channel].Values.Num() > 0) Dest.Scalars[Channel].Values[DestIdx] = FMath::Lerp(Values[Idx0], Values[Idx1], Alpha);
+	}
+}
 
-		for (int32 SectionIndex = 0; SectionIndex < InProcMesh->GetNumSections(); SectionIndex++)
+/**
+ *	用平面切割一个 Section：顶点分类 -> 前缀和压缩 -> 三角形分类 -> 前缀和 -> 并行写入
+ *	输出数组一次性分配，每个三角形写入的位置由前缀和决定，因此各阶段都可以并行
+ */
+void VisMeshSliceSection(const FVisMeshSection& BaseSection, const FPlane& SlicePlane, bool bCreateOtherHalf, FVisMeshSectionSliceResult& OutResult)
+{
+	const FVisMeshData& Src = BaseSection.Data;
+	const int32 NumBaseVerts = Src.NumVertices();
+	const TArray<int32>& SrcTris = Src.GetTriangles();
+	const int32 NumTris = SrcTris.Num() / 3;
+
+	// 1. 顶点分类：到平面的距离，正侧保留
+	TArray<float> VertDistance;
+	TArray<int32> KeptRemap, OtherRemap;
+	VertDistance.SetNumUninitialized(NumBaseVerts);
+	KeptRemap.SetNumUninitialized(NumBaseVerts);
+	OtherRemap.SetNumUninitialized(NumBaseVerts);
+
+	ParallelFor(NumBaseVerts, [&](int32 VertIdx)
+	{
+		const float Dist = SlicePlane.PlaneDot(Src.Positions[VertIdx]);
+		VertDistance[VertIdx] = Dist;
+		KeptRemap[VertIdx] = Dist > 0.f ? 1 : 0;
+		OtherRemap[VertIdx] = (bCreateOtherHalf && Dist <= 0.f) ? 1 : 0;
+	});
+
+	// 2. 前缀和压缩：旧顶点下标 -> 新顶点下标 (扁平数组代替 TMap)
+	const int32 NumKeptVerts = VisMeshExclusiveScan(KeptRemap);
+	const int32 NumOtherVerts = VisMeshExclusiveScan(OtherRemap);
+
+	// 3. 三角形分类：每个三角形在两侧各输出几个三角形，是否被切开
+	TArray<int32> KeptTriOffset, OtherTriOffset, SplitOffset;
+	KeptTriOffset.SetNumUninitialized(NumTris);
+	OtherTriOffset.SetNumUninitialized(NumTris);
+	SplitOffset.SetNumUninitialized(NumTris);
+
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		int32 NumKeptCorners = 0;
+		for (int32 i = 0; i < 3; i++)
 		{
-			FVisMeshSection* BaseSection = InProcMesh->GetVisMeshSection(SectionIndex);
-			// If we have a section, and it has some valid geom
-			if (BaseSection != nullptr && BaseSection->Data.Triangles.Num() > 0 && BaseSection->Data.Positions.Num() > 0)
+			NumKeptCorners += VertDistance[SrcTris[TriIdx * 3 + i]] > 0.f ? 1 : 0;
+		}
+
+		// 被切开的三角形：保留侧是 (k + 2) 边形，扇形三角化得到 k 个三角形，另一侧同理
+		const bool bSplit = NumKeptCorners == 1 || NumKeptCorners == 2;
+		KeptTriOffset[TriIdx] = NumKeptCorners == 3 ? 1 : (bSplit ? NumKeptCorners : 0);
+		OtherTriOffset[TriIdx] = !bCreateOtherHalf ? 0 : (NumKeptCorners == 0 ? 1 : (bSplit ? 3 - NumKeptCorners : 0));
+		SplitOffset[TriIdx] = bSplit ? 1 : 0;
+	});
+
+	const int32 NumKeptTris = VisMeshExclusiveScan(KeptTriOffset);
+	const int32 NumOtherTris = VisMeshExclusiveScan(OtherTriOffset);
+	const int32 NumSplitTris = VisMeshExclusiveScan(SplitOffset);
+
+	// 4. 一次性分配输出：每个被切开的三角形在两侧各产生 2 个插值顶点和 1 条 Cap 边
+	FVisMeshData& Kept = OutResult.Kept.Data;
+	FVisMeshData& Other = OutResult.Other.Data;
+	VisMeshAllocateLike(Kept, Src, NumKeptVerts + NumSplitTris * 2, NumKeptTris * 3);
+	if (bCreateOtherHalf)
+	{
+		VisMeshAllocateLike(Other, Src, NumOtherVerts + NumSplitTris * 2, NumOtherTris * 3);
+	}
+	OutResult.ClipEdges.SetNumUninitialized(NumSplitTris);
+
+	// 5. 并行写入未被切掉的原始顶点
+	ParallelFor(NumBaseVerts, [&](int32 VertIdx)
+	{
+		if (VertDistance[VertIdx] > 0.f)
+		{
+			VisMeshWriteVertex(Kept, KeptRemap[VertIdx], Src, VertIdx);
+		}
+		else if (bCreateOtherHalf)
+		{
+			VisMeshWriteVertex(Other, OtherRemap[VertIdx], Src, VertIdx);
+		}
+	});
+
+	// 6. 并行写入三角形与切割产生的插值顶点
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		int32 BaseV[3];
+		bool bKept[3];
+		for (int32 i = 0; i < 3; i++)
+		{
+			BaseV[i] = SrcTris[TriIdx * 3 + i];
+			bKept[i] = VertDistance[BaseV[i]] > 0.f;
+		}
+
+		int32* KeptTris = Kept.Triangles.GetData() + KeptTriOffset[TriIdx] * 3;
+		int32* OtherTris = bCreateOtherHalf ? Other.Triangles.GetData() + OtherTriOffset[TriIdx] * 3 : nullptr;
+
+		// If all verts survived plane cull, keep the triangle
+		if (bKept[0] && bKept[1] && bKept[2])
+		{
+			for (int32 i = 0; i < 3; i++) KeptTris[i] = KeptRemap[BaseV[i]];
+			return;
+		}
+		// If all verts were removed by plane cull
+		if (!bKept[0] && !bKept[1] && !bKept[2])
+		{
+			if (OtherTris)
+			{
+				for (int32 i = 0; i < 3; i++) OtherTris[i] = OtherRemap[BaseV[i]];
+			}
+			return;
+		}
+
+		// If partially culled, clip to create 1 or 2 new triangles
+		int32 FinalVerts[4];
+		int32 NumFinalVerts = 0;
+		int32 OtherFinalVerts[4];
+		int32 NumOtherFinalVerts = 0;
+
+		const int32 SplitIdx = SplitOffset[TriIdx];
+		const int32 KeptInterpBase = NumKeptVerts + SplitIdx * 2;
+		const int32 OtherInterpBase = NumOtherVerts + SplitIdx * 2;
+
+		FUtilEdge3D NewClipEdge;
+		int32 ClippedEdges = 0;
+
+		for (int32 ThisVert = 0; ThisVert < 3; ThisVert++)
+		{
+			// If start vert is inside, add it. If not, add to other side
+			if (bKept[ThisVert])
+			{
+				FinalVerts[NumFinalVerts++] = KeptRemap[BaseV[ThisVert]];
+			}
+			else if (OtherTris)
+			{
+				OtherFinalVerts[NumOtherFinalVerts++] = OtherRemap[BaseV[ThisVert]];
+			}
+
+			// If start and next vert are on opposite sides, add intersection
+			const int32 NextVert = (ThisVert + 1) % 3;
+			if (bKept[ThisVert] != bKept[NextVert])
+			{
+				const float DistThis = VertDistance[BaseV[ThisVert]];
+				const float DistNext = VertDistance[BaseV[NextVert]];
+				const float Alpha = FMath::Clamp(-DistThis / (DistNext - DistThis), 0.0f, 1.0f);
+
+				const int32 InterpVertIndex = KeptInterpBase + ClippedEdges;
+				VisMeshWriteInterpolatedVertex(Kept, InterpVertIndex, Src, BaseV[ThisVert], BaseV[NextVert], Alpha);
+				FinalVerts[NumFinalVerts++] = InterpVertIndex;
+
+				if (OtherTris)
+				{
+					const int32 OtherInterpVertIndex = OtherInterpBase + ClippedEdges;
+					VisMeshWriteInterpolatedVertex(Other, OtherInterpVertIndex, Src, BaseV[ThisVert], BaseV[NextVert], Alpha);
+					OtherFinalVerts[NumOtherFinalVerts++] = OtherInterpVertIndex;
+				}
+
+				// When we make a new edge on the surface of the clip plane, save it off.
+				const FVector3f InterpPos = (FVector3f)Kept.Positions[InterpVertIndex];
+				if (ClippedEdges == 0)
+				{
+					NewClipEdge.V0 = InterpPos;
+				}
+				else
+				{
+					NewClipEdge.V1 = InterpPos;
+				}
+				ClippedEdges++;
+			}
+		}
+		check(ClippedEdges == 2);
+
+		// Triangulate the clipped polygon.
+		for (int32 VertexIndex = 2; VertexIndex < NumFinalVerts; VertexIndex++)
+		{
+			*KeptTris++ = FinalVerts[0];
+			*KeptTris++ = FinalVerts[VertexIndex - 1];
+			*KeptTris++ = FinalVerts[VertexIndex];
+		}
+
+		// If we are making the other half, triangulate that as well
+		if (OtherTris)
+		{
+			for (int32 VertexIndex = 2; VertexIndex < NumOtherFinalVerts; VertexIndex++)
+			{
+				*OtherTris++ = OtherFinalVerts[0];
+				*OtherTris++ = OtherFinalVerts[VertexIndex - 1];
+				*OtherTris++ = OtherFinalVerts[VertexIndex];
+			}
+		}
+
+		OutResult.ClipEdges[SplitIdx] = NewClipEdge;
+	});
+
+	// 7. Section 状态与包围盒
+	auto FinishSection = [&BaseSection](FVisMeshSection& Section)
+	{
+		Section.SectionLocalBox = VisMeshComputeBounds(Section.Data.Positions);
+		Section.bEnableCollision = BaseSection.bEnableCollision;
+		Section.bSectionVisible = BaseSection.bSectionVisible;
+		Section.ActiveScalarChannel = BaseSection.ActiveScalarChannel;
+	};
+	FinishSection(OutResult.Kept);
+	if (bCreateOtherHalf)
+	{
+		FinishSection(OutResult.Other);
+	}
+}
+
+/** 按重心坐标组合三角形三个角点的属性，写入预分配好的目标 SOA (可并行调用) */
+void VisMeshWriteBarycentricVertex(FVisMeshData& Dest, int32 DestIdx, const FVisMeshData& Src, const int32 Corners[3], const FVector3f& Bary)
+{
+	auto Blend = [&Bary](const auto& A, const auto& B, const auto& C)
+	{
+		return A * Bary.X + B * Bary.Y + C * Bary.Z;
+	};
+
+	Dest.Positions[DestIdx] = Blend(Src.Positions[Corners[0]], Src.Positions[Corners[1]], Src.Positions[Corners[2]]);
+	if (Dest.Normals.Num() > 0) Dest.Normals[DestIdx] = Blend(Src.Normals[Corners[0]], Src.Normals[Corners[1]], Src.Normals[Corners[2]]);
+	if (Dest.Tangents.Num() > 0)
+	{
+		Dest.Tangents[DestIdx].TangentX = Blend(Src.Tangents[Corners[0]].TangentX, Src.Tangents[Corners[1]].TangentX, Src.Tangents[Corners[2]].TangentX);
+		Dest.Tangents[DestIdx].bFlipTangentY = Src.Tangents[Corners[0]].bFlipTangentY;
+	}
+	if (Dest.Colors.Num() > 0)
+	{
+		const FLinearColor Color = Blend(FLinearColor(Src.Colors[Corners[0]].ReinterpretAsLinear()), FLinearColor(Src.Colors[Corners[1]].ReinterpretAsLinear()), FLinearColor(Src.Colors[Corners[2]].ReinterpretAsLinear()));
+		Dest.Colors[DestIdx] = Color.QuantizeRound();
+	}
+	if (Dest.UV0.Num() > 0) Dest.UV0[DestIdx] = Blend(Src.UV0[Corners[0]], Src.UV0[Corners[1]], Src.UV0[Corners[2]]);
+	if (Dest.UV1.Num() > 0) Dest.UV1[DestIdx] = Blend(Src.UV1[Corners[0]], Src.UV1[Corners[1]], Src.UV1[Corners[2]]);
+	if (Dest.UV2.Num() > 0) Dest.UV2[DestIdx] = Blend(Src.UV2[Corners[0]], Src.UV2[Corners[1]], Src.UV2[Corners[2]]);
+	if (Dest.UV3.Num() > 0) Dest.UV3[DestIdx] = Blend(Src.UV3[Corners[0]], Src.UV3[Corners[1]], Src.UV3[Corners[2]]);
+	for (int32 Channel = 0; Channel < Dest.Scalars.Num(); Channel++)
+	{
+		const TArray<float>& Values = Src.Scalars[Channel].Values;
+		if (Dest.Scalars[Channel].Values.Num() > 0) Dest.Scalars[Channel].Values[DestIdx] = Blend(Values[Corners[0]], Values[Corners[1]], Values[Corners[2]]);
+	}
+}
+
+/** 三角形被多个平面裁剪后的多边形顶点 */
+struct FVisMeshClipVertex
+{
+	/** 相对原三角形三个角点的重心坐标 */
+	FVector3f Bary;
+	/** 若为原始角点则为 0~2，插值点为 INDEX_NONE */
+	int32 Corner;
+	/** 从本顶点出发的边位于哪个裁剪平面上 (原三角形的边为 INDEX_NONE)，用于生成 Cap */
+	int32 EdgePlane;
+};
+
+using FVisMeshClipPolygon = TArray<FVisMeshClipVertex, TInlineAllocator<16>>;
+
+/**
+ *	Sutherland-Hodgman：依次用每个平面裁剪三角形 (正侧保留)
+ *	插值点的距离由重心坐标直接组合角点距离得到，不需要重新计算位置
+ *	@param	CornerDist	CornerDist[PlaneIdx * 3 + Corner]，角点到每个平面的距离
+ */
+void VisMeshClipTriangleByPlanes(const float* CornerDist, int32 NumPlanes, FVisMeshClipPolygon& OutPoly)
+{
+	OutPoly.Reset();
+	OutPoly.Add({ FVector3f(1.f, 0.f, 0.f), 0, INDEX_NONE });
+	OutPoly.Add({ FVector3f(0.f, 1.f, 0.f), 1, INDEX_NONE });
+	OutPoly.Add({ FVector3f(0.f, 0.f, 1.f), 2, INDEX_NONE });
+
+	FVisMeshClipPolygon Clipped;
+	for (int32 PlaneIdx = 0; PlaneIdx < NumPlanes && OutPoly.Num() >= 3; PlaneIdx++)
+	{
+		const FVector3f Dist(CornerDist[PlaneIdx * 3 + 0], CornerDist[PlaneIdx * 3 + 1], CornerDist[PlaneIdx * 3 + 2]);
+		Clipped.Reset();
+
+		for (int32 ThisVert = 0; ThisVert < OutPoly.Num(); ThisVert++)
+		{
+			const FVisMeshClipVertex& A = OutPoly[ThisVert];
+			const FVisMeshClipVertex& B = OutPoly[(ThisVert + 1) % OutPoly.Num()];
+			const float DistA = A.Bary | Dist;
+			const float DistB = B.Bary | Dist;
+			const bool bKeptA = DistA > 0.f;
+			const bool bKeptB = DistB > 0.f;
+
+			if (bKeptA)
+			{
+				Clipped.Add(A);
+			}
+
+			if (bKeptA != bKeptB)
+			{
+				const float Alpha = FMath::Clamp(-DistA / (DistB - DistA), 0.0f, 1.0f);
+				// 离开正侧时产生的新边落在当前平面上，进入正侧时新点仍在原来的边上
+				Clipped.Add({ FMath::Lerp(A.Bary, B.Bary, Alpha), INDEX_NONE, bKeptA ? PlaneIdx : A.EdgePlane });
+			}
+		}
+
+		Swap(OutPoly, Clipped);
+	}
+
+	if (OutPoly.Num() < 3)
+	{
+		OutPoly.Reset();
+	}
+}
+
+/** 单个 Section 被一组平面裁剪后的结果 */
+struct FVisMeshSectionClipResult
+{
+	/** 所有平面正侧保留的几何 */
+	FVisMeshSection Kept;
+	/** 裁剪在各平面上产生的新边 */
+	TArray<FUtilEdge3D> ClipEdges;
+	/** ClipEdges 中每条边所在的平面 */
+	TArray<int32> ClipEdgePlanes;
+};
+
+/** 用一组平面一次性裁剪一个 Section，流程与 VisMeshSliceSection 相同：分类 -> 前缀和 -> 并行写入 */
+void VisMeshClipSection(const FVisMeshSection& BaseSection, TArrayView<const FPlane> ClipPlanes, FVisMeshSectionClipResult& OutResult)
+{
+	const FVisMeshData& Src = BaseSection.Data;
+	const int32 NumBaseVerts = Src.NumVertices();
+	const TArray<int32>& SrcTris = Src.GetTriangles();
+	const int32 NumTris = SrcTris.Num() / 3;
+	const int32 NumPlanes = ClipPlanes.Num();
+
+	// 1. 顶点分类：到每个平面的距离，全部为正的顶点保留
+	TArray<float> VertDistance;
+	TArray<int32> KeptRemap;
+	VertDistance.SetNumUninitialized(NumBaseVerts * NumPlanes);
+	KeptRemap.SetNumUninitialized(NumBaseVerts);
+
+	ParallelFor(NumBaseVerts, [&](int32 VertIdx)
+	{
+		bool bKept = true;
+		for (int32 PlaneIdx = 0; PlaneIdx < NumPlanes; PlaneIdx++)
+		{
+			const float Dist = ClipPlanes[PlaneIdx].PlaneDot(Src.Positions[VertIdx]);
+			VertDistance[VertIdx * NumPlanes + PlaneIdx] = Dist;
+			bKept &= Dist > 0.f;
+		}
+		KeptRemap[VertIdx] = bKept ? 1 : 0;
+	});
+
+	const int32 NumKeptVerts = VisMeshExclusiveScan(KeptRemap);
+
+	auto GatherCornerDist = [&](int32 TriIdx, float* OutCornerDist, bool& bOutAllKept, bool& bOutAllCulled)
+	{
+		bOutAllKept = true;
+		bOutAllCulled = false;
+		for (int32 PlaneIdx = 0; PlaneIdx < NumPlanes; PlaneIdx++)
+		{
+			int32 NumKeptCorners = 0;
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const float Dist = VertDistance[SrcTris[TriIdx * 3 + Corner] * NumPlanes + PlaneIdx];
+				OutCornerDist[PlaneIdx * 3 + Corner] = Dist;
+				NumKeptCorners += Dist > 0.f ? 1 : 0;
+			}
+			bOutAllKept &= NumKeptCorners == 3;
+			bOutAllCulled |= NumKeptCorners == 0;
+		}
+	};
+
+	// 2. 三角形分类：输出三角形数、插值顶点数、Cap 边数
+	TArray<int32> TriOffset, InterpOffset, EdgeOffset;
+	TriOffset.SetNumUninitialized(NumTris);
+	InterpOffset.SetNumUninitialized(NumTris);
+	EdgeOffset.SetNumUninitialized(NumTris);
+
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		TArray<float, TInlineAllocator<24>> CornerDist;
+		CornerDist.SetNumUninitialized(NumPlanes * 3);
+		bool bAllKept, bAllCulled;
+		GatherCornerDist(TriIdx, CornerDist.GetData(), bAllKept, bAllCulled);
+
+		TriOffset[TriIdx] = bAllKept ? 1 : 0;
+		InterpOffset[TriIdx] = 0;
+		EdgeOffset[TriIdx] = 0;
+		if (bAllKept || bAllCulled)
+		{
+			return;
+		}
+
+		FVisMeshClipPolygon Poly;
+		VisMeshClipTriangleByPlanes(CornerDist.GetData(), NumPlanes, Poly);
+		TriOffset[TriIdx] = FMath::Max(Poly.Num() - 2, 0);
+		for (const FVisMeshClipVertex& Vertex : Poly)
+		{
+			InterpOffset[TriIdx] += Vertex.Corner == INDEX_NONE ? 1 : 0;
+			EdgeOffset[TriIdx] += Vertex.EdgePlane != INDEX_NONE ? 1 : 0;
+		}
+	});
+
+	const int32 NumKeptTris = VisMeshExclusiveScan(TriOffset);
+	const int32 NumInterpVerts = VisMeshExclusiveScan(InterpOffset);
+	const int32 NumClipEdges = VisMeshExclusiveScan(EdgeOffset);
+
+	// 3. 一次性分配输出
+	FVisMeshData& Kept = OutResult.Kept.Data;
+	VisMeshAllocateLike(Kept, Src, NumKeptVerts + NumInterpVerts, NumKeptTris * 3);
+	OutResult.ClipEdges.SetNumUninitialized(NumClipEdges);
+	OutResult.ClipEdgePlanes.SetNumUninitialized(NumClipEdges);
+
+	// 4. 并行写入保留的原始顶点
+	ParallelFor(NumBaseVerts, [&](int32 VertIdx)
+	{
+		bool bKept = true;
+		for (int32 PlaneIdx = 0; PlaneIdx < NumPlanes; PlaneIdx++)
+		{
+			bKept &= VertDistance[VertIdx * NumPlanes + PlaneIdx] > 0.f;
+		}
+		if (bKept)
+		{
+			VisMeshWriteVertex(Kept, KeptRemap[VertIdx], Src, VertIdx);
+		}
+	});
+
+	// 5. 并行写入三角形、插值顶点与 Cap 边
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		const int32 NumOutTris = (TriIdx + 1 < NumTris ? TriOffset[TriIdx + 1] : NumKeptTris) - TriOffset[TriIdx];
+		if (NumOutTris == 0)
+		{
+			return;
+		}
+
+		const int32 Corners[3] = { SrcTris[TriIdx * 3 + 0], SrcTris[TriIdx * 3 + 1], SrcTris[TriIdx * 3 + 2] };
+		int32* OutTris = Kept.Triangles.GetData() + TriOffset[TriIdx] * 3;
+
+		TArray<float, TInlineAllocator<24>> CornerDist;
+		CornerDist.SetNumUninitialized(NumPlanes * 3);
+		bool bAllKept, bAllCulled;
+		GatherCornerDist(TriIdx, CornerDist.GetData(), bAllKept, bAllCulled);
+
+		if (bAllKept)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++) OutTris[Corner] = KeptRemap[Corners[Corner]];
+			return;
+		}
+
+		FVisMeshClipPolygon Poly;
+		VisMeshClipTriangleByPlanes(CornerDist.GetData(), NumPlanes, Poly);
+
+		TArray<int32, TInlineAllocator<16>> FinalVerts;
+		FinalVerts.SetNumUninitialized(Poly.Num());
+		int32 InterpVertIndex = NumKeptVerts + InterpOffset[TriIdx];
+		for (int32 PolyVert = 0; PolyVert < Poly.Num(); PolyVert++)
+		{
+			const FVisMeshClipVertex& Vertex = Poly[PolyVert];
+			if (Vertex.Corner != INDEX_NONE)
+			{
+				FinalVerts[PolyVert] = KeptRemap[Corners[Vertex.Corner]];
+			}
+			else
+			{
+				VisMeshWriteBarycentricVertex(Kept, InterpVertIndex, Src, Corners, Vertex.Bary);
+				FinalVerts[PolyVert] = InterpVertIndex++;
+			}
+		}
+
+		// 落在裁剪平面上的边
+		int32 EdgeIndex = EdgeOffset[TriIdx];
+		for (int32 PolyVert = 0; PolyVert < Poly.Num(); PolyVert++)
+		{
+			if (Poly[PolyVert].EdgePlane != INDEX_NONE)
+			{
+				FUtilEdge3D& Edge = OutResult.ClipEdges[EdgeIndex];
+				Edge.V0 = (FVector3f)Kept.Positions[FinalVerts[PolyVert]];
+				Edge.V1 = (FVector3f)Kept.Positions[FinalVerts[(PolyVert + 1) % Poly.Num()]];
+				OutResult.ClipEdgePlanes[EdgeIndex] = Poly[PolyVert].EdgePlane;
+				EdgeIndex++;
+			}
+		}
+
+		// Triangulate the clipped polygon.
+		for (int32 VertexIndex = 2; VertexIndex < FinalVerts.Num(); VertexIndex++)
+		{
+			*OutTris++ = FinalVerts[0];
+			*OutTris++ = FinalVerts[VertexIndex - 1];
+			*OutTris++ = FinalVerts[VertexIndex];
+		}
+	});
+
+	OutResult.Kept.SectionLocalBox = VisMeshComputeBounds(Kept.Positions);
+	OutResult.Kept.bEnableCollision = BaseSection.bEnableCollision;
+	OutResult.Kept.bSectionVisible = BaseSection.bSectionVisible;
+	OutResult.Kept.ActiveScalarChannel = BaseSection.ActiveScalarChannel;
+}
+
+/**
+ *	收集 Section 与平面的交线段 (只访问三角形，不生成任何几何)
+ *	交点总是从正侧顶点向负侧顶点插值，相邻三角形共享的边得到相同的交点
+ */
+void VisMeshGetSectionPlaneEdges(const FVisMeshSection& Section, const FPlane& SlicePlane, TArray<FUtilEdge3D>& OutEdges)
+{
+	const FVisMeshData& Src = Section.Data;
+	const int32 NumVerts = Src.NumVertices();
+	const TArray<int32>& SrcTris = Src.GetTriangles();
+	const int32 NumTris = SrcTris.Num() / 3;
+
+	TArray<float> VertDistance;
+	VertDistance.SetNumUninitialized(NumVerts);
+	ParallelFor(NumVerts, [&](int32 VertIdx)
+	{
+		VertDistance[VertIdx] = SlicePlane.PlaneDot(Src.Positions[VertIdx]);
+	});
+
+	// 每个被切开的三角形恰好产生一条边
+	TArray<int32> EdgeOffset;
+	EdgeOffset.SetNumUninitialized(NumTris);
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		int32 NumKeptCorners = 0;
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			NumKeptCorners += VertDistance[SrcTris[TriIdx * 3 + Corner]] > 0.f ? 1 : 0;
+		}
+		EdgeOffset[TriIdx] = (NumKeptCorners == 1 || NumKeptCorners == 2) ? 1 : 0;
+	});
+
+	const int32 EdgeBase = OutEdges.Num();
+	const int32 NumEdges = VisMeshExclusiveScan(EdgeOffset);
+	OutEdges.AddUninitialized(NumEdges);
+
+	ParallelFor(NumTris, [&](int32 TriIdx)
+	{
+		const int32 NextOffset = TriIdx + 1 < NumTris ? EdgeOffset[TriIdx + 1] : NumEdges;
+		if (NextOffset == EdgeOffset[TriIdx])
+		{
+			return;
+		}
+
+		FVector3f Crossings[2];
+		int32 NumCrossings = 0;
+		for (int32 ThisVert = 0; ThisVert < 3; ThisVert++)
+		{
+			int32 V0 = SrcTris[TriIdx * 3 + ThisVert];
+			int32 V1 = SrcTris[TriIdx * 3 + (ThisVert + 1) % 3];
+			if ((VertDistance[V0] > 0.f) != (VertDistance[V1] > 0.f))
+			{
+				if (VertDistance[V0] <= 0.f)
+				{
+					Swap(V0, V1);
+				}
+				const float Alpha = FMath::Clamp(VertDistance[V0] / (VertDistance[V0] - VertDistance[V1]), 0.0f, 1.0f);
+				Crossings[NumCrossings++] = (FVector3f)FMath::Lerp(Src.Positions[V0], Src.Positions[V1], Alpha);
+			}
+		}
+		check(NumCrossings == 2);
+
+		FUtilEdge3D& Edge = OutEdges[EdgeBase + EdgeOffset[TriIdx]];
+		Edge.V0 = Crossings[0];
+		Edge.V1 = Crossings[1];
+	});
+}
+
+/** 将边集合按端点连接成折线：先从奇数度的端点出发得到开放折线，剩下的都是闭合环 */
+void VisMeshChainEdges(const TArray<FUtilEdge3D>& Edges, TArray<TArray<FVector3f>>& OutPolylines, TArray<bool>& OutClosed)
+{
+	// 端点焊接 (容差内视为同一点)
+	TArray<FVector> EndPoints;
+	EndPoints.SetNumUninitialized(Edges.Num() * 2);
+	for (int32 EdgeIdx = 0; EdgeIdx < Edges.Num(); EdgeIdx++)
+	{
+		EndPoints[EdgeIdx * 2 + 0] = (FVector)Edges[EdgeIdx].V0;
+		EndPoints[EdgeIdx * 2 + 1] = (FVector)Edges[EdgeIdx].V1;
+	}
+	// 交点以 float 存储，容差随坐标绝对值放大 (约几个 ulp)，否则远离原点时相邻三角形的交点无法焊接
+	const FBox EndPointBox = VisMeshComputeBounds(EndPoints);
+	const double Tolerance = FMath::Max(UE_KINDA_SMALL_NUMBER, FMath::Max(EndPointBox.Min.GetAbsMax(), EndPointBox.Max.GetAbsMax()) * 1e-6);
+	TArray<int32> WeldRep;
+	VisMeshWeldOverlappingVerts(EndPoints, WeldRep, Tolerance);
+
+	TArray<FVector3f> Points;
+	TArray<int32> EdgePoints;
+	EdgePoints.SetNumUninitialized(EndPoints.Num());
+	for (int32 Slot = 0; Slot < EndPoints.Num(); Slot++)
+	{
+		// 代表点总是组内下标最小的，先于组内其它点被访问
+		EdgePoints[Slot] = WeldRep[Slot] == Slot ? Points.Add((FVector3f)EndPoints[Slot]) : EdgePoints[WeldRep[Slot]];
+	}
+
+	// 点 -> 边 的 CSR 邻接表
+	TArray<int32> AdjOffsets, AdjEdges;
+	AdjOffsets.Init(0, Points.Num() + 1);
+	for (const int32 PointId : EdgePoints)
+	{
+		AdjOffsets[PointId + 1]++;
+	}
+	for (int32 PointId = 0; PointId < Points.Num(); PointId++)
+	{
+		AdjOffsets[PointId + 1] += AdjOffsets[PointId];
+	}
+	AdjEdges.SetNumUninitialized(EdgePoints.Num());
+	{
+		TArray<int32> Cursor(AdjOffsets.GetData(), Points.Num());
+		for (int32 Slot = 0; Slot < EdgePoints.Num(); Slot++)
+		{
+			AdjEdges[Cursor[EdgePoints[Slot]]++] = Slot / 2;
+		}
+	}
+
+	TBitArray<> EdgeUsed(false, Edges.Num());
+	auto Walk = [&](int32 StartPoint)
+	{
+		TArray<FVector3f>& Polyline = OutPolylines.AddDefaulted_GetRef();
+		Polyline.Add(Points[StartPoint]);
+
+		int32 Point = StartPoint;
+		for (;;)
+		{
+			int32 NextEdge = INDEX_NONE;
+			for (int32 Adj = AdjOffsets[Point]; Adj < AdjOffsets[Point + 1]; Adj++)
+			{
+				if (!EdgeUsed[AdjEdges[Adj]])
+				{
+					NextEdge = AdjEdges[Adj];
+					break;
+				}
+			}
+			if (NextEdge == INDEX_NONE)
+			{
+				break;
+			}
+
+			EdgeUsed[NextEdge] = true;
+			Point = EdgePoints[NextEdge * 2] == Point ? EdgePoints[NextEdge * 2 + 1] : EdgePoints[NextEdge * 2];
+			if (Point == StartPoint)
+			{
+				break;
+			}
+			Polyline.Add(Points[Point]);
+		}
+
+		OutClosed.Add(Point == StartPoint && Polyline.Num() > 2);
+	};
+
+	for (int32 PointId = 0; PointId < Points.Num(); PointId++)
+	{
+		if ((AdjOffsets[PointId + 1] - AdjOffsets[PointId]) % 2 == 1)
+		{
+			Walk(PointId);
+		}
+	}
+	for (int32 EdgeIdx = 0; EdgeIdx < Edges.Num(); EdgeIdx++)
+	{
+		if (!EdgeUsed[EdgeIdx])
+		{
+			Walk(EdgePoints[EdgeIdx * 2]);
+		}
+	}
+}
+
+/** 由切割平面上的边生成 Cap 几何并追加到 CapSection */
+void VisMeshAppendCap(FVisMeshSection& CapSection, const TArray<FUtilEdge3D>& ClipEdges, const FPlane& SlicePlane)
+{
+	// Project 3D edges onto slice plane (only the plane frame is needed, loops are chained in 3D)
+	TArray<FUtilEdge2D> Edges2D;
+	FUtilPoly2DSet PolySet;
+	FGeomTools::ProjectEdges(Edges2D, PolySet.PolyToWorld, ClipEdges, SlicePlane);
+
+	// Chain the edge soup into loops (hash welding, linear instead of the quadratic Buid2DPolysFromEdges)
+	TArray<TArray<FVector3f>> Polylines;
+	TArray<bool> Closed;
+	VisMeshChainEdges(ClipEdges, Polylines, Closed);
+
+	for (int32 LoopIdx = 0; LoopIdx < Polylines.Num(); LoopIdx++)
+	{
+		if (Closed[LoopIdx] && Polylines[LoopIdx].Num() >= 3)
+		{
+			FUtilPoly2D& Poly = PolySet.Polys.AddDefaulted_GetRef();
+			for (const FVector3f& Point : Polylines[LoopIdx])
+			{
+				const FVector LocalPos = PolySet.PolyToWorld.InverseTransformPosition((FVector)Point);
+				Poly.Verts.Add(FUtilVertex2D(FVector2D(LocalPos.X, LocalPos.Y)));
+			}
+		}
+	}
+
+	// 追加到已有 Section 时需要可修改的索引
+	CapSection.Data.MakeTrianglesUnique();
+	const int32 CapVertBase = CapSection.Data.Positions.Num();
+	const int32 CapIndexBase = CapSection.Data.Triangles.Num();
+
+	TArray<TArray<FVector2D>> Loops;
+	TArray<int32> PolyVertBases;
+	for (int32 PolyIdx = 0; PolyIdx < PolySet.Polys.Num(); PolyIdx++)
+	{
+		// Generate UVs for the 2D polygon.
+		FGeomTools::GeneratePlanarTilingPolyUVs(PolySet.Polys[PolyIdx], 64.f);
+
+		// Remember start of vert buffer before adding triangles for this poly
+		PolyVertBases.Add(CapSection.Data.Positions.Num());
+
+		// Transform from 2D poly verts to 3D (Updated SOA version)
+		VisMeshTransform2DPolygonTo3D(PolySet.Polys[PolyIdx], PolySet.PolyToWorld, CapSection.Data, CapSection.SectionLocalBox);
+
+		TArray<FVector2D>& Loop = Loops.AddDefaulted_GetRef();
+		for (const FUtilVertex2D& Vertex : PolySet.Polys[PolyIdx].Verts)
+		{
+			Loop.Add(Vertex.Pos);
+		}
+	}
+
+	const FVector3f PolyNormal = (FVector3f)SlicePlane.GetNormal();
+
+	// 所有轮廓一起三角化，洞不会被填上；退化输入时退回逐个多边形的耳切法
+	TArray<int32> LoopTris;
+	if (VisMeshTriangulatePolygonSet(Loops, LoopTris))
+	{
+		for (int32 Index = 0; Index < LoopTris.Num(); Index += 3)
+		{
+			int32 Tri[3];
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Tri[Corner] = CapVertBase + LoopTris[Index + Corner];
+			}
+
+			// 与耳切法保持相同的朝向
+			const FVector3f P0 = (FVector3f)CapSection.Data.Positions[Tri[0]];
+			const FVector3f P1 = (FVector3f)CapSection.Data.Positions[Tri[1]];
+			const FVector3f P2 = (FVector3f)CapSection.Data.Positions[Tri[2]];
+			if ((((P1 - P0) ^ (P2 - P0)) | PolyNormal) < 0.f)
+			{
+				Swap(Tri[1], Tri[2]);
+			}
+			CapSection.Data.Triangles.Append(Tri, 3);
+		}
+	}
+	else
+	{
+		CapSection.Data.Triangles.SetNum(CapIndexBase);
+		for (int32 PolyIdx = 0; PolyIdx < PolyVertBases.Num(); PolyIdx++)
+		{
+			// 耳切法会处理 VertBase 之后的全部顶点，因此每个多边形单独拷贝一份位置
+			FVisMeshData PolyData;
+			PolyData.Positions.Append(CapSection.Data.Positions.GetData() + PolyVertBases[PolyIdx], Loops[PolyIdx].Num());
+
+			TArray<int32> PolyTris;
+			VisMeshTriangulatePoly(PolyTris, PolyData, 0, PolyNormal);
+			for (const int32 Index : PolyTris)
+			{
+				CapSection.Data.Triangles.Add(PolyVertBases[PolyIdx] + Index);
+			}
+		}
+	}
+}
+
+void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh, FVector PlanePosition,FVector PlaneNormal, bool bCreateOtherHalf, UVisMeshProceduralComponent*& OutOtherHalfProcMesh,EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial)
+{
+	if (InProcMesh != nullptr)
+	{
+		// Transform plane from world to local space
+		FTransform ProcCompToWorld = InProcMesh->GetComponentToWorld();
+		FVector LocalPlanePos = ProcCompToWorld.InverseTransformPosition(PlanePosition);
+		FVector LocalPlaneNormal = ProcCompToWorld.InverseTransformVectorNoScale(PlaneNormal);
+		LocalPlaneNormal = LocalPlaneNormal.GetSafeNormal(); // Ensure normalized
+
+		FPlane SlicePlane(LocalPlanePos, LocalPlaneNormal);
+
+		// Set of sections to add to the 'other half' component
+		TArray<FVisMeshSection> OtherSections;
+		// Material for each section of other half
+		TArray<UMaterialInterface*> OtherMaterials;
+
+		// Set of new edges created by clipping polys by plane
+		TArray<FUtilEdge3D> ClipEdges;
+
+		// Sections to replace on the input component, applied in one batch at the end
+		TArray<int32> UpdatedSectionIndices;
+		TArray<FVisMeshSection> UpdatedSections;
+		auto SetUpdatedSection = [&](int32 SectionIndex, FVisMeshSection&& Section)
+		{
+			const int32 Existing = UpdatedSectionIndices.Find(SectionIndex);
+			if (Existing != INDEX_NONE)
+			{
+				UpdatedSections[Existing] = MoveTemp(Section);
+			}
+			else
+			{
+				UpdatedSectionIndices.Add(SectionIndex);
+				UpdatedSections.Add(MoveTemp(Section));
+			}
+		};
+
+		// 1. 每个 Section 与平面的包围盒关系 (INDEX_NONE 表示没有几何)
+		const int32 NumSections = InProcMesh->GetNumSections();
+		TArray<const FVisMeshSection*> BaseSections;
+		TArray<int32> BoxCompares;
+		BaseSections.SetNumZeroed(NumSections);
+		BoxCompares.Init(INDEX_NONE, NumSections);
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			const FVisMeshSection* BaseSection = InProcMesh->GetVisMeshSection(SectionIndex);
+			// If we have a section, and it has some valid geom
+			if (BaseSection != nullptr && BaseSection->Data.NumIndices() > 0 && BaseSection->Data.Positions.Num() > 0)
+			{
+				BaseSections[SectionIndex] = BaseSection;
+				BoxCompares[SectionIndex] = VisMeshBoxPlaneCompare(BaseSection->SectionLocalBox, SlicePlane);
+			}
+		}
+
+		// 2. 被平面穿过的 Section 并行切割 (Section 内部各阶段也是并行的)
+		TArray<FVisMeshSectionSliceResult> SliceResults;
+		SliceResults.SetNum(NumSections);
+		ParallelFor(NumSections, [&](int32 SectionIndex)
+		{
+			if (BoxCompares[SectionIndex] == 0)
+			{
+				VisMeshSliceSection(*BaseSections[SectionIndex], SlicePlane, bCreateOtherHalf, SliceResults[SectionIndex]);
+			}
+		});
+
+		// 3. 按 Section 顺序汇总结果
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			// Box totally clipped, clear section
+			if (BoxCompares[SectionIndex] == -1)
+			{
+				// Add entire section to other half
+				if (bCreateOtherHalf)
+				{
+					OtherSections.Add(*BaseSections[SectionIndex]);
+					OtherMaterials.Add(InProcMesh->GetMaterial(SectionIndex));
+				}
+
+				SetUpdatedSection(SectionIndex, FVisMeshSection());
+			}
+			// Box intersects plane, need to clip some polys!
+			else if (BoxCompares[SectionIndex] == 0)
 			{
-				// Compare bounding box of section with slicing plane
-				int32 BoxCompare = VisMeshBoxPlaneCompare(BaseSection->SectionLocalBox, SlicePlane);
+				FVisMeshSectionSliceResult& Result = SliceResults[SectionIndex];
 
-				// Box totally clipped, clear section
-				if (BoxCompare == -1)
+				// Only keep 'other' section if it has valid geometry
+				if (bCreateOtherHalf && Result.Other.Data.Triangles.Num() > 0 && Result.Other.Data.Positions.Num() > 0)
 				{
-					// Add entire section to other half
-					if (bCreateOtherHalf)
-					{
-						OtherSections.Add(*BaseSection);
-						OtherMaterials.Add(InProcMesh->GetMaterial(SectionIndex));
-					}
-
-					InProcMesh->ClearMeshSection(SectionIndex);
+					OtherSections.Add(MoveTemp(Result.Other));
+					OtherMaterials.Add(InProcMesh->GetMaterial(SectionIndex)); // Remember material for this section
 				}
-				// Box totally on one side of plane, leave it alone, do nothing
-				else if (BoxCompare == 1)
+
+				ClipEdges.Append(Result.ClipEdges);
+
+				// If we have some valid geometry, update section, otherwise remove it
+				if (Result.Kept.Data.Triangles.Num() > 0 && Result.Kept.Data.Positions.Num() > 0)
 				{
-					// ...
+					SetUpdatedSection(SectionIndex, MoveTemp(Result.Kept));
 				}
-				// Box intersects plane, need to clip some polys!
 				else
 				{
-					// New section for geometry
-					FVisMeshSection NewSection;
-
-					// New section for 'other half' geometry (if desired)
-					FVisMeshSection* NewOtherSection = nullptr;
-					if (bCreateOtherHalf)
-					{
-						int32 OtherSectionIndex = OtherSections.Add(FVisMeshSection());
-						NewOtherSection = &OtherSections[OtherSectionIndex];
-
-						OtherMaterials.Add(InProcMesh->GetMaterial(SectionIndex)); // Remember material for this section
-					}
-
-					// Map of base vert index to sliced vert index
-					TMap<int32, int32> BaseToSlicedVertIndex;
-					TMap<int32, int32> BaseToOtherSlicedVertIndex;
-
-					const int32 NumBaseVerts = BaseSection->Data.Positions.Num();
-					
-					// Distance of each base vert from slice plane
-					TArray<float> VertDistance;
-					VertDistance.AddUninitialized(NumBaseVerts);
-
-					// Build vertex buffer 
-					for (int32 BaseVertIndex = 0; BaseVertIndex < NumBaseVerts; BaseVertIndex++)
-					{
-						const FVector& BasePos = BaseSection->Data.Positions[BaseVertIndex];
-						
-						// Calc distance from plane
-						VertDistance[BaseVertIndex] = SlicePlane.PlaneDot(BasePos);
-						
-						// See if vert is being kept in this section
-						if (VertDistance[BaseVertIndex] > 0.f)
-						{
-							// Changed: Copy to sliced v buffer using SOA Helper
-							int32 SlicedVertIndex = VisMeshCopyVertex(NewSection.Data, BaseSection->Data, BaseVertIndex);
-							// Update section bounds
-							NewSection.SectionLocalBox += BasePos;
-							// Add to map
-							BaseToSlicedVertIndex.Add(BaseVertIndex, SlicedVertIndex);
-						}
-						// Or add to other half if desired
-						else if(NewOtherSection != nullptr)
-						{
-							int32 SlicedVertIndex = VisMeshCopyVertex(NewOtherSection->Data, BaseSection->Data, BaseVertIndex);
-							NewOtherSection->SectionLocalBox += BasePos;
-							BaseToOtherSlicedVertIndex.Add(BaseVertIndex, SlicedVertIndex);
-						}
-					}
-
-
-					// Iterate over base triangles (ie 3 indices at a time)
-					for (int32 BaseIndex = 0; BaseIndex < BaseSection->Data.Triangles.Num(); BaseIndex += 3)
-					{
-						int32 BaseV[3]; // Triangle vert indices in original mesh
-						int32* SlicedV[3]; // Pointers to vert indices in new v buffer
-						int32* SlicedOtherV[3]; // Pointers to vert indices in new 'other half' v buffer
-
-						// For each vertex..
-						for (int32 i = 0; i < 3; i++)
-						{
-							// Get triangle vert index
-							BaseV[i] = BaseSection->Data.Triangles[BaseIndex + i];
-							// Look up in sliced v buffer
-							SlicedV[i] = BaseToSlicedVertIndex.Find(BaseV[i]);
-							// Look up in 'other half' v buffer (if desired)
-							if (bCreateOtherHalf)
-							{
-								SlicedOtherV[i] = BaseToOtherSlicedVertIndex.Find(BaseV[i]);
-								// Each base vert _must_ exist in either BaseToSlicedVertIndex or BaseToOtherSlicedVertIndex 
-								check((SlicedV[i] != nullptr) != (SlicedOtherV[i] != nullptr));
-							}
-						}
-
-						// If all verts survived plane cull, keep the triangle
-						if (SlicedV[0] != nullptr && SlicedV[1] != nullptr && SlicedV[2] != nullptr)
-						{
-							NewSection.Data.Triangles.Add(*SlicedV[0]);
-							NewSection.Data.Triangles.Add(*SlicedV[1]);
-							NewSection.Data.Triangles.Add(*SlicedV[2]);
-						}
-						// If all verts were removed by plane cull
-						else if (SlicedV[0] == nullptr && SlicedV[1] == nullptr && SlicedV[2] == nullptr)
-						{
-							// If creating other half, add all verts to that
-							if (NewOtherSection != nullptr)
-							{
-								NewOtherSection->Data.Triangles.Add(*SlicedOtherV[0]);
-								NewOtherSection->Data.Triangles.Add(*SlicedOtherV[1]);
-								NewOtherSection->Data.Triangles.Add(*SlicedOtherV[2]);
-							}
-						}
-						// If partially culled, clip to create 1 or 2 new triangles
-						else
-						{
-							int32 FinalVerts[4];
-							int32 NumFinalVerts = 0;
-
-							int32 OtherFinalVerts[4];
-							int32 NumOtherFinalVerts = 0;
-
-							FUtilEdge3D NewClipEdge;
-							int32 ClippedEdges = 0;
-
-							float PlaneDist[3];
-							PlaneDist[0] = VertDistance[BaseV[0]];
-							PlaneDist[1] = VertDistance[BaseV[1]];
-							PlaneDist[2] = VertDistance[BaseV[2]];
-
-							for (int32 EdgeIdx = 0; EdgeIdx < 3; EdgeIdx++)
-							{
-								int32 ThisVert = EdgeIdx;
-
-								// If start vert is inside, add it.
-								if (SlicedV[ThisVert] != nullptr)
-								{
-									check(NumFinalVerts < 4);
-									FinalVerts[NumFinalVerts++] = *SlicedV[ThisVert];
-								}
-								// If not, add to other side
-								else if(bCreateOtherHalf)
-								{
-									check(NumOtherFinalVerts < 4);
-									OtherFinalVerts[NumOtherFinalVerts++] = *SlicedOtherV[ThisVert];
-								}
-
-								// If start and next vert are on opposite sides, add intersection
-								int32 NextVert = (EdgeIdx + 1) % 3;
-
-								if ((SlicedV[EdgeIdx] == nullptr) != (SlicedV[NextVert] == nullptr))
-								{
-									// Find distance along edge that plane is
-									float Alpha = -PlaneDist[ThisVert] / (PlaneDist[NextVert] - PlaneDist[ThisVert]);
-									// Interpolate vertex params to that point (SOA Helper)
-									// Add to vertex buffer
-									int32 InterpVertIndex = VisMeshInterpolateVertex(NewSection.Data, BaseSection->Data, BaseV[ThisVert], BaseV[NextVert], FMath::Clamp(Alpha, 0.0f, 1.0f));
-									const FVector InterpPos = NewSection.Data.Positions[InterpVertIndex];
-									// Update bounds
-									NewSection.SectionLocalBox += InterpPos;
-
-									// Save vert index for this poly
-									check(NumFinalVerts < 4);
-									FinalVerts[NumFinalVerts++] = InterpVertIndex;
-
-									// If desired, add to the poly for the other half as well
-									if (NewOtherSection != nullptr)
-									{
-										int32 OtherInterpVertIndex = VisMeshInterpolateVertex(NewOtherSection->Data, BaseSection->Data, BaseV[ThisVert], BaseV[NextVert], FMath::Clamp(Alpha, 0.0f, 1.0f));
-										NewOtherSection->SectionLocalBox += InterpPos;
-										check(NumOtherFinalVerts < 4);
-										OtherFinalVerts[NumOtherFinalVerts++] = OtherInterpVertIndex;
-									}
-
-									// When we make a new edge on the surface of the clip plane, save it off.
-									check(ClippedEdges < 2);
-									if (ClippedEdges == 0)
-									{
-										NewClipEdge.V0 = (FVector3f)InterpPos;
-									}
-									else
-									{
-										NewClipEdge.V1 = (FVector3f)InterpPos;
-									}
-
-									ClippedEdges++;
-								}
-							}
-
-							// Triangulate the clipped polygon.
-							for (int32 VertexIndex = 2; VertexIndex < NumFinalVerts; VertexIndex++)
-							{
-								NewSection.Data.Triangles.Add(FinalVerts[0]);
-								NewSection.Data.Triangles.Add(FinalVerts[VertexIndex - 1]);
-								NewSection.Data.Triangles.Add(FinalVerts[VertexIndex]);
-							}
-
-							// If we are making the other half, triangulate that as well
-							if (NewOtherSection != nullptr)
-							{
-								for (int32 VertexIndex = 2; VertexIndex < NumOtherFinalVerts; VertexIndex++)
-								{
-									NewOtherSection->Data.Triangles.Add(OtherFinalVerts[0]);
-									NewOtherSection->Data.Triangles.Add(OtherFinalVerts[VertexIndex - 1]);
-									NewOtherSection->Data.Triangles.Add(OtherFinalVerts[VertexIndex]);
-								}
-							}
-
-							check(ClippedEdges != 1); // Should never clip just one edge of the triangle
-
-							// If we created a new edge, save that off here as well
-							if (ClippedEdges == 2)
-							{
-								ClipEdges.Add(NewClipEdge);
-							}
-						}
-					}
-
-					// Remove 'other' section from array if no valid geometry for it
-					if (NewOtherSection != nullptr && (NewOtherSection->Data.Triangles.Num() == 0 || NewOtherSection->Data.Positions.Num() == 0))
-					{
-						OtherSections.RemoveAt(OtherSections.Num() - 1);
-					}
-
-					// If we have some valid geometry, update section
-					if (NewSection.Data.Triangles.Num() > 0 && NewSection.Data.Positions.Num() > 0)
-					{
-						// Assign new geom to this section
-						InProcMesh->SetVisMeshSection(SectionIndex, NewSection);
-					}
-					// If we don't, remove this section
-					else
-					{
-						InProcMesh->ClearMeshSection(SectionIndex);
-					}
+					SetUpdatedSection(SectionIndex, FVisMeshSection());
 				}
 			}
+			// Box totally on one side of plane, leave it alone, do nothing
 		}
 
 		// Create cap geometry (if some edges to create it from)
@@ -1107,48 +2515,26 @@ void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh
 			FVisMeshSection CapSection;
 			int32 CapSectionIndex = INDEX_NONE;
 
-			// If using an existing section, copy that info first
+			// If using an existing section, copy that info first (taking the pending sliced result into account)
 			if (CapOption == EVisMeshSliceCapOption::UseLastSectionForCap)
 			{
-				CapSectionIndex = InProcMesh->GetNumSections() - 1;
-				CapSection = *InProcMesh->GetVisMeshSection(CapSectionIndex);
+				CapSectionIndex = NumSections - 1;
+				const int32 PendingIndex = UpdatedSectionIndices.Find(CapSectionIndex);
+				CapSection = PendingIndex != INDEX_NONE ? UpdatedSections[PendingIndex] : *InProcMesh->GetVisMeshSection(CapSectionIndex);
+				CapSection.Data.MakeTrianglesUnique();
 			}
 			// Adding new section for cap
 			else
 			{
-				CapSectionIndex = InProcMesh->GetNumSections();
+				CapSectionIndex = NumSections;
 			}
 
-			// Project 3D edges onto slice plane to form 2D edges
-			TArray<FUtilEdge2D> Edges2D;
-			FUtilPoly2DSet PolySet;
-			FGeomTools::ProjectEdges(Edges2D, PolySet.PolyToWorld, ClipEdges, SlicePlane);
-
-			// Find 2D closed polygons from this edge soup
-			FGeomTools::Buid2DPolysFromEdges(PolySet.Polys, Edges2D, FColor(255, 255, 255, 255));
-
 			// Remember start point for vert and index buffer before adding and cap geom
 			int32 CapVertBase = CapSection.Data.Positions.Num();
 			int32 CapIndexBase = CapSection.Data.Triangles.Num();
 
-			// Triangulate each poly
-			for (int32 PolyIdx = 0; PolyIdx < PolySet.Polys.Num(); PolyIdx++)
-			{
-				// Generate UVs for the 2D polygon.
-				FGeomTools::GeneratePlanarTilingPolyUVs(PolySet.Polys[PolyIdx], 64.f);
-
-				// Remember start of vert buffer before adding triangles for this poly
-				int32 PolyVertBase = CapSection.Data.Positions.Num();
-
-				// Transform from 2D poly verts to 3D (Updated SOA version)
-				VisMeshTransform2DPolygonTo3D(PolySet.Polys[PolyIdx], PolySet.PolyToWorld, CapSection.Data, CapSection.SectionLocalBox);
-
-				// Triangulate this polygon (Updated SOA version)
-				VisMeshTriangulatePoly(CapSection.Data.Triangles, CapSection.Data, PolyVertBase, (FVector3f)LocalPlaneNormal);
-			}
-
-			// Set geom for cap section
-			InProcMesh->SetVisMeshSection(CapSectionIndex, CapSection);
+			// Project the clip edges onto the plane, find closed polygons and triangulate them
+			VisMeshAppendCap(CapSection, ClipEdges, SlicePlane);
 
 			// If creating new section for cap, assign cap material to it
 			if (CapOption == EVisMeshSliceCapOption::CreateNewSectionForCap)
@@ -1204,6 +2590,9 @@ void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh
 					OtherCapSection->Data.Triangles.Add(CapSection.Data.Triangles[IndexIdx + 1] + VertOffset);
 				}
 			}
+
+			// Set geom for cap section
+			SetUpdatedSection(CapSectionIndex, MoveTemp(CapSection));
 		}
 
 		// Array of sliced collision shapes
@@ -1255,8 +2644,8 @@ void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh
 			}
 		}
 
-		// Update collision of proc mesh
-		InProcMesh->SetCollisionConvexMeshes(SlicedCollision);
+		// Update geometry and collision of proc mesh in one batch (one collision cook)
+		InProcMesh->SetVisMeshSections(UpdatedSectionIndices, MoveTemp(UpdatedSections), &SlicedCollision);
 
 		// If creating other half, create component now
 		if (bCreateOtherHalf)
@@ -1267,20 +2656,19 @@ void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh
 			// Set transform to match source component
 			OutOtherHalfProcMesh->SetWorldTransform(InProcMesh->GetComponentTransform());
 
-			// Add each section of geometry
-			for (int32 SectionIndex = 0; SectionIndex < OtherSections.Num(); SectionIndex++)
-			{
-				OutOtherHalfProcMesh->SetVisMeshSection(SectionIndex, OtherSections[SectionIndex]);
-				OutOtherHalfProcMesh->SetMaterial(SectionIndex, OtherMaterials[SectionIndex]);
-			}
-
 			// Copy collision settings from input mesh
 			OutOtherHalfProcMesh->SetCollisionProfileName(InProcMesh->GetCollisionProfileName());
 			OutOtherHalfProcMesh->SetCollisionEnabled(InProcMesh->GetCollisionEnabled());
 			OutOtherHalfProcMesh->bUseComplexAsSimpleCollision = InProcMesh->bUseComplexAsSimpleCollision;
 
-			// Assign sliced collision
-			OutOtherHalfProcMesh->SetCollisionConvexMeshes(OtherSlicedCollision);
+			// Add each section of geometry, together with the sliced collision
+			TArray<int32> OtherSectionIndices;
+			for (int32 SectionIndex = 0; SectionIndex < OtherSections.Num(); SectionIndex++)
+			{
+				OtherSectionIndices.Add(SectionIndex);
+				OutOtherHalfProcMesh->SetMaterial(SectionIndex, OtherMaterials[SectionIndex]);
+			}
+			OutOtherHalfProcMesh->SetVisMeshSections(OtherSectionIndices, MoveTemp(OtherSections), &OtherSlicedCollision);
 
 			// Finally register
 			OutOtherHalfProcMesh->RegisterComponent();
@@ -1288,6 +2676,435 @@ void UKismetVisMeshLibrary::SliceVisMesh(UVisMeshProceduralComponent* InProcMesh
 	}
 }
 
+/**
+ *	多平面裁剪中平面 PlaneIdx 的 Cap。保留区域同时碰到多个平面时，该平面上的切割边在其它平面处断开 (开链)，
+ *	无法闭合成轮廓。因此先求原始 Section 在该平面上的完整截面 (闭合轮廓) 并三角化，
+ *	再用其它平面的半空间裁剪每个三角形 (凸多边形逐平面裁剪后扇形三角化)。
+ *	Cap 的属性在平面上是线性的，插值不会引入误差。
+ */
+static void VisMeshAppendClippedCap(FVisMeshSection& CapSection, TArrayView<const FVisMeshSection* const> BaseSections, TArrayView<const FPlane> ClipPlanes, int32 PlaneIdx)
+{
+	const FPlane& CapPlane = ClipPlanes[PlaneIdx];
+
+	// 1. 原始 Section 在该平面上的完整截面
+	TArray<TArray<FUtilEdge3D>> SectionEdges;
+	SectionEdges.SetNum(BaseSections.Num());
+	ParallelFor(BaseSections.Num(), [&](int32 i)
+	{
+		if (VisMeshBoxPlaneCompare(BaseSections[i]->SectionLocalBox, CapPlane) == 0)
+		{
+			VisMeshGetSectionPlaneEdges(*BaseSections[i], CapPlane, SectionEdges[i]);
+		}
+	});
+
+	TArray<FUtilEdge3D> PlaneEdges;
+	for (TArray<FUtilEdge3D>& Edges : SectionEdges)
+	{
+		PlaneEdges.Append(MoveTemp(Edges));
+	}
+
+	FVisMeshSection FullCap;
+	VisMeshAppendCap(FullCap, PlaneEdges, CapPlane);
+	const FVisMeshData& Full = FullCap.Data;
+
+	auto IsInside = [&](const FVector& Position)
+	{
+		for (int32 OtherIdx = 0; OtherIdx < ClipPlanes.Num(); OtherIdx++)
+		{
+			if (OtherIdx != PlaneIdx && ClipPlanes[OtherIdx].PlaneDot(Position) < 0.f)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// 2. 完全在其它平面正侧的三角形直接保留 (顶点共享)，其余逐平面裁剪
+	CapSection.Data.MakeTrianglesUnique();
+	TArray<int32> FullToCap;
+	FullToCap.Init(INDEX_NONE, Full.Positions.Num());
+	auto AddFullVertex = [&](int32 FullIdx)
+	{
+		if (FullToCap[FullIdx] == INDEX_NONE)
+		{
+			FullToCap[FullIdx] = VisMeshCopyVertex(CapSection.Data, Full, FullIdx);
+			CapSection.SectionLocalBox += Full.Positions[FullIdx];
+		}
+		return FullToCap[FullIdx];
+	};
+
+	TArray<bool> VertInside;
+	VertInside.SetNumUninitialized(Full.Positions.Num());
+	ParallelFor(Full.Positions.Num(), [&](int32 VertIdx)
+	{
+		VertInside[VertIdx] = IsInside(Full.Positions[VertIdx]);
+	});
+
+	for (int32 Index = 0; Index + 2 < Full.Triangles.Num(); Index += 3)
+	{
+		const int32 Corners[3] = { Full.Triangles[Index], Full.Triangles[Index + 1], Full.Triangles[Index + 2] };
+		if (VertInside[Corners[0]] && VertInside[Corners[1]] && VertInside[Corners[2]])
+		{
+			for (const int32 Corner : Corners)
+			{
+				CapSection.Data.Triangles.Add(AddFullVertex(Corner));
+			}
+			continue;
+		}
+
+		// Sutherland-Hodgman：三角形与凸区域求交，顶点属性随交点插值
+		FVisMeshData Poly;
+		TArray<int32, TInlineAllocator<16>> Ring;
+		for (const int32 Corner : Corners)
+		{
+			Ring.Add(VisMeshCopyVertex(Poly, Full, Corner));
+		}
+		for (int32 OtherIdx = 0; OtherIdx < ClipPlanes.Num() && Ring.Num() >= 3; OtherIdx++)
+		{
+			if (OtherIdx == PlaneIdx)
+			{
+				continue;
+			}
+
+			const FPlane& OtherPlane = ClipPlanes[OtherIdx];
+			TArray<int32, TInlineAllocator<16>> NewRing;
+			for (int32 RingIdx = 0; RingIdx < Ring.Num(); RingIdx++)
+			{
+				const int32 Cur = Ring[RingIdx];
+				const int32 Next = Ring[(RingIdx + 1) % Ring.Num()];
+				const float CurDist = OtherPlane.PlaneDot(Poly.Positions[Cur]);
+				const float NextDist = OtherPlane.PlaneDot(Poly.Positions[Next]);
+				if (CurDist >= 0.f)
+				{
+					NewRing.Add(Cur);
+				}
+				if ((CurDist >= 0.f) != (NextDist >= 0.f))
+				{
+					NewRing.Add(VisMeshInterpolateVertex(Poly, Poly, Cur, Next, CurDist / (CurDist - NextDist)));
+				}
+			}
+			Ring = MoveTemp(NewRing);
+		}
+
+		if (Ring.Num() < 3)
+		{
+			continue;
+		}
+
+		// 裁剪保持环的顺序，扇形三角化即保持原朝向
+		const int32 PolyBase = CapSection.Data.Positions.Num();
+		for (const int32 RingVert : Ring)
+		{
+			VisMeshCopyVertex(CapSection.Data, Poly, RingVert);
+			CapSection.SectionLocalBox += Poly.Positions[RingVert];
+		}
+		for (int32 RingIdx = 1; RingIdx + 1 < Ring.Num(); RingIdx++)
+		{
+			CapSection.Data.Triangles.Add(PolyBase);
+			CapSection.Data.Triangles.Add(PolyBase + RingIdx);
+			CapSection.Data.Triangles.Add(PolyBase + RingIdx + 1);
+		}
+	}
+}
+
+void UKismetVisMeshLibrary::ClipVisMeshByPlanes(UVisMeshProceduralComponent* InProcMesh, const TArray<FVector>& PlanePositions, const TArray<FVector>& PlaneNormals, EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial)
+{
+	if (InProcMesh == nullptr || PlanePositions.Num() == 0)
+	{
+		return;
+	}
+
+	if (PlanePositions.Num() != PlaneNormals.Num())
+	{
+		FMessageLog("PIE").Warning()
+			->AddToken(FTextToken::Create(LOCTEXT("ClipVisMeshByPlanes_MismatchedPlanes", "ClipVisMeshByPlanes: PlanePositions and PlaneNormals must have the same length.")));
+		return;
+	}
+
+	// Transform planes from world to local space
+	const FTransform ProcCompToWorld = InProcMesh->GetComponentToWorld();
+	TArray<FPlane> ClipPlanes;
+	ClipPlanes.Reserve(PlanePositions.Num());
+	for (int32 PlaneIdx = 0; PlaneIdx < PlanePositions.Num(); PlaneIdx++)
+	{
+		const FVector LocalPlanePos = ProcCompToWorld.InverseTransformPosition(PlanePositions[PlaneIdx]);
+		const FVector LocalPlaneNormal = ProcCompToWorld.InverseTransformVectorNoScale(PlaneNormals[PlaneIdx]).GetSafeNormal();
+		ClipPlanes.Emplace(LocalPlanePos, LocalPlaneNormal);
+	}
+
+	// 1. 每个 Section 与所有平面的包围盒关系：任一平面完全剔除则清空，全部在正侧则不动，否则需要裁剪
+	const int32 NumSections = InProcMesh->GetNumSections();
+	TArray<const FVisMeshSection*> BaseSections;
+	TArray<int32> BoxCompares;
+	BaseSections.SetNumZeroed(NumSections);
+	BoxCompares.Init(INDEX_NONE, NumSections);
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+	{
+		const FVisMeshSection* BaseSection = InProcMesh->GetVisMeshSection(SectionIndex);
+		if (BaseSection != nullptr && BaseSection->Data.NumIndices() > 0 && BaseSection->Data.Positions.Num() > 0)
+		{
+			BaseSections[SectionIndex] = BaseSection;
+			BoxCompares[SectionIndex] = 1;
+			for (const FPlane& ClipPlane : ClipPlanes)
+			{
+				const int32 BoxCompare = VisMeshBoxPlaneCompare(BaseSection->SectionLocalBox, ClipPlane);
+				BoxCompares[SectionIndex] = FMath::Min(BoxCompares[SectionIndex], BoxCompare);
+				if (BoxCompare == -1)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	// 2. 需要裁剪的 Section 并行处理，每个 Section 只遍历一次
+	TArray<FVisMeshSectionClipResult> ClipResults;
+	ClipResults.SetNum(NumSections);
+	ParallelFor(NumSections, [&](int32 SectionIndex)
+	{
+		if (BoxCompares[SectionIndex] == 0)
+		{
+			VisMeshClipSection(*BaseSections[SectionIndex], ClipPlanes, ClipResults[SectionIndex]);
+		}
+	});
+
+	// 3. 按 Section 顺序汇总结果，Cap 边按平面分组
+	TArray<int32> UpdatedSectionIndices;
+	TArray<FVisMeshSection> UpdatedSections;
+	TArray<TArray<FUtilEdge3D>> PlaneClipEdges;
+	PlaneClipEdges.SetNum(ClipPlanes.Num());
+
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+	{
+		if (BoxCompares[SectionIndex] == -1)
+		{
+			UpdatedSectionIndices.Add(SectionIndex);
+			UpdatedSections.Add(FVisMeshSection());
+		}
+		else if (BoxCompares[SectionIndex] == 0)
+		{
+			FVisMeshSectionClipResult& Result = ClipResults[SectionIndex];
+			for (int32 EdgeIdx = 0; EdgeIdx < Result.ClipEdges.Num(); EdgeIdx++)
+			{
+				PlaneClipEdges[Result.ClipEdgePlanes[EdgeIdx]].Add(Result.ClipEdges[EdgeIdx]);
+			}
+
+			UpdatedSectionIndices.Add(SectionIndex);
+			if (Result.Kept.Data.Triangles.Num() > 0 && Result.Kept.Data.Positions.Num() > 0)
+			{
+				UpdatedSections.Add(MoveTemp(Result.Kept));
+			}
+			else
+			{
+				UpdatedSections.Add(FVisMeshSection());
+			}
+		}
+	}
+
+	// 4. 每个平面各自生成 Cap，全部放进同一个 Cap Section
+	const bool bHasClipEdges = PlaneClipEdges.ContainsByPredicate([](const TArray<FUtilEdge3D>& Edges) { return Edges.Num() > 0; });
+	if (CapOption != EVisMeshSliceCapOption::NoCap && bHasClipEdges && (CapOption == EVisMeshSliceCapOption::CreateNewSectionForCap || NumSections > 0))
+	{
+		FVisMeshSection CapSection;
+		int32 CapSectionIndex = INDEX_NONE;
+
+		if (CapOption == EVisMeshSliceCapOption::UseLastSectionForCap)
+		{
+			CapSectionIndex = NumSections - 1;
+			const int32 PendingIndex = UpdatedSectionIndices.Find(CapSectionIndex);
+			CapSection = PendingIndex != INDEX_NONE ? UpdatedSections[PendingIndex] : *InProcMesh->GetVisMeshSection(CapSectionIndex);
+		}
+		else
+		{
+			CapSectionIndex = NumSections;
+			InProcMesh->SetMaterial(CapSectionIndex, CapMaterial);
+		}
+
+		// 参与裁剪的原始 Section (完全保留或完全剔除的 Section 在任何平面上都不会贡献保留的截面)
+		TArray<const FVisMeshSection*> CrossingSections;
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			if (BoxCompares[SectionIndex] == 0)
+			{
+				CrossingSections.Add(BaseSections[SectionIndex]);
+			}
+		}
+
+		for (int32 PlaneIdx = 0; PlaneIdx < ClipPlanes.Num(); PlaneIdx++)
+		{
+			if (PlaneClipEdges[PlaneIdx].Num() == 0)
+			{
+				continue;
+			}
+
+			// 切割边全部闭合说明截面没有碰到其它平面，直接生成；否则截面被其它平面截断，需要用完整截面裁剪
+			bool bHasOpenChains = false;
+			if (ClipPlanes.Num() > 1)
+			{
+				TArray<TArray<FVector3f>> Polylines;
+				TArray<bool> Closed;
+				VisMeshChainEdges(PlaneClipEdges[PlaneIdx], Polylines, Closed);
+				bHasOpenChains = Closed.Contains(false);
+			}
+
+			if (bHasOpenChains)
+			{
+				VisMeshAppendClippedCap(CapSection, CrossingSections, ClipPlanes, PlaneIdx);
+			}
+			else
+			{
+				VisMeshAppendCap(CapSection, PlaneClipEdges[PlaneIdx], ClipPlanes[PlaneIdx]);
+			}
+		}
+
+		const int32 PendingIndex = UpdatedSectionIndices.Find(CapSectionIndex);
+		if (PendingIndex != INDEX_NONE)
+		{
+			UpdatedSections[PendingIndex] = MoveTemp(CapSection);
+		}
+		else
+		{
+			UpdatedSectionIndices.Add(CapSectionIndex);
+			UpdatedSections.Add(MoveTemp(CapSection));
+		}
+	}
+
+	// 5. 凸包碰撞一次性用所有平面重建
+	TArray<TArray<FVector>> ClippedCollision;
+	UBodySetup* ProcMeshBodySetup = InProcMesh->GetBodySetup();
+	for (const FKConvexElem& BaseConvex : ProcMeshBodySetup->AggGeom.ConvexElems)
+	{
+		TArray<FPlane, TInlineAllocator<8>> CrossingPlanes;
+		bool bCulled = false;
+		for (const FPlane& ClipPlane : ClipPlanes)
+		{
+			const int32 BoxCompare = VisMeshBoxPlaneCompare(BaseConvex.ElemBox, ClipPlane);
+			if (BoxCompare == -1)
+			{
+				bCulled = true;
+				break;
+			}
+			if (BoxCompare == 0)
+			{
+				CrossingPlanes.Add(ClipPlane);
+			}
+		}
+
+		if (bCulled)
+		{
+			continue;
+		}
+
+		if (CrossingPlanes.Num() == 0)
+		{
+			ClippedCollision.Add(BaseConvex.VertexData);
+		}
+		else
+		{
+			TArray<FVector> ClippedConvexVerts;
+			VisMeshClipConvexElem(BaseConvex, CrossingPlanes, ClippedConvexVerts);
+			if (ClippedConvexVerts.Num() >= 4)
+			{
+				ClippedCollision.Add(MoveTemp(ClippedConvexVerts));
+			}
+		}
+	}
+
+	// 6. 几何与碰撞一次提交
+	InProcMesh->SetVisMeshSections(UpdatedSectionIndices, MoveTemp(UpdatedSections), &ClippedCollision);
+}
+
+void UKismetVisMeshLibrary::ClipVisMeshByBox(UVisMeshProceduralComponent* InProcMesh, FTransform BoxTransform, FVector BoxExtent, EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial)
+{
+	// 六个面，法线朝向盒子内部
+	TArray<FVector> PlanePositions;
+	TArray<FVector> PlaneNormals;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		for (const float Sign : { 1.f, -1.f })
+		{
+			FVector LocalNormal = FVector::ZeroVector;
+			LocalNormal[Axis] = Sign;
+			PlanePositions.Add(BoxTransform.TransformPosition(-LocalNormal * BoxExtent));
+			PlaneNormals.Add(BoxTransform.TransformVectorNoScale(LocalNormal));
+		}
+	}
+
+	ClipVisMeshByPlanes(InProcMesh, PlanePositions, PlaneNormals, CapOption, CapMaterial);
+}
+
+void UKismetVisMeshLibrary::GetVisMeshCrossSection(UVisMeshProceduralComponent* InProcMesh, FVector PlanePosition, FVector PlaneNormal, TArray<FVisMeshPolyline>& OutPolylines, bool bCreateCap, TArray<FVector>& OutCapVertices, TArray<int32>& OutCapTriangles)
+{
+	OutPolylines.Reset();
+	OutCapVertices.Reset();
+	OutCapTriangles.Reset();
+
+	if (InProcMesh == nullptr)
+	{
+		return;
+	}
+
+	// Transform plane from world to local space
+	const FTransform ProcCompToWorld = InProcMesh->GetComponentToWorld();
+	const FVector LocalPlanePos = ProcCompToWorld.InverseTransformPosition(PlanePosition);
+	const FVector LocalPlaneNormal = ProcCompToWorld.InverseTransformVectorNoScale(PlaneNormal).GetSafeNormal();
+	const FPlane SlicePlane(LocalPlanePos, LocalPlaneNormal);
+
+	// 1. 只收集与平面相交的 Section 的交线段
+	const int32 NumSections = InProcMesh->GetNumSections();
+	TArray<TArray<FUtilEdge3D>> SectionEdges;
+	SectionEdges.SetNum(NumSections);
+	ParallelFor(NumSections, [&](int32 SectionIndex)
+	{
+		const FVisMeshSection* Section = InProcMesh->GetVisMeshSection(SectionIndex);
+		if (Section != nullptr && Section->Data.NumIndices() > 0 && VisMeshBoxPlaneCompare(Section->SectionLocalBox, SlicePlane) == 0)
+		{
+			VisMeshGetSectionPlaneEdges(*Section, SlicePlane, SectionEdges[SectionIndex]);
+		}
+	});
+
+	TArray<FUtilEdge3D> ClipEdges;
+	for (TArray<FUtilEdge3D>& Edges : SectionEdges)
+	{
+		ClipEdges.Append(MoveTemp(Edges));
+	}
+	if (ClipEdges.Num() == 0)
+	{
+		return;
+	}
+
+	// 2. 连接成折线并变换到世界空间
+	TArray<TArray<FVector3f>> Polylines;
+	TArray<bool> Closed;
+	VisMeshChainEdges(ClipEdges, Polylines, Closed);
+
+	OutPolylines.SetNum(Polylines.Num());
+	for (int32 PolyIdx = 0; PolyIdx < Polylines.Num(); PolyIdx++)
+	{
+		FVisMeshPolyline& OutPolyline = OutPolylines[PolyIdx];
+		OutPolyline.bClosed = Closed[PolyIdx];
+		OutPolyline.Points.SetNumUninitialized(Polylines[PolyIdx].Num());
+		for (int32 PointIdx = 0; PointIdx < Polylines[PolyIdx].Num(); PointIdx++)
+		{
+			OutPolyline.Points[PointIdx] = ProcCompToWorld.TransformPosition((FVector)Polylines[PolyIdx][PointIdx]);
+		}
+	}
+
+	// 3. 可选的 Cap，与 SliceVisMesh 的 Cap 相同
+	if (bCreateCap)
+	{
+		FVisMeshSection CapSection;
+		VisMeshAppendCap(CapSection, ClipEdges, SlicePlane);
+
+		OutCapVertices.SetNumUninitialized(CapSection.Data.Positions.Num());
+		for (int32 VertIdx = 0; VertIdx < CapSection.Data.Positions.Num(); VertIdx++)
+		{
+			OutCapVertices[VertIdx] = ProcCompToWorld.TransformPosition(CapSection.Data.Positions[VertIdx]);
+		}
+		OutCapTriangles = MoveTemp(CapSection.Data.Triangles);
+	}
+}
+
 void UKismetVisMeshLibrary::GenerateWireframeBoxMesh(FVector BoxRadius, float LineThickness, TArray<FVector>& Vertices,
 	TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents)
 {
@@ -1373,4 +3190,38 @@ void UKismetVisMeshLibrary::GenerateWireframeBoxMesh(FVector BoxRadius, float Li
     }
 }
 
+UTexture2D* UKismetVisMeshLibrary::CreateColorMapTexture(const TArray<FLinearColor>& ColorStops, int32 Width)
+{
+	if (ColorStops.Num() == 0 || Width < 2)
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, 1, PF_B8G8R8A8);
+	if (Texture == nullptr)
+	{
+		return nullptr;
+	}
+
+	// 色标在 [0,1] 上均匀分布，逐纹素线性插值
+	FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+	FColor* Texels = static_cast<FColor*>(Mip.BulkData.Lock(LOCK_READ_WRITE));
+	const int32 NumSegments = FMath::Max(ColorStops.Num() - 1, 1);
+	for (int32 i = 0; i < Width; i++)
+	{
+		const float T = (float)i / (Width - 1) * NumSegments;
+		const int32 Stop = FMath::Min(FMath::FloorToInt(T), ColorStops.Num() - 1);
+		const int32 NextStop = FMath::Min(Stop + 1, ColorStops.Num() - 1);
+		Texels[i] = FMath::Lerp(ColorStops[Stop], ColorStops[NextStop], T - Stop).ToFColor(true);
+	}
+	Mip.BulkData.Unlock();
+
+	Texture->SRGB = true;
+	Texture->Filter = TF_Bilinear;
+	Texture->AddressX = TA_Clamp;
+	Texture->AddressY = TA_Clamp;
+	Texture->UpdateResource();
+	return Texture;
+}
+
 #undef LOCTEXT_NAMESPACE
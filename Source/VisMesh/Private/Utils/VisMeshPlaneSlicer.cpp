@@ -0,0 +1,415 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Utils/VisMeshPlaneSlicer.h"
+
+#include "Components/VisMeshProceduralComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "Utils/VisMeshUtils.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VisMeshPlaneSlicer)
+
+/** Fringe Section 的最小容量，避免拖动初期频繁扩容 */
+static constexpr int32 GVisMeshMinFringeCapacity = 256;
+
+UVisMeshPlaneSlicer* UVisMeshPlaneSlicer::CreatePlaneSlicer(UVisMeshProceduralComponent* InProcMesh, FVector PlaneNormal, EVisMeshSliceCapOption InCapOption, UMaterialInterface* InCapMaterial)
+{
+	if (InProcMesh == nullptr)
+	{
+		return nullptr;
+	}
+
+	UVisMeshPlaneSlicer* Slicer = NewObject<UVisMeshPlaneSlicer>(InProcMesh);
+	Slicer->ProcMesh = InProcMesh;
+	Slicer->CapOption = InCapOption;
+	Slicer->CapMaterial = InCapMaterial;
+	Slicer->LocalNormal = InProcMesh->GetComponentToWorld().InverseTransformVectorNoScale(PlaneNormal).GetSafeNormal();
+	Slicer->Offset = -MAX_flt;
+	Slicer->BuildIndex();
+	return Slicer;
+}
+
+void UVisMeshPlaneSlicer::BuildIndex()
+{
+	SectionIndices.Reset();
+
+	TArray<int32> UpdatedSectionIndices;
+	TArray<FVisMeshSection> UpdatedSections;
+
+	for (int32 SectionIndex = 0; SectionIndex < ProcMesh->GetNumSections(); SectionIndex++)
+	{
+		const FVisMeshSection* Section = ProcMesh->GetVisMeshSection(SectionIndex);
+		if (Section == nullptr || Section->Data.NumIndices() == 0 || Section->Data.Positions.Num() == 0)
+		{
+			continue;
+		}
+
+		const FVisMeshData& Data = Section->Data;
+		const int32 NumVerts = Data.NumVertices();
+		const TArray<int32>& Triangles = Data.GetTriangles();
+		const int32 NumTris = Triangles.Num() / 3;
+
+		// 1. 顶点在法线上的投影
+		TArray<float> VertProj;
+		VertProj.SetNumUninitialized(NumVerts);
+		ParallelFor(NumVerts, [&](int32 VertIdx)
+		{
+			VertProj[VertIdx] = (float)(Data.Positions[VertIdx] | LocalNormal);
+		});
+
+		// 2. 三角形投影区间 [Min, Max]
+		TArray<float> TriMin, TriMax;
+		TriMin.SetNumUninitialized(NumTris);
+		TriMax.SetNumUninitialized(NumTris);
+		ParallelFor(NumTris, [&](int32 TriIdx)
+		{
+			const float P0 = VertProj[Triangles[TriIdx * 3 + 0]];
+			const float P1 = VertProj[Triangles[TriIdx * 3 + 1]];
+			const float P2 = VertProj[Triangles[TriIdx * 3 + 2]];
+			TriMin[TriIdx] = FMath::Min3(P0, P1, P2);
+			TriMax[TriIdx] = FMath::Max3(P0, P1, P2);
+		});
+
+		// 3. 按最小投影降序重排三角形：任意偏移下完全保留的三角形都是索引缓冲区的前缀
+		TArray<int32> Order;
+		Order.SetNumUninitialized(NumTris);
+		for (int32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+		{
+			Order[TriIdx] = TriIdx;
+		}
+		Order.Sort([&TriMin](int32 A, int32 B) { return TriMin[A] > TriMin[B]; });
+
+		FSectionIndex& Index = SectionIndices.AddDefaulted_GetRef();
+		Index.SectionIndex = SectionIndex;
+		Index.NumKeptTris = NumTris;
+		Index.MinProj.SetNumUninitialized(NumTris);
+		Index.TreeSize = (int32)FMath::RoundUpToPowerOfTwo((uint32)NumTris);
+		Index.MaxTree.Init(-MAX_flt, Index.TreeSize * 2);
+
+		// 重排后的索引不再与共享索引相同
+		FVisMeshSection SortedSection = *Section;
+		SortedSection.Data.SharedIndices.Reset();
+		SortedSection.Data.Triangles.SetNumUninitialized(NumTris * 3);
+		ParallelFor(NumTris, [&](int32 SortedIdx)
+		{
+			const int32 TriIdx = Order[SortedIdx];
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				SortedSection.Data.Triangles[SortedIdx * 3 + Corner] = Triangles[TriIdx * 3 + Corner];
+			}
+			Index.MinProj[SortedIdx] = TriMin[TriIdx];
+			Index.MaxTree[Index.TreeSize + SortedIdx] = TriMax[TriIdx];
+		});
+
+		// 4. 最大投影的线段树，用于只访问跨越平面的三角形
+		for (int32 Node = Index.TreeSize - 1; Node >= 1; Node--)
+		{
+			Index.MaxTree[Node] = FMath::Max(Index.MaxTree[Node * 2], Index.MaxTree[Node * 2 + 1]);
+		}
+
+		SortedSection.DrawFirstIndex = 0;
+		SortedSection.DrawNumIndices = INDEX_NONE;
+		UpdatedSectionIndices.Add(SectionIndex);
+		UpdatedSections.Add(MoveTemp(SortedSection));
+	}
+
+	// 重排只发生一次，几何不变
+	ProcMesh->SetVisMeshSections(UpdatedSectionIndices, MoveTemp(UpdatedSections));
+	IndexedRevision = ProcMesh->GetGeometryRevision();
+}
+
+void UVisMeshPlaneSlicer::EnsureFringeMesh()
+{
+	if (FringeMesh != nullptr)
+	{
+		return;
+	}
+
+	// 碰撞设置与源组件一致，拖动期间不烹饪 (见 FinishPlaneDrag)
+	FringeMesh = NewObject<UVisMeshProceduralComponent>(ProcMesh->GetOuter());
+	FringeMesh->SetCollisionProfileName(ProcMesh->GetCollisionProfileName());
+	FringeMesh->SetCollisionEnabled(ProcMesh->GetCollisionEnabled());
+	FringeMesh->bUseAsyncCooking = ProcMesh->bUseAsyncCooking;
+	FringeMesh->SetDeferCollisionUpdates(true);
+	FringeMesh->AttachToComponent(ProcMesh, FAttachmentTransformRules::SnapToTargetIncludingScale);
+
+	// 每个源 Section 对应一个 Fringe Section (相同材质)，最后一个是 Cap
+	for (int32 i = 0; i < SectionIndices.Num(); i++)
+	{
+		FringeMesh->SetMaterial(i, ProcMesh->GetMaterial(SectionIndices[i].SectionIndex));
+	}
+	if (CapOption == EVisMeshSliceCapOption::CreateNewSectionForCap)
+	{
+		FringeMesh->SetMaterial(SectionIndices.Num(), CapMaterial);
+	}
+	else if (CapOption == EVisMeshSliceCapOption::UseLastSectionForCap && ProcMesh->GetNumSections() > 0)
+	{
+		FringeMesh->SetMaterial(SectionIndices.Num(), ProcMesh->GetMaterial(ProcMesh->GetNumSections() - 1));
+	}
+
+	FringeMesh->RegisterComponent();
+}
+
+void UVisMeshPlaneSlicer::DestroyFringeMesh()
+{
+	if (FringeMesh != nullptr)
+	{
+		FringeMesh->DestroyComponent();
+		FringeMesh = nullptr;
+	}
+	FringeCapacities.Reset();
+}
+
+void UVisMeshPlaneSlicer::UpdateFringeSections(TArray<FVisMeshSection>&& Sections)
+{
+	// 1. Section 数变化或某个 Section 超出容量时，按 2 的幂扩容并重建 Fringe 的 Proxy
+	bool bRebuild = FringeCapacities.Num() != Sections.Num();
+	for (int32 i = 0; i < Sections.Num() && !bRebuild; i++)
+	{
+		bRebuild = Sections[i].Data.NumIndices() > FringeCapacities[i];
+	}
+	if (bRebuild)
+	{
+		FringeCapacities.SetNumZeroed(Sections.Num());
+		for (int32 i = 0; i < Sections.Num(); i++)
+		{
+			const int32 Required = FMath::Max(Sections[i].Data.NumIndices(), GVisMeshMinFringeCapacity);
+			FringeCapacities[i] = FMath::Max(FringeCapacities[i], (int32)FMath::RoundUpToPowerOfTwo((uint32)Required));
+		}
+	}
+
+	// 2. 展开为非索引顶点 (第 i 个索引即第 i 个顶点)，索引缓冲区固定不变；容量内剩余部分用最后一个顶点填充
+	//    (退化三角形，不影响包围盒)，只绘制有效部分。空 Section 按对应源 Section 的属性布局填充
+	//    Cap (最后一个 Section，下标为 SectionIndices.Num()) 的属性布局来自 VisMeshAppendCap，与源 Section 无关：
+	//    为空时按 Cap 的输出布局 (位置、法线、切线、颜色、UV0，无标量通道) 填充，之后原地写入的 Cap 数据与之一致
+	FVisMeshSection CapLayout;
+	if (bRebuild && CapOption != EVisMeshSliceCapOption::NoCap)
+	{
+		const FVisMeshData& FirstData = ProcMesh->GetVisMeshSection(SectionIndices[0].SectionIndex)->Data;
+		CapLayout.Data.Positions.Add(FirstData.Positions[0]);
+		CapLayout.Data.Normals.Add(LocalNormal);
+		CapLayout.Data.Tangents.Add(FVisMeshTangent());
+		CapLayout.Data.Colors.Add(FColor::White);
+		CapLayout.Data.UV0.Add(FVector2D::ZeroVector);
+	}
+
+	TArray<FVisMeshSection> Expanded;
+	Expanded.SetNum(Sections.Num());
+	ParallelFor(Sections.Num(), [&](int32 i)
+	{
+		const FVisMeshSection& Src = Sections[i];
+		const int32 NumIndices = Src.Data.NumIndices();
+		if (NumIndices == 0 && !bRebuild)
+		{
+			return;
+		}
+
+		const bool bIsCap = i >= SectionIndices.Num();
+		const FVisMeshSection& Layout = NumIndices > 0 ? Src : (bIsCap ? CapLayout : *ProcMesh->GetVisMeshSection(SectionIndices[i].SectionIndex));
+		const TArray<int32>& SrcTriangles = Src.Data.GetTriangles();
+		const int32 PadVertex = NumIndices > 0 ? SrcTriangles[NumIndices - 1] : 0;
+		const int32 Capacity = FringeCapacities[i];
+
+		FVisMeshSection& Dst = Expanded[i];
+		VisMeshAllocateLike(Dst.Data, Layout.Data, Capacity, bRebuild ? Capacity : 0);
+		for (int32 Idx = 0; Idx < Capacity; Idx++)
+		{
+			VisMeshWriteVertex(Dst.Data, Idx, Layout.Data, Idx < NumIndices ? SrcTriangles[Idx] : PadVertex);
+		}
+
+		if (bRebuild)
+		{
+			for (int32 Idx = 0; Idx < Capacity; Idx++)
+			{
+				Dst.Data.Triangles[Idx] = Idx;
+			}
+			Dst.SectionLocalBox = VisMeshComputeBounds(Dst.Data.Positions);
+			Dst.bEnableCollision = Src.bEnableCollision;
+			Dst.ActiveScalarChannel = bIsCap ? INDEX_NONE : Layout.ActiveScalarChannel;
+			Dst.DrawNumIndices = NumIndices;
+		}
+	});
+
+	if (bRebuild)
+	{
+		TArray<int32> FringeSectionIndices;
+		for (int32 i = 0; i < Expanded.Num(); i++)
+		{
+			FringeSectionIndices.Add(i);
+		}
+		FringeMesh->SetVisMeshSections(FringeSectionIndices, MoveTemp(Expanded));
+		return;
+	}
+
+	// 3. 原地更新：只上传顶点并修改绘制范围，不重建 Proxy
+	for (int32 i = 0; i < Expanded.Num(); i++)
+	{
+		const int32 NumIndices = Sections[i].Data.NumIndices();
+		if (NumIndices > 0)
+		{
+			FringeMesh->UpdateMeshSection(i, MoveTemp(Expanded[i].Data));
+		}
+		FringeMesh->SetMeshSectionDrawRange(i, 0, NumIndices);
+	}
+}
+
+void UVisMeshPlaneSlicer::CollectStraddling(const FSectionIndex& Index, int32 Node, int32 NodeFirst, int32 NodeEnd, int32 First, int32 End, float InOffset, TArray<int32>& OutTris)
+{
+	if (NodeEnd <= First || NodeFirst >= End || Index.MaxTree[Node] <= InOffset)
+	{
+		return;
+	}
+
+	if (Node >= Index.TreeSize)
+	{
+		OutTris.Add(NodeFirst);
+		return;
+	}
+
+	const int32 NodeMid = (NodeFirst + NodeEnd) / 2;
+	CollectStraddling(Index, Node * 2, NodeFirst, NodeMid, First, End, InOffset, OutTris);
+	CollectStraddling(Index, Node * 2 + 1, NodeMid, NodeEnd, First, End, InOffset, OutTris);
+}
+
+void UVisMeshPlaneSlicer::SetPlanePosition(FVector PlanePosition)
+{
+	if (ProcMesh == nullptr)
+	{
+		return;
+	}
+
+	const FVector LocalPlanePos = ProcMesh->GetComponentToWorld().InverseTransformPosition(PlanePosition);
+	SetPlaneOffset((float)(LocalPlanePos | LocalNormal));
+}
+
+void UVisMeshPlaneSlicer::SetPlaneOffset(float InOffset)
+{
+	if (ProcMesh == nullptr)
+	{
+		return;
+	}
+
+	// 0. 源网格几何变化后投影与排序都已失效，重建索引
+	if (ProcMesh->GetGeometryRevision() != IndexedRevision)
+	{
+		DestroyFringeMesh();
+		BuildIndex();
+	}
+	if (SectionIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// 拖动期间不烹饪碰撞 (见 FinishPlaneDrag)
+	ProcMesh->SetDeferCollisionUpdates(true);
+
+	Offset = InOffset;
+	const FPlane SlicePlane(LocalNormal, Offset);
+
+	// 1. 每个 Section：二分得到完全保留的前缀，线段树找出跨越平面的三角形并只切割这些三角形
+	TArray<FVisMeshSectionSliceResult> SliceResults;
+	SliceResults.SetNum(SectionIndices.Num());
+	ParallelFor(SectionIndices.Num(), [&](int32 i)
+	{
+		FSectionIndex& Index = SectionIndices[i];
+		const FVisMeshSection* Section = ProcMesh->GetVisMeshSection(Index.SectionIndex);
+		const int32 NumTris = Index.MinProj.Num();
+
+		Index.NumKeptTris = Algo::LowerBound(Index.MinProj, Offset, TGreater<>());
+
+		TArray<int32> StraddlingTris;
+		CollectStraddling(Index, 1, 0, Index.TreeSize, Index.NumKeptTris, NumTris, Offset, StraddlingTris);
+		if (StraddlingTris.Num() == 0)
+		{
+			return;
+		}
+
+		// 跨越平面的三角形拷贝成一个小 Section 再切割
+		FVisMeshSection Straddling;
+		VisMeshAllocateLike(Straddling.Data, Section->Data, StraddlingTris.Num() * 3, StraddlingTris.Num() * 3);
+		for (int32 TriIdx = 0; TriIdx < StraddlingTris.Num(); TriIdx++)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 DestIdx = TriIdx * 3 + Corner;
+				VisMeshWriteVertex(Straddling.Data, DestIdx, Section->Data, Section->Data.GetTriangles()[StraddlingTris[TriIdx] * 3 + Corner]);
+				Straddling.Data.Triangles[DestIdx] = DestIdx;
+			}
+		}
+		Straddling.ActiveScalarChannel = Section->ActiveScalarChannel;
+
+		VisMeshSliceSection(Straddling, SlicePlane, false, SliceResults[i]);
+	});
+
+	// 2. 源组件只改绘制范围，不重建任何 Buffer
+	TArray<FVisMeshSection> FringeSections;
+	TArray<FUtilEdge3D> ClipEdges;
+	bool bAnyCollision = false;
+	for (int32 i = 0; i < SectionIndices.Num(); i++)
+	{
+		ProcMesh->SetMeshSectionDrawRange(SectionIndices[i].SectionIndex, 0, SectionIndices[i].NumKeptTris * 3);
+
+		const bool bSectionCollision = ProcMesh->GetVisMeshSection(SectionIndices[i].SectionIndex)->bEnableCollision;
+		bAnyCollision |= bSectionCollision;
+
+		ClipEdges.Append(SliceResults[i].ClipEdges);
+		FVisMeshSection& FringeSection = FringeSections.Add_GetRef(MoveTemp(SliceResults[i].Kept));
+		FringeSection.bEnableCollision = bSectionCollision;
+	}
+
+	// 3. Cap
+	if (CapOption != EVisMeshSliceCapOption::NoCap)
+	{
+		FVisMeshSection& CapSection = FringeSections.AddDefaulted_GetRef();
+		if (ClipEdges.Num() > 0)
+		{
+			VisMeshAppendCap(CapSection, ClipEdges, SlicePlane);
+		}
+		CapSection.bEnableCollision = bAnyCollision;
+	}
+
+	// 4. Fringe 组件只包含跨越平面的那部分几何，更新代价与切割线长度成正比
+	EnsureFringeMesh();
+	FringeMesh->SetDeferCollisionUpdates(true);
+	UpdateFringeSections(MoveTemp(FringeSections));
+}
+
+void UVisMeshPlaneSlicer::FinishPlaneDrag()
+{
+	if (ProcMesh != nullptr)
+	{
+		ProcMesh->SetDeferCollisionUpdates(false);
+	}
+	if (FringeMesh != nullptr)
+	{
+		FringeMesh->SetDeferCollisionUpdates(false);
+	}
+}
+
+void UVisMeshPlaneSlicer::ResetSlice()
+{
+	if (ProcMesh != nullptr)
+	{
+		for (FSectionIndex& Index : SectionIndices)
+		{
+			Index.NumKeptTris = Index.MinProj.Num();
+			ProcMesh->SetMeshSectionDrawRange(Index.SectionIndex, 0, INDEX_NONE);
+		}
+		ProcMesh->SetDeferCollisionUpdates(false);
+	}
+
+	DestroyFringeMesh();
+
+	Offset = -MAX_flt;
+}
+
+int32 UVisMeshPlaneSlicer::GetNumKeptTriangles() const
+{
+	int32 NumKeptTris = 0;
+	for (const FSectionIndex& Index : SectionIndices)
+	{
+		NumKeptTris += Index.NumKeptTris;
+	}
+	return NumKeptTris;
+}
@@ -0,0 +1,193 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "Utils/VisMeshUtils.h"
+
+#include "Async/ParallelFor.h"
+
+/** 点到线段的距离平方 */
+static float VisMeshPointSegmentDistSquared(const FVector3f& P, const FVector3f& A, const FVector3f& B)
+{
+	const FVector3f AB = B - A;
+	const float LengthSquared = AB.SizeSquared();
+	const float T = LengthSquared > UE_SMALL_NUMBER ? FMath::Clamp(FVector3f::DotProduct(P - A, AB) / LengthSquared, 0.f, 1.f) : 0.f;
+	return FVector3f::DistSquared(P, A + AB * T);
+}
+
+/** 简化 [First, Last]，按下标顺序追加保留点 (bIncludeFirst 为 false 时不输出 First，用于拼接相邻块) */
+static void VisMeshDouglasPeuckerRange(TArrayView<const FVector3f> Points, int32 First, int32 Last, float ToleranceSquared, bool bIncludeFirst, TArray<int32>& OutIndices)
+{
+	if (bIncludeFirst)
+	{
+		OutIndices.Add(First);
+	}
+
+	// 显式栈代替递归 (百万点的折线递归会过深)；先处理左半段，保证输出递增
+	TArray<FIntPoint, TInlineAllocator<64>> Stack;
+	Stack.Push(FIntPoint(First, Last));
+	while (Stack.Num() > 0)
+	{
+		const FIntPoint Segment = Stack.Pop();
+
+		float MaxDistSquared = -1.f;
+		int32 Split = INDEX_NONE;
+		for (int32 i = Segment.X + 1; i < Segment.Y; i++)
+		{
+			const float DistSquared = VisMeshPointSegmentDistSquared(Points[i], Points[Segment.X], Points[Segment.Y]);
+			if (DistSquared > MaxDistSquared)
+			{
+				MaxDistSquared = DistSquared;
+				Split = i;
+			}
+		}
+
+		if (Split != INDEX_NONE && MaxDistSquared > ToleranceSquared)
+		{
+			Stack.Push(FIntPoint(Split, Segment.Y));
+			Stack.Push(FIntPoint(Segment.X, Split));
+		}
+		else
+		{
+			OutIndices.Add(Segment.Y);
+		}
+	}
+}
+
+void VisMeshDecimateDouglasPeucker(TArrayView<const FVector3f> Points, float Tolerance, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	const int32 NumPoints = Points.Num();
+	if (NumPoints <= 2 || Tolerance <= 0.f)
+	{
+		OutIndices.SetNumUninitialized(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			OutIndices[i] = i;
+		}
+		return;
+	}
+
+	// 1. 分块并行简化，块 c 覆盖 [c * ChunkSize, (c + 1) * ChunkSize]，相邻块共享边界点
+	constexpr int32 ChunkSize = 64 * 1024;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumPoints - 1, ChunkSize);
+	const float ToleranceSquared = Tolerance * Tolerance;
+	TArray<TArray<int32>> ChunkIndices;
+	ChunkIndices.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		const int32 First = ChunkIdx * ChunkSize;
+		const int32 Last = FMath::Min(First + ChunkSize, NumPoints - 1);
+		VisMeshDouglasPeuckerRange(Points, First, Last, ToleranceSquared, ChunkIdx == 0, ChunkIndices[ChunkIdx]);
+	});
+
+	// 2. 按块顺序拼接
+	int32 Total = 0;
+	for (const TArray<int32>& Indices : ChunkIndices)
+	{
+		Total += Indices.Num();
+	}
+	OutIndices.Reserve(Total);
+	for (const TArray<int32>& Indices : ChunkIndices)
+	{
+		OutIndices.Append(Indices);
+	}
+}
+
+void VisMeshDecimateMinMaxColumns(TArrayView<const FVector3f> Points, float MinX, float ColumnWidth, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	const int32 NumPoints = Points.Num();
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	// 列按全局 MinX 对齐 (不同折线的列一致)，但只统计这条折线覆盖的列 [FirstColumn, LastColumn]
+	// 列数不少于点数的 1/4 时抽稀没有收益，直接保留全部点
+	const double FirstColumnDouble = ColumnWidth > 0.f ? FMath::FloorToDouble((Points[0].X - MinX) / ColumnWidth) : 0.0;
+	const double LastColumnDouble = ColumnWidth > 0.f ? FMath::FloorToDouble((Points.Last().X - MinX) / ColumnWidth) : (double)MAX_int32;
+	const double NumColumnsDouble = LastColumnDouble - FirstColumnDouble + 1.0;
+	if (NumColumnsDouble * 4.0 >= NumPoints)
+	{
+		OutIndices.SetNumUninitialized(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			OutIndices[i] = i;
+		}
+		return;
+	}
+
+	const int32 NumColumns = FMath::Max((int32)NumColumnsDouble, 1);
+	const double FirstColumn = FirstColumnDouble;
+	auto ColumnOf = [&](int32 PointIdx)
+	{
+		return FMath::Clamp((int32)(FMath::FloorToDouble((Points[PointIdx].X - MinX) / ColumnWidth) - FirstColumn), 0, NumColumns - 1);
+	};
+
+	// 1. 每列的起始点：X 递增，列号也递增，可以并行二分查找
+	TArray<int32> ColumnStarts;
+	ColumnStarts.SetNumUninitialized(NumColumns + 1);
+	ColumnStarts[NumColumns] = NumPoints;
+	ParallelFor(NumColumns, [&](int32 Column)
+	{
+		int32 Begin = 0;
+		int32 End = NumPoints;
+		while (Begin < End)
+		{
+			const int32 Mid = (Begin + End) / 2;
+			if (ColumnOf(Mid) < Column)
+			{
+				Begin = Mid + 1;
+			}
+			else
+			{
+				End = Mid;
+			}
+		}
+		ColumnStarts[Column] = Begin;
+	});
+
+	// 2. 每列保留首点、最小点、最大点、尾点 (去重)，计数后前缀和
+	TArray<int32> Slots;
+	TArray<int32> Counts;
+	Slots.SetNumUninitialized(NumColumns * 4);
+	Counts.SetNumUninitialized(NumColumns);
+	ParallelFor(NumColumns, [&](int32 Column)
+	{
+		const int32 Begin = ColumnStarts[Column];
+		const int32 End = ColumnStarts[Column + 1];
+		if (Begin >= End)
+		{
+			Counts[Column] = 0;
+			return;
+		}
+
+		int32 MinIdx = Begin;
+		int32 MaxIdx = Begin;
+		for (int32 i = Begin + 1; i < End; i++)
+		{
+			MinIdx = Points[i].Y < Points[MinIdx].Y ? i : MinIdx;
+			MaxIdx = Points[i].Y > Points[MaxIdx].Y ? i : MaxIdx;
+		}
+
+		int32 Candidates[4] = { Begin, FMath::Min(MinIdx, MaxIdx), FMath::Max(MinIdx, MaxIdx), End - 1 };
+		int32* Out = &Slots[Column * 4];
+		int32 Count = 0;
+		for (int32 Candidate : Candidates)
+		{
+			if (Count == 0 || Out[Count - 1] != Candidate)
+			{
+				Out[Count++] = Candidate;
+			}
+		}
+		Counts[Column] = Count;
+	});
+
+	// 3. 并行写入
+	TArray<int32> Offsets = Counts;
+	const int32 Total = VisMeshExclusiveScan(Offsets);
+	OutIndices.SetNumUninitialized(Total);
+	ParallelFor(NumColumns, [&](int32 Column)
+	{
+		FMemory::Memcpy(OutIndices.GetData() + Offsets[Column], &Slots[Column * 4], Counts[Column] * sizeof(int32));
+	});
+}
@@ -4,6 +4,8 @@
 #include "RenderGraphEvent.h"
 #include "RenderGraphUtils.h"
 #include "RenderBase/VisMeshDispatchShaders.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
 
 // --------------------------------------------------------
 // ------------------------Utils---------------------------
@@ -60,6 +62,382 @@ void GetUnitCubeVertices(TArray<FVector3f>& OutVertices)
 	OutVertices.Add(FVector3f(0, 1, 1)); // 7
 }
 
+namespace VisMeshColorConversion
+{
+	// 查找表精度：[0,1] 被均分为 LUTSize 个桶。乘以 2 的幂在浮点下是精确的，
+	// 因此桶索引不会因舍入落入相邻桶。sRGB 曲线的最大斜率约为 12.92 * 255，
+	// 每个桶最多跨越 2 个输出值，一次阈值比较即可得到精确结果。
+	static constexpr int32 LUTSize = 4096;
+
+	static FORCEINLINE float BitsToFloat(uint32 Bits) { float F; FMemory::Memcpy(&F, &Bits, sizeof(F)); return F; }
+	static FORCEINLINE uint32 FloatToBits(float F) { uint32 Bits; FMemory::Memcpy(&Bits, &F, sizeof(Bits)); return Bits; }
+
+	// 每个通道的量化表：桶的起始输出值 + 每个输出值的最小输入阈值
+	struct FChannelTable
+	{
+		uint8 Base[LUTSize];
+		float Threshold[257];
+
+		template <typename RefFuncType>
+		void Build(RefFuncType&& RefFunc)
+		{
+			// 1. 以引擎实现为参考，二分查找每个输出值的最小输入 (正浮点数的位模式单调)
+			Threshold[0] = -UE_MAX_FLT;
+			for (int32 Value = 1; Value < 256; ++Value)
+			{
+				uint32 Lo = 0;                          // 0.0f, RefFunc(Lo) < Value
+				uint32 Hi = FloatToBits(1.0f);      // 1.0f, RefFunc(Hi) >= Value
+				while (Hi - Lo > 1)
+				{
+					const uint32 Mid = Lo + (Hi - Lo) / 2;
+					if (RefFunc(BitsToFloat(Mid)) >= Value) { Hi = Mid; }
+					else { Lo = Mid; }
+				}
+				Threshold[Value] = BitsToFloat(Hi);
+			}
+			Threshold[256] = UE_MAX_FLT;
+
+			// 2. 每个桶的起始输出值
+			for (int32 i = 0; i < LUTSize; ++i)
+			{
+				Base[i] = (uint8)RefFunc((float)i / LUTSize);
+				checkf(Base[i] >= 254 || Threshold[Base[i] + 2] >= (float)(i + 1) / LUTSize,
+					TEXT("VisMesh colour LUT bucket spans more than two output values."));
+			}
+		}
+
+		FORCEINLINE uint8 Lookup(int32 Index, float Value) const
+		{
+			const uint8 Result = Base[Index];
+			return Result + (Value >= Threshold[Result + 1] ? 1 : 0);
+		}
+	};
+
+	struct FTables
+	{
+		FChannelTable SRGBColor;
+		FChannelTable SRGBAlpha;
+		FChannelTable LinearColor;
+		FChannelTable LinearAlpha;
+
+		FTables()
+		{
+			SRGBColor.Build([](float V) { return (int32)FLinearColor(V, 0, 0, 0).ToFColor(true).R; });
+			SRGBAlpha.Build([](float V) { return (int32)FLinearColor(0, 0, 0, V).ToFColor(true).A; });
+			LinearColor.Build([](float V) { return (int32)FLinearColor(V, 0, 0, 0).ToFColor(false).R; });
+			LinearAlpha.Build([](float V) { return (int32)FLinearColor(0, 0, 0, V).ToFColor(false).A; });
+		}
+	};
+
+	static const FTables& GetTables()
+	{
+		static const FTables Tables;
+		return Tables;
+	}
+
+	// 每块 4096 个颜色 (64KB 输入 + 16KB 输出)，保证单个任务的数据能留在 L2 中
+	static constexpr int32 BlockSize = 4096;
+}
+
+void VisMeshConvertLinearColors(TArrayView<const FLinearColor> InColors, TArrayView<FColor> OutColors, bool bSRGB)
+{
+	using namespace VisMeshColorConversion;
+	check(InColors.Num() == OutColors.Num());
+
+	const int32 Num = InColors.Num();
+	if (Num == 0) return;
+
+	const FTables& Tables = GetTables();
+	const FChannelTable& ColorTable = bSRGB ? Tables.SRGBColor : Tables.LinearColor;
+	const FChannelTable& AlphaTable = bSRGB ? Tables.SRGBAlpha : Tables.LinearAlpha;
+
+	const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockSize);
+	ParallelFor(NumBlocks, [&](int32 BlockIndex)
+	{
+		const int32 Start = BlockIndex * BlockSize;
+		const int32 End = FMath::Min(Start + BlockSize, Num);
+
+		const VectorRegister4Float Scale = VectorSetFloat1((float)LUTSize);
+		const VectorRegister4Float MaxIndex = VectorSetFloat1((float)(LUTSize - 1));
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		for (int32 i = Start; i < End; ++i)
+		{
+			const FLinearColor& Src = InColors[i];
+
+			// SIMD：一次计算 RGBA 四个通道的桶索引 (NaN 会被 VectorMax 钳制为 0)
+			const VectorRegister4Float Value = VectorLoad(&Src.R);
+			const VectorRegister4Float Scaled = VectorMin(VectorMax(VectorMultiply(Value, Scale), Zero), MaxIndex);
+			alignas(16) int32 Index[4];
+			VectorIntStore(VectorFloatToInt(Scaled), Index);
+
+			FColor& Dst = OutColors[i];
+			Dst.R = ColorTable.Lookup(Index[0], Src.R);
+			Dst.G = ColorTable.Lookup(Index[1], Src.G);
+			Dst.B = ColorTable.Lookup(Index[2], Src.B);
+			Dst.A = AlphaTable.Lookup(Index[3], Src.A);
+		}
+	}, NumBlocks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+FBox VisMeshComputeBounds(TArrayView<const FVector> Positions)
+{
+	const int32 Num = Positions.Num();
+	if (Num == 0) return FBox(ForceInit);
+
+	// 每块 16K 个顶点 (384KB)，块内用 SIMD 做 min/max，块间再做一次串行归约
+	constexpr int32 ChunkSize = 16 * 1024;
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+
+	TArray<FVector, TInlineAllocator<64>> ChunkMin;
+	TArray<FVector, TInlineAllocator<64>> ChunkMax;
+	ChunkMin.SetNumUninitialized(NumChunks);
+	ChunkMax.SetNumUninitialized(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Start = ChunkIndex * ChunkSize;
+		const int32 End = FMath::Min(Start + ChunkSize, Num);
+
+		VectorRegister4Double MinV = VectorLoadFloat3(&Positions[Start].X);
+		VectorRegister4Double MaxV = MinV;
+		for (int32 i = Start + 1; i < End; ++i)
+		{
+			const VectorRegister4Double P = VectorLoadFloat3(&Positions[i].X);
+			MinV = VectorMin(MinV, P);
+			MaxV = VectorMax(MaxV, P);
+		}
+
+		VectorStoreFloat3(MinV, &ChunkMin[ChunkIndex].X);
+		VectorStoreFloat3(MaxV, &ChunkMax[ChunkIndex].X);
+	}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	FBox Result(ChunkMin[0], ChunkMax[0]);
+	for (int32 ChunkIndex = 1; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		Result.Min = Result.Min.ComponentMin(ChunkMin[ChunkIndex]);
+		Result.Max = Result.Max.ComponentMax(ChunkMax[ChunkIndex]);
+	}
+	return Result;
+}
+
+void VisMeshPadAttributes(FVisMeshData& Data)
+{
+	const int32 NumVerts = Data.NumVertices();
+	if (Data.Normals.Num() != NumVerts) Data.Normals.Init(FVector(0, 0, 1), NumVerts);
+	if (Data.Colors.Num() != NumVerts) Data.Colors.Init(FColor::White, NumVerts);
+	if (Data.Tangents.Num() != NumVerts) Data.Tangents.Init(FVisMeshTangent(), NumVerts);
+	if (Data.UV0.Num() != NumVerts) Data.UV0.Init(FVector2D::ZeroVector, NumVerts);
+	if (Data.UV1.Num() != NumVerts) Data.UV1.Init(FVector2D::ZeroVector, NumVerts);
+	if (Data.UV2.Num() != NumVerts) Data.UV2.Init(FVector2D::ZeroVector, NumVerts);
+	if (Data.UV3.Num() != NumVerts) Data.UV3.Init(FVector2D::ZeroVector, NumVerts);
+}
+
+bool VisMeshExpandSphereImpostor(const FVector3f& Center, float Radius, const FVector3f& CameraPosition, FVector3f OutRows[3], FVector3f OutCorners[4])
+{
+	// 与 ComputeSphereImpostorRows (PopulateScatterPointInstanceBuffer.usf) 保持逐项一致
+	const FVector3f ToCenter = Center - CameraPosition;
+	const float Distance = ToCenter.Size();
+	if (Distance <= Radius)
+	{
+		return false;
+	}
+
+	const FVector3f Forward = ToCenter / Distance;
+	FVector3f Right = FVector3f::CrossProduct(FVector3f(0.f, 0.f, 1.f), Forward);
+	Right = Right.SizeSquared() > 1e-8f ? Right.GetUnsafeNormal() : FVector3f(0.f, 1.f, 0.f);
+	const FVector3f Up = FVector3f::CrossProduct(Forward, Right);
+
+	// 视锥在球面最前端平面上的截面半径
+	const float HalfSize = Radius * FMath::Sqrt((Distance - Radius) / (Distance + Radius));
+	OutRows[0] = Right * HalfSize;
+	OutRows[1] = Up * HalfSize;
+	OutRows[2] = Forward * Radius;
+
+	for (int32 Corner = 0; Corner < 4; Corner++)
+	{
+		const float X = (Corner & 1) ? 1.f : -1.f;
+		const float Y = (Corner & 2) ? 1.f : -1.f;
+		OutCorners[Corner] = Center + OutRows[0] * X + OutRows[1] * Y - OutRows[2];
+	}
+	return true;
+}
+
+int32 VisMeshExclusiveScan(TArrayView<int32> Values)
+{
+	const int32 Num = Values.Num();
+	if (Num == 0) return 0;
+
+	// 1. 每块求和 (并行) 2. 块间前缀和 (串行) 3. 块内前缀和 (并行)
+	constexpr int32 ChunkSize = 64 * 1024;
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+	const EParallelForFlags Flags = NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+	TArray<int32, TInlineAllocator<64>> ChunkOffsets;
+	ChunkOffsets.SetNumUninitialized(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+		int32 Sum = 0;
+		for (int32 i = ChunkIndex * ChunkSize; i < End; ++i)
+		{
+			Sum += Values[i];
+		}
+		ChunkOffsets[ChunkIndex] = Sum;
+	}, Flags);
+
+	int32 Total = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		const int32 Sum = ChunkOffsets[ChunkIndex];
+		ChunkOffsets[ChunkIndex] = Total;
+		Total += Sum;
+	}
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+		int32 Running = ChunkOffsets[ChunkIndex];
+		for (int32 i = ChunkIndex * ChunkSize; i < End; ++i)
+		{
+			const int32 Value = Values[i];
+			Values[i] = Running;
+			Running += Value;
+		}
+	}, Flags);
+
+	return Total;
+}
+
+/** 并行生成网格索引，每行 Quad 一个任务 */
+static TArray<int32> VisMeshBuildGridIndices(int32 NumX, int32 NumY, EVisMeshGridIndexLayout Layout)
+{
+	// Triangles 排布按 X 分行，其余按 Y 分行
+	const bool bXMajor = (Layout == EVisMeshGridIndexLayout::Triangles || Layout == EVisMeshGridIndexLayout::TrianglesReversed);
+	const int32 NumRows = bXMajor ? NumX - 1 : NumY - 1;
+	const int32 NumCols = bXMajor ? NumY - 1 : NumX - 1;
+
+	TArray<int32> Indices;
+	Indices.SetNumUninitialized(NumRows * NumCols * 6);
+
+	ParallelFor(NumRows, [&](int32 Row)
+	{
+		for (int32 Col = 0; Col < NumCols; Col++)
+		{
+			const int32 Quad = Row * NumCols + Col;
+			int32* Out = &Indices[Quad * 6];
+
+			switch (Layout)
+			{
+			case EVisMeshGridIndexLayout::Triangles:
+			case EVisMeshGridIndexLayout::TrianglesReversed:
+			{
+				const int32 I0 = (Row + 0) * NumY + (Col + 0);
+				const int32 I1 = (Row + 1) * NumY + (Col + 0);
+				const int32 I2 = (Row + 1) * NumY + (Col + 1);
+				const int32 I3 = (Row + 0) * NumY + (Col + 1);
+
+				// 与 ConvertQuadToTriangles(V0, V1, V2, V3) 相同：(V0, V1, V3), (V1, V2, V3)
+				const int32 V1 = Layout == EVisMeshGridIndexLayout::Triangles ? I1 : I3;
+				const int32 V3 = Layout == EVisMeshGridIndexLayout::Triangles ? I3 : I1;
+				Out[0] = I0; Out[1] = V1; Out[2] = V3;
+				Out[3] = V1; Out[4] = I2; Out[5] = V3;
+				break;
+			}
+			case EVisMeshGridIndexLayout::Welded:
+			{
+				const int32 Idx = Col + Row * NumX;
+				Out[0] = Idx;     Out[1] = Idx + NumX; Out[2] = Idx + 1;
+				Out[3] = Idx + 1; Out[4] = Idx + NumX; Out[5] = Idx + NumX + 1;
+				break;
+			}
+			case EVisMeshGridIndexLayout::Split:
+			{
+				const int32 Base = Quad * 4;
+				Out[0] = Base + 3; Out[1] = Base + 1; Out[2] = Base;
+				Out[3] = Base + 3; Out[4] = Base + 2; Out[5] = Base + 1;
+				break;
+			}
+			}
+		}
+	});
+
+	return Indices;
+}
+
+using FVisMeshGridKey = TTuple<int32, int32, uint8>;
+static TMap<FVisMeshGridKey, TWeakPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe>> GVisMeshGridIndexCache;
+static FCriticalSection GVisMeshGridIndexCacheLock;
+
+/** 缓存中仍被使用的共享索引，没有时返回 nullptr */
+static TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> VisMeshFindCachedGridIndices(const FVisMeshGridKey& Key)
+{
+	FScopeLock Lock(&GVisMeshGridIndexCacheLock);
+	if (const TWeakPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe>* Cached = GVisMeshGridIndexCache.Find(Key))
+	{
+		return Cached->Pin();
+	}
+	return nullptr;
+}
+
+TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> VisMeshGetGridIndices(int32 NumX, int32 NumY, EVisMeshGridIndexLayout Layout)
+{
+	if (NumX < 2 || NumY < 2)
+	{
+		return nullptr;
+	}
+
+	const FVisMeshGridKey Key(NumX, NumY, (uint8)Layout);
+
+	// 1. 命中且仍被使用则直接返回
+	if (TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> Pinned = VisMeshFindCachedGridIndices(Key))
+	{
+		return Pinned;
+	}
+
+	// 2. 在锁外生成，避免不同尺寸的请求互相阻塞
+	TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> NewIndices = FVisMeshSharedIndices::Create(VisMeshBuildGridIndices(NumX, NumY, Layout));
+
+	// 3. 插入时若其他线程已生成则使用已有的；顺便清理已失效的项
+	FScopeLock Lock(&GVisMeshGridIndexCacheLock);
+	if (const TWeakPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe>* Cached = GVisMeshGridIndexCache.Find(Key))
+	{
+		if (TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> Pinned = Cached->Pin())
+		{
+			return Pinned;
+		}
+	}
+	for (auto It = GVisMeshGridIndexCache.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	GVisMeshGridIndexCache.Add(Key, NewIndices);
+	return NewIndices;
+}
+
+void VisMeshCopyGridIndices(int32 NumX, int32 NumY, EVisMeshGridIndexLayout Layout, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	if (NumX < 2 || NumY < 2)
+	{
+		return;
+	}
+
+	// 仍在使用的共享索引直接拷贝，否则直接生成 (不创建只用一次的共享对象及其 GPU 资源释放命令)
+	if (TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> Pinned = VisMeshFindCachedGridIndices(FVisMeshGridKey(NumX, NumY, (uint8)Layout)))
+	{
+		OutIndices = Pinned->GetIndices();
+	}
+	else
+	{
+		OutIndices = VisMeshBuildGridIndices(NumX, NumY, Layout);
+	}
+}
+
 // --------------------------------------------------------
 // ------------------------Passes--------------------------
 // --------------------------------------------------------
@@ -268,3 +646,183 @@ void AddGenerateScatterPlotSpherePass(FRDGBuilder& GraphBuilder, FRHIUnorderedAc
 		PassParameters,
 		FIntVector(GroupCount, 1, 1));
 }
+
+DECLARE_GPU_DRAWCALL_STAT(PopulateBarChartInstancePass);
+
+void AddBarChartInstancePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* BarValuesSRV, FRHIShaderResourceView* PreviousBarValuesSRV,
+	float TransitionAlpha, FRHIShaderResourceView* BarRectsSRV, bool bUseBarRects, FRHIUnorderedAccessView* InstanceOriginBuffersUAV,
+	FRHIUnorderedAccessView* InstanceTransformsUAV, FRDGBufferUAVRef IndirectArgsBufferUAV, float InXSpace, float InYSpace,
+	float InBarWidth, int32 InNumColumns, int32 InNumInstances, FMatrix44f InProjectionViewMatrix, FMatrix44f InWorldMatrix)
+{
+	RDG_GPU_STAT_SCOPE(GraphBuilder, PopulateBarChartInstancePass); // for unreal insights
+	RDG_EVENT_SCOPE(GraphBuilder, "PopulateBarChartInstancePass"); // for render doc
+
+	TShaderMapRef<FPopulateBarChartInstanceBufferCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	FPopulateBarChartInstanceBufferCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FPopulateBarChartInstanceBufferCS::FParameters>();
+	PassParameters->BarValues = BarValuesSRV;
+	PassParameters->PreviousBarValues = PreviousBarValuesSRV;
+	PassParameters->TransitionAlpha = TransitionAlpha;
+	PassParameters->BarRects = BarRectsSRV;
+	PassParameters->UseBarRects = bUseBarRects ? 1 : 0;
+	PassParameters->OutInstanceOriginBuffer = InstanceOriginBuffersUAV;
+	PassParameters->OutInstanceTransforms = InstanceTransformsUAV;
+	PassParameters->OutIndirectArgs = IndirectArgsBufferUAV;
+	PassParameters->XSpace = InXSpace;
+	PassParameters->YSpace = InYSpace;
+	PassParameters->BarWidth = InBarWidth;
+	PassParameters->NumColumns = InNumColumns;
+	PassParameters->NumInstances = InNumInstances;
+	PassParameters->ViewProjectionMatrix = InProjectionViewMatrix;
+	PassParameters->ModelMatrix = InWorldMatrix;
+
+	int32 GroupCount = FMath::DivideAndRoundUp(InNumInstances, (int32)FPopulateBarChartInstanceBufferCS::ThreadGroupSize);
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("PopulateBarChartInstances"),
+		ERDGPassFlags::Compute | ERDGPassFlags::NeverCull,
+		ComputeShader,
+		PassParameters,
+		FIntVector(GroupCount, 1, 1)
+	);
+}
+
+DECLARE_GPU_DRAWCALL_STAT(HeightfieldDisplacePass);
+
+void AddHeightfieldDisplacePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* HeightsSRV, FRHIUnorderedAccessView* PositionsUAV,
+	FRHIUnorderedAccessView* TangentsUAV, FRHIUnorderedAccessView* TexCoordsUAV, int32 NumX, int32 NumY, float GridSpacing, int32 FirstRow, int32 NumRows)
+{
+	RDG_GPU_STAT_SCOPE(GraphBuilder, HeightfieldDisplacePass); // for unreal insights
+	RDG_EVENT_SCOPE(GraphBuilder, "HeightfieldDisplacePass"); // for render doc
+
+	TShaderMapRef<FVisMeshHeightfieldDisplaceCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	FVisMeshHeightfieldDisplaceCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FVisMeshHeightfieldDisplaceCS::FParameters>();
+	PassParameters->Heights = HeightsSRV;
+	PassParameters->OutPositions = PositionsUAV;
+	PassParameters->OutTangents = TangentsUAV;
+	PassParameters->OutTexCoords = TexCoordsUAV;
+	PassParameters->NumX = NumX;
+	PassParameters->NumY = NumY;
+	PassParameters->FirstRow = FirstRow;
+	PassParameters->NumRows = NumRows;
+	PassParameters->GridSpacing = GridSpacing;
+
+	// 每个线程处理一个顶点，只覆盖需要更新的行
+	int32 GroupCount = FMath::DivideAndRoundUp(NumX * NumRows, (int32)FVisMeshHeightfieldDisplaceCS::ThreadGroupSize);
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("HeightfieldDisplacePass"),
+		ERDGPassFlags::Compute | ERDGPassFlags::NeverCull,
+		ComputeShader,
+		PassParameters,
+		FIntVector(GroupCount, 1, 1));
+}
+
+DECLARE_GPU_DRAWCALL_STAT(TimeSeriesRibbonPass);
+
+void AddTimeSeriesRibbonPass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* SamplesSRV, FRHIUnorderedAccessView* PositionsUAV,
+	FRHIUnorderedAccessView* TangentsUAV, int32 NumChannels, int32 Capacity, int32 Head, int32 Count,
+	float SampleSpacing, float ChannelSpacing, float ValueScale, float LineWidth)
+{
+	RDG_GPU_STAT_SCOPE(GraphBuilder, TimeSeriesRibbonPass); // for unreal insights
+	RDG_EVENT_SCOPE(GraphBuilder, "TimeSeriesRibbonPass"); // for render doc
+
+	TShaderMapRef<FVisMeshTimeSeriesRibbonCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	FVisMeshTimeSeriesRibbonCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FVisMeshTimeSeriesRibbonCS::FParameters>();
+	PassParameters->Samples = SamplesSRV;
+	PassParameters->OutPositions = PositionsUAV;
+	PassParameters->OutTangents = TangentsUAV;
+	PassParameters->NumChannels = NumChannels;
+	PassParameters->Capacity = Capacity;
+	PassParameters->Head = Head;
+	PassParameters->Count = Count;
+	PassParameters->SampleSpacing = SampleSpacing;
+	PassParameters->ChannelSpacing = ChannelSpacing;
+	PassParameters->ValueScale = ValueScale;
+	PassParameters->LineWidth = LineWidth;
+
+	// 每个线程处理一个采样 (两个顶点)
+	int32 GroupCount = FMath::DivideAndRoundUp(NumChannels * Capacity, (int32)FVisMeshTimeSeriesRibbonCS::ThreadGroupSize);
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("TimeSeriesRibbonPass"),
+		ERDGPassFlags::Compute | ERDGPassFlags::NeverCull,
+		ComputeShader,
+		PassParameters,
+		FIntVector(GroupCount, 1, 1));
+}
+
+DECLARE_GPU_DRAWCALL_STAT(PopulateScatterPointInstancePass);
+
+void AddScatterPointInstancePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* PointsSRV, FRHIUnorderedAccessView* InstanceOriginBuffersUAV,
+	FRHIUnorderedAccessView* InstanceTransformsUAV, FRDGBufferUAVRef IndirectArgsBufferUAV, int32 NumPoints, float RadiusScale,
+	uint32 IndexCountPerInstance, bool bUseImpostors, FVector3f CameraPosition, FMatrix44f InProjectionViewMatrix, FMatrix44f InWorldMatrix)
+{
+	RDG_GPU_STAT_SCOPE(GraphBuilder, PopulateScatterPointInstancePass); // for unreal insights
+	RDG_EVENT_SCOPE(GraphBuilder, "PopulateScatterPointInstancePass"); // for render doc
+
+	TShaderMapRef<FPopulateScatterPointInstanceBufferCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	FPopulateScatterPointInstanceBufferCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FPopulateScatterPointInstanceBufferCS::FParameters>();
+	PassParameters->Points = PointsSRV;
+	PassParameters->OutInstanceOriginBuffer = InstanceOriginBuffersUAV;
+	PassParameters->OutInstanceTransforms = InstanceTransformsUAV;
+	PassParameters->OutIndirectArgs = IndirectArgsBufferUAV;
+	PassParameters->NumPoints = NumPoints;
+	PassParameters->RadiusScale = RadiusScale;
+	PassParameters->IndexCountPerInstance = IndexCountPerInstance;
+	PassParameters->UseImpostors = bUseImpostors ? 1 : 0;
+	PassParameters->CameraPosition = CameraPosition;
+	PassParameters->ViewProjectionMatrix = InProjectionViewMatrix;
+	PassParameters->ModelMatrix = InWorldMatrix;
+
+	// 每个线程处理一个点
+	int32 GroupCount = FMath::DivideAndRoundUp(NumPoints, (int32)FPopulateScatterPointInstanceBufferCS::ThreadGroupSize);
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("PopulateScatterPointInstances"),
+		ERDGPassFlags::Compute | ERDGPassFlags::NeverCull,
+		ComputeShader,
+		PassParameters,
+		FIntVector(GroupCount, 1, 1));
+}
+
+DECLARE_GPU_DRAWCALL_STAT(PolylineExpandPass);
+
+void AddPolylineExpandPass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* PointsSRV, FRHIShaderResourceView* StripFlagsSRV,
+	FRHIUnorderedAccessView* PositionsUAV, FRHIUnorderedAccessView* TangentsUAV, FRHIUnorderedAccessView* IndicesUAV,
+	int32 NumPoints, bool bFaceCamera, FVector3f CameraPosition, bool bWriteIndices)
+{
+	RDG_GPU_STAT_SCOPE(GraphBuilder, PolylineExpandPass); // for unreal insights
+	RDG_EVENT_SCOPE(GraphBuilder, "PolylineExpandPass"); // for render doc
+
+	TShaderMapRef<FVisMeshPolylineExpandCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	FVisMeshPolylineExpandCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FVisMeshPolylineExpandCS::FParameters>();
+	PassParameters->Points = PointsSRV;
+	PassParameters->StripFlags = StripFlagsSRV;
+	PassParameters->OutPositions = PositionsUAV;
+	PassParameters->OutTangents = TangentsUAV;
+	PassParameters->OutIndices = IndicesUAV;
+	PassParameters->NumPoints = NumPoints;
+	PassParameters->FaceCamera = bFaceCamera ? 1 : 0;
+	PassParameters->CameraPosition = CameraPosition;
+	PassParameters->WriteIndices = bWriteIndices ? 1 : 0;
+
+	// 每个线程处理一个点
+	int32 GroupCount = FMath::DivideAndRoundUp(NumPoints, (int32)FVisMeshPolylineExpandCS::ThreadGroupSize);
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder,
+		RDG_EVENT_NAME("ExpandPolylineMiter"),
+		ERDGPassFlags::Compute | ERDGPassFlags::NeverCull,
+		ComputeShader,
+		PassParameters,
+		FIntVector(GroupCount, 1, 1));
+}
@@ -4,9 +4,80 @@
 #include "VisCharts/VisBarChart.h"
 
 #include "Components/VisMeshProceduralComponent.h"
+#include "Components/VisMeshInstancedComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMaterialLibrary.h"
 #include "Utils/KismetVisMeshLibrary.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
+/** 射线与 AABB 的 Slab 相交，返回参数区间 [OutTNear, OutTFar] */
+static bool VisBarRayBox(const FVector& Origin, const FVector& Dir, const FVector& BoxMin, const FVector& BoxMax, double& OutTNear, double& OutTFar)
+{
+	double TNear = -TNumericLimits<double>::Max();
+	double TFar = TNumericLimits<double>::Max();
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		if (FMath::Abs(Dir[Axis]) < UE_DOUBLE_SMALL_NUMBER)
+		{
+			// 平行于该轴的 Slab：起点必须在 Slab 内
+			if (Origin[Axis] < BoxMin[Axis] || Origin[Axis] > BoxMax[Axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		double T0 = (BoxMin[Axis] - Origin[Axis]) / Dir[Axis];
+		double T1 = (BoxMax[Axis] - Origin[Axis]) / Dir[Axis];
+		if (T0 > T1)
+		{
+			Swap(T0, T1);
+		}
+		TNear = FMath::Max(TNear, T0);
+		TFar = FMath::Min(TFar, T1);
+		if (TNear > TFar)
+		{
+			return false;
+		}
+	}
+
+	OutTNear = TNear;
+	OutTFar = TFar;
+	return true;
+}
+
+/** 金字塔父节点 (PX, PY) 的值：下一级中对应 2x2 子节点的最大值 */
+static float VisBarPyramidNodeMax(const TArray<float>& Child, int32 ChildCols, int32 ChildRows, int32 PX, int32 PY)
+{
+	float MaxHeight = -MAX_flt;
+	for (int32 CY = PY * 2; CY < FMath::Min(PY * 2 + 2, ChildRows); CY++)
+	{
+		for (int32 CX = PX * 2; CX < FMath::Min(PX * 2 + 2, ChildCols); CX++)
+		{
+			MaxHeight = FMath::Max(MaxHeight, Child[CY * ChildCols + CX]);
+		}
+	}
+	return MaxHeight;
+}
+
+/** 聚合金字塔父节点 (PX, PY)：合并下一级中对应的 2x2 子节点 */
+static FVisBarAggregate VisBarAggregateNode(const TArray<FVisBarAggregate>& Child, int32 ChildCols, int32 ChildRows, int32 PX, int32 PY)
+{
+	FVisBarAggregate Result;
+	for (int32 CY = PY * 2; CY < FMath::Min(PY * 2 + 2, ChildRows); CY++)
+	{
+		for (int32 CX = PX * 2; CX < FMath::Min(PX * 2 + 2, ChildCols); CX++)
+		{
+			const FVisBarAggregate& Node = Child[CY * ChildCols + CX];
+			Result.Min = FMath::Min(Result.Min, Node.Min);
+			Result.Max = FMath::Max(Result.Max, Node.Max);
+			Result.Sum += Node.Sum;
+			Result.Count += Node.Count;
+		}
+	}
+	return Result;
+}
 
 // Sets default values
 AVisBarChart::AVisBarChart()
@@ -29,6 +100,12 @@ AVisBarChart::AVisBarChart()
 
 	SelectionMeshComponent = CreateDefaultSubobject<UVisMeshProceduralComponent>(TEXT("SelectionMesh"));
 	HighlightMeshComponent->SetupAttachment(RootComponent);
+
+	// 3. 实例化后端，只在 bUseInstancedRendering 时显示
+	InstancedMeshComponent = CreateDefaultSubobject<UVisMeshInstancedComponent>(TEXT("InstancedMesh"));
+	InstancedMeshComponent->SetupAttachment(RootComponent);
+	InstancedMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstancedMeshComponent->SetVisibility(false);
 }
 
 // Called when the game starts or when spawned
@@ -134,57 +211,41 @@ void AVisBarChart::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
-	if (!PC) return;
+	UpdateLODTiles();
 
-	float MouseX, MouseY;
-	if (PC->GetMousePosition(MouseX, MouseY))
+	// --- 执行 Raycast (结果按帧缓存，HandleClick 直接复用) ---
+	int32 HoverIndex = GetBarUnderCursor();
+
+	if (HoverIndex != -1)
 	{
-		FVector WorldLoc, WorldDir;
-		if (PC->DeprojectScreenPositionToWorld(MouseX, MouseY, WorldLoc, WorldDir))
+		// 状态更新逻辑 (保持不变)
+		if (HoverIndex != LastHoverIndex)
 		{
-			FTransform ActorTrans = GetTransform();
-			FVector LocalStart = ActorTrans.InverseTransformPosition(WorldLoc);
-			FVector LocalDir = ActorTrans.InverseTransformVectorNoScale(WorldDir);
+			int32 Row = HoverIndex / GridColumnCount;
+			int32 Col = HoverIndex % GridColumnCount;
 			
-			// 归一化方向（InverseTransformVectorNoScale 不保证归一化）
-			LocalDir.Normalize();
-
-			// --- 执行 Raycast ---
-			int32 HoverIndex = RaycastOnBarChart(LocalStart, LocalDir);
-
-			if (HoverIndex != -1)
-			{
-				// 状态更新逻辑 (保持不变)
-				if (HoverIndex != LastHoverIndex)
-				{
-					int32 Row = HoverIndex / GridColumnCount;
-					int32 Col = HoverIndex % GridColumnCount;
-					
-					float XPos = Col * (BarWidth + BarGap);
-					float YPos = Row * (BarWidth + BarGap);
-					
-					float RawHeight = CachedDataValues[HoverIndex] * HeightMultiplier;
-					float FinalHeight = RawHeight * HoverScale;
-
-					HighlightMeshComponent->SetRelativeLocation(FVector(XPos, YPos, FinalHeight * 0.5f));
-					float BiasScale = 1.01f; // 放大 1%
-					HighlightMeshComponent->SetRelativeScale3D(FVector(BarWidth * BiasScale, BarWidth * BiasScale, FinalHeight));
-					if (!HighlightMeshComponent->IsVisible())
-					{
-						HighlightMeshComponent->SetVisibility(true);
-					}
+			float XPos = Col * (BarWidth + BarGap);
+			float YPos = Row * (BarWidth + BarGap);
+			
+			float RawHeight = CachedDataValues[HoverIndex] * HeightMultiplier;
+			float FinalHeight = RawHeight * HoverScale;
 
-					LastHoverIndex = HoverIndex;
-				}
-			}
-			else
+			HighlightMeshComponent->SetRelativeLocation(FVector(XPos, YPos, FinalHeight * 0.5f));
+			float BiasScale = 1.01f; // 放大 1%
+			HighlightMeshComponent->SetRelativeScale3D(FVector(BarWidth * BiasScale, BarWidth * BiasScale, FinalHeight));
+			if (!HighlightMeshComponent->IsVisible())
 			{
-				HighlightMeshComponent->SetVisibility(false);
-				LastHoverIndex = -1;
+				HighlightMeshComponent->SetVisibility(true);
 			}
+
+			LastHoverIndex = HoverIndex;
 		}
 	}
+	else
+	{
+		HighlightMeshComponent->SetVisibility(false);
+		LastHoverIndex = -1;
+	}
 
 	HandleClick();
 	
@@ -194,9 +255,30 @@ void AVisBarChart::GenerateBarChart(const TArray<float>& DataValues)
 {
 	if (DataValues.Num() == 0) return;
 
-	// 1. 缓存数据
+	// 实例化模式下柱子数量不变时可以做过渡动画 (聚合瓦片不做过渡)
+	const bool bAnimate = bInstancedBars && bUseInstancedRendering && !bUseLODAggregation && TransitionDuration > 0.f && DataValues.Num() == CachedDataValues.Num();
+
+	// 1. 缓存数据，并重建拾取用的高度金字塔
 	CachedDataValues = DataValues;
 	if (GridColumnCount <= 0) GridColumnCount = 1;
+	BuildHeightPyramid();
+	CachedCursorHitFrame = MAX_uint64;
+
+	bInstancedBars = bUseInstancedRendering;
+	bLODBars = bInstancedBars && bUseLODAggregation;
+	InstancedMeshComponent->SetVisibility(bInstancedBars);
+	if (!bLODBars)
+	{
+		AggregatePyramid.Empty();
+	}
+	if (bInstancedBars)
+	{
+		// 实例化后端不需要合并网格
+		TemplateVerts.Reset();
+		MainMeshComponent->ClearAllMeshSections();
+		GenerateInstancedBars(bAnimate);
+		return;
+	}
 
 	// 2. 准备模板 (1x1x1 盒子)
 	TArray<int32> TemplateTris;
@@ -221,26 +303,14 @@ void AVisBarChart::GenerateBarChart(const TArray<float>& DataValues)
 	// 4. [关键优化] 并行计算几何体
 	ParallelFor(NumBars, [&](int32 i)
 	{
-		// 计算网格行列
-		int32 Row = i / GridColumnCount;
-		int32 Col = i % GridColumnCount;
-
-		// 计算变换
-		float Height = DataValues[i] * HeightMultiplier;
-		float XPos = Col * (BarWidth + BarGap);
-		float YPos = Row * (BarWidth + BarGap); // Y轴向下延伸
-		
-		FVector Location(XPos, YPos, Height * 0.5f);
-		FVector Scale(BarWidth, BarWidth, Height);
-
 		int32 BaseVertIdx = i * VertsPerBar;
 
+		// 变换顶点位置 (UpdateBarValues 也只重写这一部分)
+		WriteBarPositions(i, &MeshData.Positions[BaseVertIdx]);
+
 		// 填充该柱子的所有顶点
 		for (int32 v = 0; v < VertsPerBar; v++)
 		{
-			// 变换顶点位置
-			MeshData.Positions[BaseVertIdx + v] = Location + (TemplateVerts[v] * Scale);
-			
 			// 复制属性
 			MeshData.Normals[BaseVertIdx + v] = TemplateNormals[v];
 			MeshData.UV0[BaseVertIdx + v] = TemplateUVs[v];
@@ -266,6 +336,215 @@ void AVisBarChart::GenerateBarChart(const TArray<float>& DataValues)
 	MainMeshComponent->CreateMeshSection(0, MoveTemp(MeshData), false);
 }
 
+void AVisBarChart::GenerateInstancedBars(bool bAnimate)
+{
+	UMaterialInterface* Material = InstancedMeshMaterial ? InstancedMeshMaterial : MainMeshMaterial;
+	if (Material && InstancedMeshComponent->Material != Material)
+	{
+		InstancedMeshComponent->Material = Material;
+		InstancedMeshComponent->MarkRenderStateDirty();
+	}
+
+	if (bLODBars)
+	{
+		// 聚合瓦片：立即按当前相机选择一次，之后由 Tick 在相机移动时更新
+		BuildAggregatePyramid();
+		bLODTilesDirty = true;
+		UpdateLODTiles();
+		return;
+	}
+
+	// 与 WriteBarPositions 相同的网格布局：柱子以格点为中心 (布局不变时不重建 Proxy，过渡才能在原缓冲区上进行)
+	const float Spacing = BarWidth + BarGap;
+	if (InstancedMeshComponent->NumColumns != GridColumnCount || InstancedMeshComponent->XSpace != Spacing
+		|| InstancedMeshComponent->YSpace != Spacing || InstancedMeshComponent->BarWidth != BarWidth)
+	{
+		InstancedMeshComponent->SetBarLayout(GridColumnCount, Spacing, Spacing, BarWidth);
+	}
+
+	TArray<FVector2f> BarValues;
+	BarValues.SetNumUninitialized(CachedDataValues.Num());
+	ParallelFor(CachedDataValues.Num(), [&](int32 i)
+	{
+		BarValues[i] = FVector2f(CachedDataValues[i] * HeightMultiplier, CachedDataValues[i]);
+	});
+
+	if (bAnimate)
+	{
+		InstancedMeshComponent->SetBarValuesAnimated(MoveTemp(BarValues), TransitionDuration);
+	}
+	else
+	{
+		InstancedMeshComponent->SetBarValues(MoveTemp(BarValues));
+	}
+}
+
+void AVisBarChart::WriteBarPositions(int32 BarIndex, FVector* OutPositions) const
+{
+	// 计算网格行列
+	int32 Row = BarIndex / GridColumnCount;
+	int32 Col = BarIndex % GridColumnCount;
+
+	// 计算变换
+	float Height = CachedDataValues[BarIndex] * HeightMultiplier;
+	float XPos = Col * (BarWidth + BarGap);
+	float YPos = Row * (BarWidth + BarGap); // Y轴向下延伸
+
+	FVector Location(XPos, YPos, Height * 0.5f);
+	FVector Scale(BarWidth, BarWidth, Height);
+
+	for (int32 v = 0; v < TemplateVerts.Num(); v++)
+	{
+		OutPositions[v] = Location + (TemplateVerts[v] * Scale);
+	}
+}
+
+void AVisBarChart::UpdateBarValues(const TArray<int32>& Indices, const TArray<float>& NewValues)
+{
+	if (Indices.Num() != NewValues.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UpdateBarValues: %d indices but %d values."), Indices.Num(), NewValues.Num());
+		return;
+	}
+
+	// 1. 写入新数值，重复的索引以最后一次为准
+	TArray<int32> SortedBars;
+	SortedBars.Reserve(Indices.Num());
+	for (int32 i = 0; i < Indices.Num(); i++)
+	{
+		if (CachedDataValues.IsValidIndex(Indices[i]))
+		{
+			CachedDataValues[Indices[i]] = NewValues[i];
+			SortedBars.Add(Indices[i]);
+		}
+	}
+
+	SortedBars.Sort();
+	SortedBars.SetNum(Algo::Unique(SortedBars));
+	ApplyBarValueUpdates(SortedBars);
+}
+
+void AVisBarChart::UpdateBarValueRange(int32 FirstIndex, const TArray<float>& NewValues)
+{
+	const int32 First = FMath::Max(FirstIndex, 0);
+	const int32 End = FMath::Min(FirstIndex + NewValues.Num(), CachedDataValues.Num());
+	if (End <= First) return;
+
+	TArray<int32> Bars;
+	Bars.SetNumUninitialized(End - First);
+	for (int32 Bar = First; Bar < End; Bar++)
+	{
+		CachedDataValues[Bar] = NewValues[Bar - FirstIndex];
+		Bars[Bar - First] = Bar;
+	}
+
+	ApplyBarValueUpdates(Bars);
+}
+
+void AVisBarChart::ApplyBarValueUpdates(const TArray<int32>& SortedBars)
+{
+	// 实例化模式每根柱子只有一个元素，合并网格模式每根柱子有 VertsPerBar 个顶点
+	const int32 VertsPerBar = bInstancedBars ? 1 : TemplateVerts.Num();
+	if (SortedBars.Num() == 0 || VertsPerBar == 0) return;
+
+	// 1. 相邻的柱子合并为一个区间
+	TArray<FIntPoint> Ranges;
+	for (int32 Bar : SortedBars)
+	{
+		if (Ranges.Num() > 0 && Ranges.Last().X + Ranges.Last().Y == Bar * VertsPerBar)
+		{
+			Ranges.Last().Y += VertsPerBar;
+		}
+		else
+		{
+			Ranges.Add(FIntPoint(Bar * VertsPerBar, VertsPerBar));
+		}
+	}
+
+	if (bLODBars)
+	{
+		// 2a. 聚合瓦片：更新金字塔，下一帧重新选择瓦片
+		UpdateAggregatePyramid(SortedBars);
+		bLODTilesDirty = true;
+	}
+	else if (bInstancedBars)
+	{
+		// 2b. 实例化模式：只上传这些柱子的 (高度, 数值)
+		TArray<FVector2f> Values;
+		Values.SetNumUninitialized(SortedBars.Num());
+		for (int32 i = 0; i < SortedBars.Num(); i++)
+		{
+			const float Value = CachedDataValues[SortedBars[i]];
+			Values[i] = FVector2f(Value * HeightMultiplier, Value);
+		}
+		InstancedMeshComponent->UpdateBarValueRanges(Ranges, Values);
+	}
+	else
+	{
+		// 2c. 并行重写这些柱子的顶点：法线、UV、颜色与高度无关，只需更新位置
+		FVisMeshData RangeData;
+		RangeData.Positions.SetNumUninitialized(SortedBars.Num() * VertsPerBar);
+		ParallelFor(SortedBars.Num(), [&](int32 i)
+		{
+			WriteBarPositions(SortedBars[i], &RangeData.Positions[i * VertsPerBar]);
+		});
+
+		// 3. 只上传这些区间，不重建 Proxy
+		MainMeshComponent->UpdateMeshSectionRanges(0, Ranges, RangeData);
+	}
+
+	// 4. 拾取结构与高亮/选中状态
+	UpdateHeightPyramid(SortedBars);
+	CachedCursorHitFrame = MAX_uint64;
+	LastHoverIndex = -1; // 下一帧 Tick 按新高度刷新高亮
+
+	if (SelectedIndex != -1 && Algo::BinarySearch(SortedBars, SelectedIndex) != INDEX_NONE)
+	{
+		// 与 HandleClick 相同的选框尺寸
+		GenerateSelectionFrame(BarWidth + 2.0f, CachedDataValues[SelectedIndex] * HeightMultiplier + 2.0f, 5.0f);
+	}
+}
+
+void AVisBarChart::UpdateHeightPyramid(const TArray<int32>& SortedBars)
+{
+	if (HeightPyramid.Num() == 0) return;
+
+	// 1. Level 0
+	for (int32 Bar : SortedBars)
+	{
+		const float Height = CachedDataValues[Bar] * HeightMultiplier;
+		HeightPyramid[0][Bar] = FMath::Max(Height, 0.f);
+		MinBarZ = FMath::Min(MinBarZ, Height);
+	}
+
+	// 2. 逐级只重新计算变化节点的父节点
+	TArray<int32> ChangedNodes = SortedBars;
+	int32 LevelCols = GridColumnCount;
+	int32 LevelRows = GridRowCount;
+	for (int32 Level = 1; Level < HeightPyramid.Num(); Level++)
+	{
+		const int32 ParentCols = FMath::DivideAndRoundUp(LevelCols, 2);
+
+		TArray<int32> ParentNodes;
+		ParentNodes.Reserve(ChangedNodes.Num());
+		for (int32 Node : ChangedNodes)
+		{
+			ParentNodes.Add((Node / LevelCols / 2) * ParentCols + (Node % LevelCols) / 2);
+		}
+		ParentNodes.Sort();
+		ParentNodes.SetNum(Algo::Unique(ParentNodes));
+
+		for (int32 Parent : ParentNodes)
+		{
+			HeightPyramid[Level][Parent] = VisBarPyramidNodeMax(HeightPyramid[Level - 1], LevelCols, LevelRows, Parent % ParentCols, Parent / ParentCols);
+		}
+
+		ChangedNodes = MoveTemp(ParentNodes);
+		LevelCols = ParentCols;
+		LevelRows = FMath::DivideAndRoundUp(LevelRows, 2);
+	}
+}
+
 void AVisBarChart::HandleClick()
 {
 	APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
@@ -274,25 +553,8 @@ void AVisBarChart::HandleClick()
     // 检查左键是否刚刚按下
     if (PC->WasInputKeyJustPressed(EKeys::LeftMouseButton))
     {
-        // 复用之前的 Raycast 逻辑获取当前鼠标下的索引
-        // 注意：这里需要你把 Tick 里的 Raycast 逻辑稍微封装一下，或者直接复制过来
-        // 假设我们有一个成员变量 CurrentHoverIndex 记录了 Tick 中计算出的结果
-        int32 TargetIndex = LastHoverIndex; // LastHoverIndex 是我们在 Tick 里算的
-    	float MouseX, MouseY;
-    	if (!PC->GetMousePosition(MouseX, MouseY)) return;
-    	FVector WorldLoc, WorldDir;
-    	if (PC->DeprojectScreenPositionToWorld(MouseX, MouseY, WorldLoc, WorldDir))
-    	{
-    		FTransform ActorTrans = GetTransform();
-    		FVector LocalStart = ActorTrans.InverseTransformPosition(WorldLoc);
-    		FVector LocalDir = ActorTrans.InverseTransformVectorNoScale(WorldDir);
-			
-    		// 归一化方向（InverseTransformVectorNoScale 不保证归一化）
-    		LocalDir.Normalize();
-
-    		// --- 执行 Raycast ---
-    		TargetIndex = RaycastOnBarChart(LocalStart, LocalDir);
-    	}
+        // 复用 Tick 中本帧已经计算的拾取结果
+        int32 TargetIndex = GetBarUnderCursor();
 
         if (TargetIndex != -1)
         {
@@ -337,80 +599,394 @@ void AVisBarChart::HandleClick()
     }
 }
 
-int32 AVisBarChart::RaycastOnBarChart(FVector LocalStart, FVector LocalDir) const
+void AVisBarChart::BuildHeightPyramid()
 {
-	// 1. 基础参数
-	float CellSize = BarWidth + BarGap;
-	float HalfBarWidth = BarWidth * 0.5f;
-	
-	// 步长：为了性能和精度的平衡，步长设为柱子宽度的一半是比较安全的
-	// 太大会穿模，太小会浪费性能
-	float StepSize = BarWidth * 0.5f; 
-	FVector StepVec = LocalDir * StepSize;
-
-	// 2. 确定搜索范围
-	// 如果相机在上方，我们向下搜索直到 Z=0
-	// 也就是光线行进的总距离预估
-	float MaxDist = 200000.0f; // 设置一个最大距离防止死循环
-	
-	// 优化：如果射线是朝上的（LocalDir.Z > 0），且起点已经在最高柱子之上，那就不可能命中
-	// 这里简单处理，假设主要从上往下看
+	HeightPyramid.Reset();
+	MinBarZ = 0.f;
 
-	FVector CurrentPos = LocalStart;
+	const int32 NumBars = CachedDataValues.Num();
+	GridRowCount = FMath::DivideAndRoundUp(NumBars, GridColumnCount);
+	if (NumBars == 0)
+	{
+		return;
+	}
+
+	// 1. Level 0：每个格子的柱顶高度，最后一行的空格子永远可以跳过
+	TArray<float> Base;
+	Base.SetNumUninitialized(GridColumnCount * GridRowCount);
+	ParallelFor(Base.Num(), [&](int32 i)
+	{
+		Base[i] = i < NumBars ? FMath::Max(CachedDataValues[i] * HeightMultiplier, 0.f) : -MAX_flt;
+	});
+	HeightPyramid.Add(MoveTemp(Base));
 
-	// 3. 步进循环 (Ray Marching)
-	// 限制最大步数，例如 500 步 (足够覆盖很长的视距)
-	for (int32 Step = 0; Step < 1000; ++Step)
+	for (float Value : CachedDataValues)
 	{
-		// 如果 Z 小于 0，说明穿过了地面，肯定没戏了 (假设柱子底面在 Z=0)
-		if (CurrentPos.Z < 0.0f) 
+		MinBarZ = FMath::Min(MinBarZ, Value * HeightMultiplier);
+	}
+
+	// 2. 逐级 2x2 取最大，直到 1x1
+	int32 LevelCols = GridColumnCount;
+	int32 LevelRows = GridRowCount;
+	while (LevelCols > 1 || LevelRows > 1)
+	{
+		const int32 ParentCols = FMath::DivideAndRoundUp(LevelCols, 2);
+		const int32 ParentRows = FMath::DivideAndRoundUp(LevelRows, 2);
+		const TArray<float>& Child = HeightPyramid.Last();
+
+		TArray<float> Parent;
+		Parent.SetNumUninitialized(ParentCols * ParentRows);
+		ParallelFor(ParentRows, [&](int32 PY)
 		{
-			return -1;
+			for (int32 PX = 0; PX < ParentCols; PX++)
+			{
+				Parent[PY * ParentCols + PX] = VisBarPyramidNodeMax(Child, LevelCols, LevelRows, PX, PY);
+			}
+		});
+
+		HeightPyramid.Add(MoveTemp(Parent));
+		LevelCols = ParentCols;
+		LevelRows = ParentRows;
+	}
+}
+
+void AVisBarChart::BuildAggregatePyramid()
+{
+	AggregatePyramid.Reset();
+
+	const int32 NumBars = CachedDataValues.Num();
+	if (NumBars == 0)
+	{
+		return;
+	}
+
+	// 1. Level 0：每个格子一个数值，最后一行的空格子 Count 为 0
+	TArray<FVisBarAggregate> Base;
+	Base.SetNum(GridColumnCount * GridRowCount);
+	ParallelFor(NumBars, [&](int32 i)
+	{
+		const float Value = CachedDataValues[i];
+		Base[i] = { Value, Value, Value, 1 };
+	});
+	AggregatePyramid.Add(MoveTemp(Base));
+
+	// 2. 逐级 2x2 合并，直到 1x1
+	int32 LevelCols = GridColumnCount;
+	int32 LevelRows = GridRowCount;
+	while (LevelCols > 1 || LevelRows > 1)
+	{
+		const int32 ParentCols = FMath::DivideAndRoundUp(LevelCols, 2);
+		const int32 ParentRows = FMath::DivideAndRoundUp(LevelRows, 2);
+		const TArray<FVisBarAggregate>& Child = AggregatePyramid.Last();
+
+		TArray<FVisBarAggregate> Parent;
+		Parent.SetNum(ParentCols * ParentRows);
+		ParallelFor(ParentRows, [&](int32 PY)
+		{
+			for (int32 PX = 0; PX < ParentCols; PX++)
+			{
+				Parent[PY * ParentCols + PX] = VisBarAggregateNode(Child, LevelCols, LevelRows, PX, PY);
+			}
+		});
+
+		AggregatePyramid.Add(MoveTemp(Parent));
+		LevelCols = ParentCols;
+		LevelRows = ParentRows;
+	}
+}
+
+void AVisBarChart::UpdateAggregatePyramid(const TArray<int32>& SortedBars)
+{
+	if (AggregatePyramid.Num() == 0) return;
+
+	// 1. Level 0
+	for (int32 Bar : SortedBars)
+	{
+		const float Value = CachedDataValues[Bar];
+		AggregatePyramid[0][Bar] = { Value, Value, Value, 1 };
+	}
+
+	// 2. 逐级只重新计算变化节点的父节点 (与 UpdateHeightPyramid 相同)
+	TArray<int32> ChangedNodes = SortedBars;
+	int32 LevelCols = GridColumnCount;
+	int32 LevelRows = GridRowCount;
+	for (int32 Level = 1; Level < AggregatePyramid.Num(); Level++)
+	{
+		const int32 ParentCols = FMath::DivideAndRoundUp(LevelCols, 2);
+
+		TArray<int32> ParentNodes;
+		ParentNodes.Reserve(ChangedNodes.Num());
+		for (int32 Node : ChangedNodes)
+		{
+			ParentNodes.Add((Node / LevelCols / 2) * ParentCols + (Node % LevelCols) / 2);
 		}
+		ParentNodes.Sort();
+		ParentNodes.SetNum(Algo::Unique(ParentNodes));
 
-		// --- 空间哈希 (Spatial Hashing) ---
-		// 计算当前点所在的格子行列
-		// 注意：GenerateBarChart 中 Location = Col * CellSize
-		// 这意味着柱子中心在整数格点上
-		int32 Col = FMath::RoundToInt(CurrentPos.X / CellSize);
-		int32 Row = FMath::RoundToInt(CurrentPos.Y / CellSize);
+		for (int32 Parent : ParentNodes)
+		{
+			AggregatePyramid[Level][Parent] = VisBarAggregateNode(AggregatePyramid[Level - 1], LevelCols, LevelRows, Parent % ParentCols, Parent / ParentCols);
+		}
+
+		ChangedNodes = MoveTemp(ParentNodes);
+		LevelCols = ParentCols;
+		LevelRows = FMath::DivideAndRoundUp(LevelRows, 2);
+	}
+}
+
+void AVisBarChart::UpdateLODTiles()
+{
+	if (!bLODBars || AggregatePyramid.Num() == 0) return;
 
-		// 检查索引是否越界
-		if (Col >= 0 && Col < GridColumnCount)
+	APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
+	if (!PC || !PC->PlayerCameraManager) return;
+
+	int32 ViewX = 0, ViewY = 0;
+	PC->GetViewportSize(ViewX, ViewY);
+	if (ViewX <= 0 || ViewY <= 0) return;
+
+	// 1. 相机转换到图表局部空间 (假设等比缩放)
+	const FTransform& ChartTransform = MainMeshComponent->GetComponentTransform();
+	const FVector LocalCamera = ChartTransform.InverseTransformPosition(PC->PlayerCameraManager->GetCameraLocation());
+	const FVector LocalForward = ChartTransform.InverseTransformVectorNoScale(PC->PlayerCameraManager->GetCameraRotation().Vector());
+	const float FOV = PC->PlayerCameraManager->GetFOVAngle();
+
+	// 2. 相机几乎没动时沿用上一次的瓦片：移动距离相对到图表的距离很小时，瓦片的屏幕尺寸几乎不变
+	const float Spacing = BarWidth + BarGap;
+	const FBox ChartBox(FVector(-BarWidth * 0.5f, -BarWidth * 0.5f, MinBarZ),
+		FVector((GridColumnCount - 1) * Spacing + BarWidth * 0.5f, (GridRowCount - 1) * Spacing + BarWidth * 0.5f, FMath::Max(HeightPyramid.Last()[0], 0.f)));
+	const double ChartDistance = FMath::Sqrt(ChartBox.ComputeSquaredDistanceToPoint(LocalCamera));
+	if (!bLODTilesDirty && FOV == LastLODFOV && LastLODViewportSize == FIntPoint(ViewX, ViewY)
+		&& FVector::Dist(LocalCamera, LastLODCameraLocation) < 0.01 * ChartDistance
+		&& FVector::DotProduct(LocalForward, LastLODCameraDirection) > 0.9999)
+	{
+		return;
+	}
+	bLODTilesDirty = false;
+	LastLODCameraLocation = LocalCamera;
+	LastLODCameraDirection = LocalForward;
+	LastLODFOV = FOV;
+	LastLODViewportSize = FIntPoint(ViewX, ViewY);
+
+	// 3. 投影参数：单位长度在距离 1 处的像素数，以及包住整个视口的圆锥 (用于剔除视野外的节点)
+	const double TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FOV * 0.5));
+	const double PixelsPerUnit = ViewX * 0.5 / TanHalfFOV * ChartTransform.GetMaximumAxisScale();
+	const double ConeHalfAngle = FMath::Atan(TanHalfFOV * FMath::Sqrt(1.0 + FMath::Square(double(ViewY) / ViewX)));
+	const double ConeSin = FMath::Sin(ConeHalfAngle);
+	const double ConeCos = FMath::Cos(ConeHalfAngle);
+
+	// 4. 从顶层向下细分：节点在屏幕上大于 LODTilePixelSize 时展开 2x2 子节点，否则输出一个瓦片
+	TArray<FVector4f> Rects;
+	TArray<FVector2f> Values;
+	TArray<FIntVector> Stack;
+	Stack.Add(FIntVector(0, 0, AggregatePyramid.Num() - 1));
+	while (Stack.Num() > 0)
+	{
+		const FIntVector NodeCoord = Stack.Pop();
+		const int32 Level = NodeCoord.Z;
+		const int32 LevelCols = FMath::DivideAndRoundUp(GridColumnCount, 1 << Level);
+		const FVisBarAggregate& Node = AggregatePyramid[Level][NodeCoord.Y * LevelCols + NodeCoord.X];
+		if (Node.Count == 0)
 		{
-			int32 Index = Row * GridColumnCount + Col;
-			
-			// 确保 Index 在有效数据范围内
-			if (CachedDataValues.IsValidIndex(Index))
+			continue;
+		}
+
+		// 节点覆盖的格子 [Col0, Col1) x [Row0, Row1)
+		const int32 Col0 = NodeCoord.X << Level;
+		const int32 Row0 = NodeCoord.Y << Level;
+		const int32 Col1 = FMath::Min(Col0 + (1 << Level), GridColumnCount);
+		const int32 Row1 = FMath::Min(Row0 + (1 << Level), GridRowCount);
+		const FVector2f RectMin(Col0 * Spacing - BarWidth * 0.5f, Row0 * Spacing - BarWidth * 0.5f);
+		const FVector2f RectSize((Col1 - Col0 - 1) * Spacing + BarWidth, (Row1 - Row0 - 1) * Spacing + BarWidth);
+
+		const float ZMin = FMath::Min3(Node.Min * HeightMultiplier, Node.Max * HeightMultiplier, 0.f);
+		const float ZMax = FMath::Max3(Node.Min * HeightMultiplier, Node.Max * HeightMultiplier, 0.f);
+		const FBox NodeBox(FVector(RectMin.X, RectMin.Y, ZMin), FVector(RectMin.X + RectSize.X, RectMin.Y + RectSize.Y, ZMax));
+
+		// 4.1 包围球完全在视锥圆锥外的节点直接剔除 (到圆锥母线的距离，保守)
+		const FVector ToCenter = NodeBox.GetCenter() - LocalCamera;
+		const double Radius = NodeBox.GetExtent().Size();
+		const double Along = FVector::DotProduct(ToCenter, LocalForward);
+		const double Across = FMath::Sqrt(FMath::Max(ToCenter.SizeSquared() - Along * Along, 0.0));
+		if (Across * ConeCos - Along * ConeSin > Radius)
+		{
+			continue;
+		}
+
+		// 4.2 屏幕尺寸足够大时细分
+		if (Level > 0)
+		{
+			const double Distance = FMath::Max(FMath::Sqrt(NodeBox.ComputeSquaredDistanceToPoint(LocalCamera)), 1.0);
+			if (FMath::Max(RectSize.X, RectSize.Y) * PixelsPerUnit / Distance > LODTilePixelSize)
 			{
-				// --- 命中测试 (Intersection Test) ---
-				
-				// 1. 检查高度：当前点必须在柱子高度范围内
-				float BarHeight = CachedDataValues[Index] * HeightMultiplier;
-				if (CurrentPos.Z <= BarHeight)
+				const int32 ChildCols = FMath::DivideAndRoundUp(GridColumnCount, 1 << (Level - 1));
+				const int32 ChildRows = FMath::DivideAndRoundUp(GridRowCount, 1 << (Level - 1));
+				for (int32 CY = NodeCoord.Y * 2; CY < FMath::Min(NodeCoord.Y * 2 + 2, ChildRows); CY++)
 				{
-					// 2. 检查水平范围 (XZ/YZ)：
-					// 虽然我们算出了 Row/Col，但我们可能只是路过这个格子的空隙(Gap)
-					// 需要精确判断是否在 BarWidth 的范围内
-					float BarCenterX = Col * CellSize;
-					float BarCenterY = Row * CellSize;
-
-					if (FMath::Abs(CurrentPos.X - BarCenterX) <= HalfBarWidth &&
-						FMath::Abs(CurrentPos.Y - BarCenterY) <= HalfBarWidth)
+					for (int32 CX = NodeCoord.X * 2; CX < FMath::Min(NodeCoord.X * 2 + 2, ChildCols); CX++)
 					{
-						// **命中！**
-						// 光线确实进入了这个柱子的实体内部
-						return Index;
+						Stack.Add(FIntVector(CX, CY, Level - 1));
 					}
 				}
+				continue;
 			}
 		}
 
-		// 没命中，向前走一步
-		CurrentPos += StepVec;
+		// 4.3 输出瓦片：高度按 LODTileHeight 取值，颜色值为均值
+		const float Mean = float(Node.Sum / Node.Count);
+		const float TileValue = LODTileHeight == EVisBarAggregateHeight::Max ? Node.Max : (LODTileHeight == EVisBarAggregateHeight::Min ? Node.Min : Mean);
+		Rects.Add(FVector4f(RectMin.X, RectMin.Y, RectSize.X, RectSize.Y));
+		Values.Add(FVector2f(TileValue * HeightMultiplier, Mean));
+	}
+
+	// 5. 上传 (容量足够时不重建 Proxy)
+	InstancedMeshComponent->SetBarRects(MoveTemp(Rects), MoveTemp(Values));
+}
+
+int32 AVisBarChart::GetBarUnderCursor()
+{
+	if (CachedCursorHitFrame == GFrameCounter)
+	{
+		return CachedCursorHitIndex;
+	}
+	CachedCursorHitFrame = GFrameCounter;
+	CachedCursorHitIndex = -1;
+
+	APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
+	if (!PC) return -1;
+
+	float MouseX, MouseY;
+	FVector WorldLoc, WorldDir;
+	if (PC->GetMousePosition(MouseX, MouseY) && PC->DeprojectScreenPositionToWorld(MouseX, MouseY, WorldLoc, WorldDir))
+	{
+		FTransform ActorTrans = GetTransform();
+		FVector LocalStart = ActorTrans.InverseTransformPosition(WorldLoc);
+		FVector LocalDir = ActorTrans.InverseTransformVectorNoScale(WorldDir);
+
+		// 归一化方向（InverseTransformVectorNoScale 不保证归一化）
+		LocalDir.Normalize();
+
+		CachedCursorHitIndex = RaycastOnBarChart(LocalStart, LocalDir);
+	}
+
+	return CachedCursorHitIndex;
+}
+
+int32 AVisBarChart::RaycastOnBarChart(FVector LocalStart, FVector LocalDir) const
+{
+	if (HeightPyramid.Num() == 0)
+	{
+		return -1;
+	}
+
+	// 1. 基础参数
+	// 注意：GenerateBarChart 中 Location = Col * CellSize，柱子中心在整数格点上
+	// 因此格子 (Col, Row) 覆盖 [Col - 0.5, Col + 0.5] * CellSize
+	const double CellSize = BarWidth + BarGap;
+	const double HalfBarWidth = BarWidth * 0.5;
+	const double GridMinX = -0.5 * CellSize;
+	const double GridMinY = -0.5 * CellSize;
+	const int32 NumLevels = HeightPyramid.Num();
+
+	// 2. 射线与整个图表的包围盒求交，不相交直接返回
+	const FVector GridMin(GridMinX, GridMinY, MinBarZ);
+	const FVector GridMax(GridMinX + GridColumnCount * CellSize, GridMinY + GridRowCount * CellSize, HeightPyramid.Last()[0]);
+	double TEnter, TExit;
+	if (!VisBarRayBox(LocalStart, LocalDir, GridMin, GridMax, TEnter, TExit) || TExit < 0.0)
+	{
+		return -1;
 	}
 
-	return -1;
+	double T = FMath::Max(TEnter, 0.0);
+	int32 Col = FMath::Clamp(FMath::FloorToInt((LocalStart.X + LocalDir.X * T - GridMinX) / CellSize), 0, GridColumnCount - 1);
+	int32 Row = FMath::Clamp(FMath::FloorToInt((LocalStart.Y + LocalDir.Y * T - GridMinY) / CellSize), 0, GridRowCount - 1);
+
+	// 射线离开格子范围 [X0, X1) x [Y0, Y1) 的参数，以及穿出的轴 (0 = X, 1 = Y)
+	auto ExitCells = [&](int32 X0, int32 X1, int32 Y0, int32 Y1, int32& OutAxis) -> double
+	{
+		double TX = TNumericLimits<double>::Max();
+		double TY = TNumericLimits<double>::Max();
+		if (LocalDir.X > UE_DOUBLE_SMALL_NUMBER) TX = (GridMinX + X1 * CellSize - LocalStart.X) / LocalDir.X;
+		else if (LocalDir.X < -UE_DOUBLE_SMALL_NUMBER) TX = (GridMinX + X0 * CellSize - LocalStart.X) / LocalDir.X;
+		if (LocalDir.Y > UE_DOUBLE_SMALL_NUMBER) TY = (GridMinY + Y1 * CellSize - LocalStart.Y) / LocalDir.Y;
+		else if (LocalDir.Y < -UE_DOUBLE_SMALL_NUMBER) TY = (GridMinY + Y0 * CellSize - LocalStart.Y) / LocalDir.Y;
+		OutAxis = TX <= TY ? 0 : 1;
+		return FMath::Min(FMath::Min(TX, TY), TExit);
+	};
+
+	// 3. 2D DDA：每次前进一个格子，或前进一个射线整体高于其最高柱顶的金字塔节点
+	while (true)
+	{
+		int32 SkipX0 = Col, SkipX1 = Col + 1, SkipY0 = Row, SkipY1 = Row + 1;
+		int32 ExitAxis = 0;
+		double ExitT = ExitCells(SkipX0, SkipX1, SkipY0, SkipY1, ExitAxis);
+		bool bSkipped = false;
+
+		// 3.1 自底向上找到可以整体跳过的最大节点 (父节点可跳过则子节点必可跳过)
+		for (int32 Level = 0; Level < NumLevels; Level++)
+		{
+			const int32 LevelCols = FMath::DivideAndRoundUp(GridColumnCount, 1 << Level);
+			const int32 NX = Col >> Level;
+			const int32 NY = Row >> Level;
+			const int32 X0 = NX << Level;
+			const int32 X1 = FMath::Min((NX + 1) << Level, GridColumnCount);
+			const int32 Y0 = NY << Level;
+			const int32 Y1 = FMath::Min((NY + 1) << Level, GridRowCount);
+
+			int32 NodeAxis;
+			const double NodeExitT = ExitCells(X0, X1, Y0, Y1, NodeAxis);
+			const double RayMinZ = FMath::Min(LocalStart.Z + LocalDir.Z * T, LocalStart.Z + LocalDir.Z * NodeExitT);
+			if (RayMinZ <= HeightPyramid[Level][NY * LevelCols + NX])
+			{
+				break;
+			}
+
+			SkipX0 = X0; SkipX1 = X1; SkipY0 = Y0; SkipY1 = Y1;
+			ExitAxis = NodeAxis;
+			ExitT = NodeExitT;
+			bSkipped = true;
+		}
+
+		// 3.2 格子不能跳过：精确测试这根柱子的包围盒 (负值柱子向下延伸)
+		if (!bSkipped)
+		{
+			const int32 Index = Row * GridColumnCount + Col;
+			if (CachedDataValues.IsValidIndex(Index))
+			{
+				const double BarHeight = CachedDataValues[Index] * HeightMultiplier;
+				const FVector BarMin(Col * CellSize - HalfBarWidth, Row * CellSize - HalfBarWidth, FMath::Min(BarHeight, 0.0));
+				const FVector BarMax(Col * CellSize + HalfBarWidth, Row * CellSize + HalfBarWidth, FMath::Max(BarHeight, 0.0));
+				double TNear, TFar;
+				if (VisBarRayBox(LocalStart, LocalDir, BarMin, BarMax, TNear, TFar) && TFar >= 0.0)
+				{
+					// **命中！** 格子按射线顺序访问，第一个命中即最近的柱子
+					return Index;
+				}
+			}
+		}
+
+		// 3.3 穿过出射面进入相邻格子
+		if (ExitT >= TExit)
+		{
+			return -1;
+		}
+		T = ExitT;
+		if (ExitAxis == 0)
+		{
+			Col = LocalDir.X > 0 ? SkipX1 : SkipX0 - 1;
+			Row = FMath::Clamp(FMath::FloorToInt((LocalStart.Y + LocalDir.Y * T - GridMinY) / CellSize), SkipY0, SkipY1 - 1);
+		}
+		else
+		{
+			Row = LocalDir.Y > 0 ? SkipY1 : SkipY0 - 1;
+			Col = FMath::Clamp(FMath::FloorToInt((LocalStart.X + LocalDir.X * T - GridMinX) / CellSize), SkipX0, SkipX1 - 1);
+		}
+
+		if (Col < 0 || Col >= GridColumnCount || Row < 0 || Row >= GridRowCount)
+		{
+			return -1;
+		}
+	}
 }
 
 void AVisBarChart::GenerateSelectionFrame(float Width, float Height, float Thickness)
@@ -0,0 +1,83 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#include "VisCharts/VisStreamingChart.h"
+
+#include "Components/VisMeshTimeSeriesComponent.h"
+
+// Sets default values
+AVisStreamingChart::AVisStreamingChart()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+
+	SeriesComponent = CreateDefaultSubobject<UVisMeshTimeSeriesComponent>(TEXT("SeriesMesh"));
+	RootComponent = SeriesComponent;
+	SeriesComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+}
+
+// Called when the game starts or when spawned
+void AVisStreamingChart::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (SeriesMaterial)
+	{
+		SeriesComponent->SetMaterial(0, SeriesMaterial);
+	}
+
+	ResetStream();
+}
+
+void AVisStreamingChart::ResetStream()
+{
+	SeriesComponent->SampleSpacing = SampleSpacing;
+	SeriesComponent->ChannelSpacing = ChannelSpacing;
+	SeriesComponent->ValueScale = HeightMultiplier;
+	SeriesComponent->LineWidth = LineWidth;
+	SeriesComponent->SetChannelColors(ChannelColors);
+	SeriesComponent->SetStreamLayout(NumChannels, SamplesPerChannel);
+
+	TestTime = 0.0;
+	PendingTestSamples = 0.0;
+}
+
+void AVisStreamingChart::AppendSamples(const TArray<float>& Frames)
+{
+	SeriesComponent->AppendSamples(Frames);
+}
+
+// Called every frame
+void AVisStreamingChart::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (TestSamplesPerSecond <= 0.f)
+	{
+		return;
+	}
+
+	// 测试信号：每个通道一条不同频率的正弦波加噪声
+	PendingTestSamples += TestSamplesPerSecond * DeltaTime;
+	const int32 NumFrames = FMath::FloorToInt32(PendingTestSamples);
+	if (NumFrames <= 0)
+	{
+		return;
+	}
+	PendingTestSamples -= NumFrames;
+
+	const int32 Channels = SeriesComponent->GetNumChannels();
+	const double Step = 1.0 / TestSamplesPerSecond;
+	TArray<float> Frames;
+	Frames.SetNumUninitialized(NumFrames * Channels);
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const double T = TestTime + Frame * Step;
+		for (int32 Channel = 0; Channel < Channels; Channel++)
+		{
+			Frames[Frame * Channels + Channel] = FMath::Sin(T * (1.0 + Channel * 0.25)) + FMath::FRandRange(-0.1f, 0.1f);
+		}
+	}
+	TestTime += NumFrames * Step;
+
+	SeriesComponent->AppendSamples(Frames);
+}
@@ -0,0 +1,94 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderBase/VisMeshComponentBase.h"
+
+#include "VisMeshHeightfieldComponent.generated.h"
+
+/**
+ *	Heightfield surface on a fixed XY grid (same layout as CreateGridMeshWelded).
+ *	Only the heights (one float per vertex) are uploaded; positions, normals, tangents and UVs are rebuilt on the GPU
+ *	for the rows that changed. The index buffer is shared between heightfields of the same size.
+ *	This component has no collision.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), ClassGroup= Rendering)
+class VISMESH_API UVisMeshHeightfieldComponent : public UVisMeshComponentBase
+{
+	GENERATED_BODY()
+
+public:
+	explicit UVisMeshHeightfieldComponent(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 *	Resize the grid. Heights are reset to zero and the render state is recreated.
+	 *	@param	InNumX			Number of vertices in X direction (must be >= 2)
+	 *	@param	InNumY			Number of vertices in Y direction (must be >= 2)
+	 *	@param	InGridSpacing	Size of each quad in local units
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetHeightfieldSize(int32 InNumX, int32 InNumY, float InGridSpacing = 16.0f);
+
+	/** Replace all heights (NumX * NumY values, row-major with X varying fastest) */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetHeights(const TArray<float>& InHeights);
+
+	/** C++ 专用：零拷贝替换全部高度 */
+	void SetHeights(TArray<float>&& InHeights);
+
+	/** Replace the heights of rows [FirstRow, FirstRow + RowHeights.Num() / NumX). Only these rows are uploaded and rebuilt. */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetHeightRows(int32 FirstRow, const TArray<float>& RowHeights);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	const TArray<float>& GetHeights() const { return Heights; }
+
+	int32 GetNumX() const { return NumX; }
+	int32 GetNumY() const { return NumY; }
+	float GetGridSpacing() const { return GridSpacing; }
+
+	//~ Begin UPrimitiveComponent Interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	//~ End UPrimitiveComponent Interface.
+
+	//~ Begin UMeshComponent Interface.
+	virtual int32 GetNumMaterials() const override;
+	//~ End UMeshComponent Interface.
+
+	//~ Begin USceneComponent Interface.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End USceneComponent Interface.
+
+	//~ Begin UObject Interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject Interface.
+
+private:
+	/** NumX / NumY 可在编辑器中修改或随资源加载，而 Heights 不序列化：尺寸不一致时将 Heights 重置为 NumX * NumY 个 0 */
+	void EnsureHeightsSize();
+
+	/** 将 Heights 中 [FirstRow, FirstRow + RowCount) 行发送到渲染线程 */
+	void SendHeightRows(int32 FirstRow, int32 RowCount);
+
+	/** 按高度范围更新包围盒 (只扩大时 bExpandOnly 为 true) */
+	void UpdateHeightRange(TArrayView<const float> InHeights, bool bExpandOnly);
+
+	UPROPERTY(EditAnywhere, Category = "Heightfield", meta = (ClampMin = "2"))
+	int32 NumX = 2;
+
+	UPROPERTY(EditAnywhere, Category = "Heightfield", meta = (ClampMin = "2"))
+	int32 NumY = 2;
+
+	UPROPERTY(EditAnywhere, Category = "Heightfield")
+	float GridSpacing = 16.0f;
+
+	/** CPU 端高度，用于重建 Proxy */
+	TArray<float> Heights;
+
+	float MinHeight = 0.f;
+	float MaxHeight = 0.f;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include "RenderBase/VisMeshSceneProxyBase.h"
+#include "RenderBase/VisMeshRenderResources.h"
+
+class UVisMeshHeightfieldComponent;
+
+/** Heightfield scene proxy：高度缓冲区 + Compute 重建的顶点流 + 共享网格索引 */
+class FVisMeshHeightfieldSceneProxy final : public FVisMeshSceneProxyBase
+{
+public:
+	FVisMeshHeightfieldSceneProxy(UVisMeshHeightfieldComponent* Component);
+
+	virtual SIZE_T GetTypeHash() const override;
+
+	virtual uint32 GetMemoryFootprint(void) const override;
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+
+	virtual bool CanBeOccluded() const override;
+
+	virtual void CreateRenderThreadResources() override;
+
+	virtual void DestroyRenderThreadResources() override;
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const override;
+
+	virtual void DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily) override;
+
+	/** 上传从 FirstRow 开始的若干行高度，并标记这些行需要重建 */
+	void UpdateHeightRows_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstRow, const TArray<float>& RowHeights);
+
+private:
+	int32 NumX;
+	int32 NumY;
+	float GridSpacing;
+
+	/** 创建渲染资源时上传的初始高度，上传后释放 */
+	TArray<float> InitialHeights;
+
+	FVisMeshTypedVertexBuffer* HeightBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* PositionBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* TangentBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* TexCoordBuffer = nullptr;
+	FLocalVertexFactory* VertexFactory = nullptr;
+
+	/** 同尺寸 Heightfield 共享的网格索引 */
+	TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> GridIndices;
+
+	/** 需要重建的行 [DirtyRowBegin, DirtyRowEnd)，为空时不派发 */
+	int32 DirtyRowBegin = 0;
+	int32 DirtyRowEnd = 0;
+
+	UMaterialInterface* Material;
+
+	FMaterialRelevance MaterialRelevance;
+};
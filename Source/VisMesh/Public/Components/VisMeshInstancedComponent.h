@@ -37,11 +37,82 @@ public:
 	UPROPERTY(EditAnywhere, Category = "GenerationArgs")
 	float YSpace = 100.0f;
 
+	/** 数据驱动模式下每根柱子的宽度 (X/Y 方向) */
+	UPROPERTY(EditAnywhere, Category = "GenerationArgs")
+	float BarWidth = 50.0f;
+
 	UPROPERTY(EditAnywhere, Category = "GenerationArgs")
 	UMaterialInterface* Material;
+
+	/** 设置数据驱动柱状图的网格布局：第 i 根柱子位于 (i % InNumColumns * InXSpace, i / InNumColumns * InYSpace) */
+	void SetBarLayout(int32 InNumColumns, float InXSpace, float InYSpace, float InBarWidth);
+
+	/**
+	 *	Switch to data-driven bars: one instance per value, placed on the grid set by SetBarLayout.
+	 *	Only (Height, ColorValue) per bar is uploaded; instance transforms are expanded and culled on the GPU.
+	 *	ColorValue reaches the material as PerInstanceRandom (the vertex factory forwards the instance Origin.w; not
+	 *	available when the material also uses PerInstanceCustomData). ColorValues may be empty (defaults to Heights).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetBarValues(const TArray<float>& Heights, const TArray<float>& ColorValues);
+
+	/** C++ 专用：直接传入 (Height, ColorValue) */
+	void SetBarValues(TArray<FVector2f>&& InBarValues);
+
+	/**
+	 *	Animate from the currently displayed values to new ones over Duration seconds.
+	 *	Both value sets are uploaded once; the interpolation runs in the instance compute pass, so nothing is regenerated per frame.
+	 *	Falls back to SetBarValues when the bar count changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetBarValuesAnimated(const TArray<float>& Heights, const TArray<float>& ColorValues, float Duration = 0.5f);
+
+	/** C++ 专用：直接传入 (Height, ColorValue) */
+	void SetBarValuesAnimated(TArray<FVector2f>&& InBarValues, float Duration);
+
+	/**
+	 *	Free-layout bars: instance i covers InRects[i] = (MinX, MinY, SizeX, SizeY) in local space, with (Height, ColorValue) = InValues[i].
+	 *	Used for variable-size tiles (e.g. LOD aggregates). Buffers grow to the next power of two, so a changing
+	 *	instance count only recreates the proxy when it exceeds the current capacity.
+	 */
+	void SetBarRects(TArray<FVector4f>&& InRects, TArray<FVector2f>&& InValues);
+
+	/** 当前过渡进度 (已缓动)，没有过渡时为 1 */
+	float GetTransitionAlpha() const;
+
+	/** 更新若干 (First, Count) 区间的柱子，Values 按区间顺序紧密排列；柱子数量不变时不重建 Proxy */
+	void UpdateBarValueRanges(const TArray<FIntPoint>& Ranges, const TArray<FVector2f>& Values);
+
+	const TArray<FVector2f>& GetBarValues() const { return BarValues; }
+	const TArray<FVector2f>& GetPreviousBarValues() const { return PreviousBarValues; }
+	const TArray<FVector4f>& GetBarRects() const { return BarRects; }
+	int32 GetBarCapacity() const { return BarCapacity; }
+	double GetTransitionStartTime() const { return TransitionStartTime; }
+	float GetTransitionDuration() const { return TransitionDuration; }
 	
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 	virtual FBoxSphereBounds CalcBounds(const FTransform& BoundTransform) const override;
 
 	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const override;
+
+private:
+	/** 将 BarValues 中的若干区间发送到渲染线程 */
+	void SendBarValueRanges(const TArray<FIntPoint>& Ranges);
+
+	/** 数据驱动模式下每根柱子的 (Height, ColorValue)，为空时使用默认的波浪动画 */
+	TArray<FVector2f> BarValues;
+
+	/** 自由布局模式下每个实例的矩形，为空时使用网格布局 */
+	TArray<FVector4f> BarRects;
+
+	/** 自由布局模式下 Proxy 缓冲区的容量 */
+	int32 BarCapacity = 0;
+
+	/** 过渡动画的起始数值，与 BarValues 等长 (没有过渡时为空) */
+	TArray<FVector2f> PreviousBarValues;
+
+	/** 过渡开始时间 (World RealTimeSeconds，与 FSceneViewFamily::Time 一致) */
+	double TransitionStartTime = 0.0;
+
+	float TransitionDuration = 0.f;
 };
@@ -20,6 +20,28 @@ public:
 	float XSpace, YSpace;
 	int32 NumColumns, NumInstances;
 
+	/** 数据驱动模式：每根柱子一个 (Height, ColorValue)，由 Compute 展开为实例 */
+	bool bDataDriven = false;
+	float BarWidth = 0.f;
+	FVisMeshTypedVertexBuffer* BarValueBuffer = nullptr;
+
+	/** 过渡动画：起始数值与时间，TransitionDuration <= 0 表示没有过渡 */
+	FVisMeshTypedVertexBuffer* PreviousBarValueBuffer = nullptr;
+	TArray<FVector2f> InitialPreviousBarValues;
+	double TransitionStartTime = 0.0;
+	float TransitionDuration = 0.f;
+
+	/** 创建渲染资源时上传的初始数值，上传后释放 */
+	TArray<FVector2f> InitialBarValues;
+
+	/** 自由布局：每个实例的矩形 (MinX, MinY, SizeX, SizeY)。网格模式下只有 1 个占位元素 */
+	bool bUseBarRects = false;
+	FVisMeshTypedVertexBuffer* BarRectBuffer = nullptr;
+	TArray<FVector4f> InitialBarRects;
+
+	/** 实例相关缓冲区的容量，自由布局下 NumInstances 可以在容量内变化 */
+	int32 InstanceCapacity = 0;
+
 	UMaterialInterface* Material;
 
 public:
@@ -40,4 +62,14 @@ public:
 	FMeshBatch* CreateMeshBatch(class FMeshElementCollector& Collector) const;
 	
 	virtual void DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily) override;
+
+	/** 上传若干 (First, Count) 区间的柱子数值，PackedValues 按区间顺序排列 */
+	void UpdateBarValues_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FIntPoint>& Ranges, const TArray<FVector2f>& PackedValues);
+
+	/** 自由布局：替换全部实例 (数量不超过 InstanceCapacity) */
+	void UpdateBarRects_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FVector4f>& Rects, const TArray<FVector2f>& Values);
+
+	/** 上传过渡的起始/目标数值 (一次)，之后每帧只在 Compute 中插值；InDuration <= 0 时结束过渡 */
+	void StartBarTransition_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FVector2f>& PreviousValues, const TArray<FVector2f>& TargetValues,
+		double InStartTime, float InDuration);
 };
@@ -0,0 +1,171 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderBase/VisMeshComponentBase.h"
+
+#include "VisMeshPolylineComponent.generated.h"
+
+/** 多段线中点的首尾标记，与 ExpandPolylineMiter.usf 中的 POLYLINE_STRIP_* 一致 */
+enum EVisMeshPolylineStripFlags : uint8
+{
+	VisMeshPolyline_StripFirst = 1 << 0,
+	VisMeshPolyline_StripLast = 1 << 1,
+};
+
+/** 密集折线的抽稀方式 (见 UVisMeshPolylineComponent::SetDecimationSource) */
+UENUM(BlueprintType)
+enum class EVisMeshPolylineDecimation : uint8
+{
+	/** Douglas-Peucker，误差不超过一个像素，适用于任意折线 (轨迹) */
+	DouglasPeucker,
+	/** 每个像素列保留首、尾、最小、最大点，适用于 X 递增的时间序列 */
+	MinMaxColumns
+};
+
+/**
+ *	Many CPU polylines (trajectories, line charts) drawn as mitered ribbons.
+ *	All polylines share one point array; StripOffsets gives the first point of each polyline. Each point carries a
+ *	width and a colour. Points are uploaded once (or only the appended / changed range) and a compute pass expands
+ *	every point into two ribbon vertices and writes the index buffer, so joints cost nothing on the CPU.
+ *	With bFaceCamera the ribbons are re-expanded every frame to face the camera, otherwise they lie in the local XY plane.
+ *	This component has no collision.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), ClassGroup= Rendering)
+class VISMESH_API UVisMeshPolylineComponent : public UVisMeshComponentBase
+{
+	GENERATED_BODY()
+
+public:
+	explicit UVisMeshPolylineComponent(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 *	Replace all polylines.
+	 *	@param	Positions		Points of all polylines in local space, polyline after polyline
+	 *	@param	StripOffsets	First point of each polyline (ascending, starting at 0), or empty for a single polyline
+	 *	@param	Widths			Per-point width, or empty to use DefaultWidth for every point
+	 *	@param	Colors			Per-point colour, or empty for white
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetPolylines(const TArray<FVector>& Positions, const TArray<int32>& StripOffsets, const TArray<float>& Widths, const TArray<FLinearColor>& Colors);
+
+	/** C++ 专用：替换全部多段线，Widths / Colors 为空时使用默认值 */
+	void SetPolylines(TArrayView<const FVector3f> Positions, TArrayView<const int32> StripOffsets, TArrayView<const float> Widths, TArrayView<const FColor> Colors);
+
+	/** Append one polyline. Only the new points are uploaded unless the GPU buffers have to grow. */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void AppendPolyline(const TArray<FVector>& Positions, float Width, FLinearColor Color);
+
+	/** C++ 专用：追加一条多段线，Widths / Colors 为空时使用默认值 */
+	void AppendPolyline(TArrayView<const FVector3f> Positions, TArrayView<const float> Widths, TArrayView<const FColor> Colors);
+
+	/** 移动从 FirstPoint 开始的若干个点 (宽度、颜色与拓扑不变)，只上传这一段 */
+	void UpdatePolylinePoints(int32 FirstPoint, TArrayView<const FVector3f> Positions);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void ClearPolylines();
+
+	/**
+	 *	Keep dense polylines on the CPU and draw a decimated copy whose size is bounded by the plot's pixel width.
+	 *	Call UpdateDecimationView whenever the visible X range or the pixel width changes. Decimated levels are cached
+	 *	per zoom level, so zooming back and panning at the same zoom only re-slice cached data.
+	 *	@param	Positions		Points of all polylines in local space; for MinMaxColumns X must ascend within each polyline
+	 *	@param	StripOffsets	First point of each polyline (ascending, starting at 0), or empty for a single polyline
+	 *	@param	StripColors		Per-polyline colour, or empty for white
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetDecimationSource(const TArray<FVector>& Positions, const TArray<int32>& StripOffsets, const TArray<FLinearColor>& StripColors, EVisMeshPolylineDecimation Mode);
+
+	/** C++ 专用：零拷贝设置抽稀源数据 */
+	void SetDecimationSource(TArray<FVector3f>&& Positions, TArray<int32>&& StripOffsets, TArray<FColor>&& StripColors, EVisMeshPolylineDecimation Mode);
+
+	/**
+	 *	Draw the decimated source for a plot showing [VisibleMinX, VisibleMaxX] over PixelWidth pixels.
+	 *	Uploads only when the zoom level or the visible range of the cached level changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void UpdateDecimationView(float VisibleMinX, float VisibleMaxX, int32 PixelWidth);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	int32 GetNumPoints() const { return Points.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	int32 GetNumPolylines() const { return StripOffsets.Num(); }
+
+	const TArray<FVector4f>& GetPoints() const { return Points; }
+	const TArray<FColor>& GetColors() const { return Colors; }
+	const TArray<uint8>& GetStripFlags() const { return StripFlags; }
+	const TArray<int32>& GetStripOffsets() const { return StripOffsets; }
+	int32 GetPointCapacity() const { return PointCapacity; }
+
+	/** Width used when no per-point widths are given */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Polyline", meta = (ClampMin = "0.0"))
+	float DefaultWidth = 2.0f;
+
+	/** Turn the ribbons towards the camera every frame (screen-facing lines); otherwise they lie in the local XY plane */
+	UPROPERTY(EditAnywhere, Category = "Polyline")
+	bool bFaceCamera = true;
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetFaceCamera(bool bInFaceCamera);
+
+	//~ Begin UPrimitiveComponent Interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	//~ End UPrimitiveComponent Interface.
+
+	//~ Begin UMeshComponent Interface.
+	virtual int32 GetNumMaterials() const override;
+	//~ End UMeshComponent Interface.
+
+	//~ Begin USceneComponent Interface.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End USceneComponent Interface.
+
+private:
+	/** 点数超过 Proxy 容量时重建 Proxy，否则将 [FirstPoint, FirstPoint + Count) 发送到渲染线程 */
+	void SendPoints(int32 FirstPoint, int32 Count, bool bTopologyChanged);
+
+	/** 按点位置与宽度更新包围盒 (只扩大时 bExpandOnly 为 true) */
+	void UpdatePolylineBounds(TArrayView<const FVector4f> InPoints, bool bExpandOnly);
+
+	/** CPU 端点数据 (Position, Width)，用于重建 Proxy */
+	TArray<FVector4f> Points;
+	TArray<FColor> Colors;
+	TArray<uint8> StripFlags;
+	TArray<int32> StripOffsets;
+
+	/** Proxy 中 GPU 缓冲区可容纳的点数 (2 的幂)，超出时需要重建 */
+	int32 PointCapacity = 0;
+
+	/** 某一缩放级别的抽稀结果：DecimationSource 中保留点的下标 (每条线递增) 与每条线的起始位置 */
+	struct FDecimationLevel
+	{
+		TArray<int32> Indices;
+		TArray<int32> StripOffsets;
+	};
+
+	/** 像素大小对应的缩放级别 (级别 L 的列宽 / 误差为源数据范围的 1 / 2^L)，不需要抽稀时返回 INDEX_NONE */
+	int32 GetDecimationLevel(float PixelSize) const;
+
+	const FDecimationLevel& FindOrBuildDecimationLevel(int32 Level);
+
+	/** 抽稀源数据 (完整分辨率) */
+	TArray<FVector3f> DecimationSource;
+	TArray<int32> DecimationStripOffsets;
+	TArray<FColor> DecimationStripColors;
+	EVisMeshPolylineDecimation DecimationMode = EVisMeshPolylineDecimation::MinMaxColumns;
+	FBox3f DecimationBounds = FBox3f(ForceInit);
+
+	/** 按缩放级别缓存的抽稀结果，源数据变化时清空 */
+	TMap<int32, FDecimationLevel> DecimationLevels;
+
+	/** 上次提交的级别与每条线的可见范围，未变化时不重新上传 */
+	bool bDecimationSubmitted = false;
+	int32 SubmittedDecimationLevel = INDEX_NONE;
+	TArray<FIntPoint> SubmittedDecimationRanges;
+
+	/** 点位置的包围盒与最大宽度 */
+	FBox PositionBounds = FBox(ForceInit);
+	float MaxWidth = 0.f;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include "RenderBase/VisMeshSceneProxyBase.h"
+#include "RenderBase/VisMeshRenderResources.h"
+
+class UVisMeshPolylineComponent;
+
+/** Polyline scene proxy：点缓冲区 (Position, Width) + Compute 展开的斜接 Ribbon 顶点流与索引 */
+class FVisMeshPolylineSceneProxy final : public FVisMeshSceneProxyBase
+{
+public:
+	FVisMeshPolylineSceneProxy(UVisMeshPolylineComponent* Component);
+
+	virtual SIZE_T GetTypeHash() const override;
+
+	virtual uint32 GetMemoryFootprint(void) const override;
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+
+	virtual bool CanBeOccluded() const override;
+
+	virtual void CreateRenderThreadResources() override;
+
+	virtual void DestroyRenderThreadResources() override;
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const override;
+
+	virtual void DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily) override;
+
+	/**
+	 * 上传从 FirstPoint 开始的若干个点，并将点数设为 NewNumPoints (不超过容量)
+	 * InFlags / InColors 为空表示只移动了点，拓扑与颜色不变
+	 */
+	void UpdatePoints_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstPoint, const TArray<FVector4f>& InPoints,
+		const TArray<uint8>& InFlags, const TArray<FColor>& InColors, int32 NewNumPoints);
+
+private:
+	int32 NumPoints;
+	int32 PointCapacity;
+	bool bFaceCamera;
+
+	/** 创建渲染资源时上传的初始数据，上传后释放 */
+	TArray<FVector4f> InitialPoints;
+	TArray<uint8> InitialFlags;
+	TArray<FColor> InitialColors;
+
+	FVisMeshTypedVertexBuffer* PointBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* FlagBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* PositionBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* TangentBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* ColorBuffer = nullptr;
+	FVisMeshRWIndexBuffer* IndexBuffer = nullptr;
+	FLocalVertexFactory* VertexFactory = nullptr;
+
+	/** 点移动后需要重新展开顶点，首尾标记变化后还需要重写索引 */
+	bool bExpandDirty = true;
+	bool bTopologyDirty = true;
+
+	UMaterialInterface* Material;
+
+	FMaterialRelevance MaterialRelevance;
+};
@@ -12,6 +12,7 @@
 struct FKConvexElem;
 
 class FPrimitiveSceneProxy;
+class UTexture;
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), ClassGroup= Rendering)
 class VISMESH_API UVisMeshProceduralComponent : public UVisMeshComponentBase, public IInterface_CollisionDataProvider
@@ -54,6 +55,13 @@ public:
 
 	/** C++ 专用：零拷贝更新 (Move Semantics) */
 	void UpdateMeshSection(int32 SectionIndex, FVisMeshData&& MeshData);
+
+	/**
+	 * 只更新若干顶点区间，其余顶点和 GPU Buffer 的其余部分保持不变
+	 * @param Ranges     (首顶点, 顶点数)，按首顶点升序且互不重叠
+	 * @param RangeData  各区间的顶点依次拼接；与 UpdateMeshSection 相同，只需填充要更新的属性
+	 */
+	void UpdateMeshSectionRanges(int32 SectionIndex, const TArray<FIntPoint>& Ranges, const FVisMeshData& RangeData);
 	
 	/**
 	 *	Create/replace a section for this vis mesh component.
@@ -133,6 +141,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	void SetMeshSectionVisible(int32 SectionIndex, bool bNewVisibility);
 
+	/**
+	 *	Only draw a contiguous range of a section's index buffer. No buffers are rebuilt and bounds are unchanged.
+	 *	Complex collision follows the draw range, so the change is cooked (or deferred, see SetDeferCollisionUpdates).
+	 *	@param	FirstIndex		First index to draw (a multiple of 3)
+	 *	@param	NumIndices		Number of indices to draw, INDEX_NONE draws up to the end of the section
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetMeshSectionDrawRange(int32 SectionIndex, int32 FirstIndex, int32 NumIndices = -1);
+
+	/**
+	 *	Set the values of a per-vertex scalar channel. Only the active channel is uploaded,
+	 *	and only its UV slot is rewritten (no colour conversion, no full section update).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetScalarChannel(int32 SectionIndex, int32 ChannelIndex, const TArray<float>& Values, FName ChannelName = NAME_None);
+
+	/** Select which scalar channel is colour mapped for a section, INDEX_NONE to disable. Rebuilds the scene proxy. */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetActiveScalarChannel(int32 SectionIndex, int32 ChannelIndex);
+
+	/** Set the 1D colour lookup texture sampled by the material (parameter VisMeshColorMap) */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetColorMap(UTexture* InColorMap);
+
+	/** Set the scalar range mapped onto the colour map (parameters VisMeshScalarMin / VisMeshScalarMax) */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetScalarRange(float InMin, float InMax);
+
 	/** Returns whether a particular section is currently visible */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	bool IsMeshSectionVisible(int32 SectionIndex) const;
@@ -176,6 +212,18 @@ public:
 	UPROPERTY(Instanced)
 	TObjectPtr<class UBodySetup> VisMeshBodySetup;
 
+	/** 1D colour lookup texture used to colour the active scalar channel */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh|ColorMap")
+	TObjectPtr<UTexture> ColorMapTexture;
+
+	/** Scalar value mapped to the first texel of the colour map */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh|ColorMap")
+	float ScalarRangeMin = 0.f;
+
+	/** Scalar value mapped to the last texel of the colour map */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh|ColorMap")
+	float ScalarRangeMax = 1.f;
+
 	/** 
 	 *	Get pointer to internal data for one section of this vis mesh component. 
 	 *	Note that pointer will becomes invalid if sections are added or removed.
@@ -184,6 +232,21 @@ public:
 
 	/** Replace a section with new section geometry */
 	void SetVisMeshSection(int32 SectionIndex, const FVisMeshSection& Section);
+
+	/**
+	 *	Replace several sections at once (an empty FVisMeshSection clears the slot), optionally replacing simple collision too.
+	 *	Bounds, collision and render state are only updated once for the whole batch.
+	 */
+	void SetVisMeshSections(const TArray<int32>& SectionIndices, TArray<FVisMeshSection>&& Sections, const TArray<TArray<FVector>>* ConvexMeshes = nullptr);
+
+	/**
+	 *	Defer collision cooking while the mesh is edited continuously (e.g. while dragging a slice plane).
+	 *	Collision keeps its previous shape meanwhile; passing false cooks once if anything changed.
+	 */
+	void SetDeferCollisionUpdates(bool bDefer);
+
+	/** Incremented whenever section positions or topology change, so derived caches (e.g. UVisMeshPlaneSlicer) can detect stale data */
+	uint32 GetGeometryRevision() const { return GeometryRevision; }
 	
 	//~ Begin UPrimitiveComponent Interface.
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
@@ -197,6 +260,7 @@ public:
 
 	//~ Begin UObject Interface
 	virtual void PostLoad() override;
+	virtual void Serialize(FArchive& Ar) override;
 	//~ End UObject Interface.
 
 	//~ Begin USceneComponent Interface.
@@ -217,6 +281,15 @@ private:
 	/** Helper to create new body setup objects */
 	UBodySetup* CreateBodySetupHelper();
 
+	/** Rebuild CollisionConvexElems from vertex lists, without triggering a collision update */
+	void ReplaceCollisionConvexElems(const TArray<TArray<FVector>>& ConvexMeshes);
+
+	/** Send the vertex attributes and active scalar channel of a section to the scene proxy (no indices, no other channels) */
+	void SendSectionUpdate(int32 SectionIndex);
+
+	/** Push colour map texture and scalar range to the material of every colour mapped section */
+	void ApplyColorMapParameters();
+
 	/** Array of sections of mesh */
 	UPROPERTY()
 	TArray<FVisMeshSection> VisMeshSections;
@@ -233,6 +306,26 @@ private:
 	UPROPERTY(transient)
 	TArray<TObjectPtr<UBodySetup>> AsyncBodySetupQueue;
 
+	/** Prefix sum of collision face counts, one entry per section that contributed to the trimesh */
+	mutable TArray<int32> CollisionFaceEnds;
+	/** Section index matching each entry of CollisionFaceEnds */
+	mutable TArray<int32> CollisionFaceSections;
+	/** Whether the face table matches the current sections (cleared by UpdateCollision) */
+	mutable bool bCollisionFaceTableValid = false;
+	/** bUseAllTriData the face table was built with */
+	mutable bool bCollisionFaceTableAllTriData = false;
+
+	/** Rebuild CollisionFaceEnds / CollisionFaceSections from the current sections */
+	void BuildCollisionFaceTable(bool bUseAllTriData) const;
+
+	/** See SetDeferCollisionUpdates */
+	bool bDeferCollisionUpdates = false;
+	/** UpdateCollision was called while deferred */
+	bool bCollisionUpdatePending = false;
+
+	/** See GetGeometryRevision */
+	uint32 GeometryRevision = 0;
+
 	friend class FVisMeshProceduralSceneProxy;
 	friend class FVisMeshInstancedSceneProxy;
 };
@@ -14,8 +14,17 @@ public:
 
 	void UpdateSection_RenderThread(FRHICommandListBase& RHICmdList, FVisMeshSectionUpdateData* SectionData);
 
+	/** 只写入并上传 RangeData->Ranges 覆盖的顶点 */
+	void UpdateSectionRanges_RenderThread(FRHICommandListBase& RHICmdList, FVisMeshSectionRangeUpdateData* RangeData);
+
+	/** 仅更新激活标量通道对应的 UV 槽位 */
+	void UpdateSectionScalars_RenderThread(FRHICommandListBase& RHICmdList, int32 SectionIndex, const TArray<float>& ScalarValues);
+
 	void SetSectionVisibility_RenderThread(int32 SectionIndex, bool bNewVisibility);
 
+	/** 设置 Section 绘制的索引范围，不修改任何 Buffer */
+	void SetSectionDrawRange_RenderThread(int32 SectionIndex, int32 FirstIndex, int32 NumIndices);
+
 	// 收集每个view下每个LOD的FPrimitiveSceneProxy，并转换成FMeshBatch
 	// 设置FMeshBatch中的FMeshBatchElement中的IndexBuffer, NumPrimitive, UniformBuffer等等关于渲染的东西
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily,uint32 VisibilityMap, class FMeshElementCollector& Collector) const override;
@@ -0,0 +1,110 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderBase/VisMeshComponentBase.h"
+
+#include "VisMeshScatterComponent.generated.h"
+
+/** 散点图的一个点，与 PopulateScatterPointInstanceBuffer.usf 中的 FVisMeshScatterPoint 布局一致 */
+struct FVisMeshScatterPoint
+{
+	FVector3f Position;
+	float Radius;
+	float Scalar;
+};
+static_assert(sizeof(FVisMeshScatterPoint) == 20, "FVisMeshScatterPoint must match the HLSL struct layout");
+
+/**
+ *	Scatter plot of real data points, each drawn as a small sphere.
+ *	The points (Position, Radius, Scalar) are uploaded once into a structured buffer and only re-uploaded when they change.
+ *	Every frame a compute pass expands the visible points into sphere instances (frustum culled, indirect draw),
+ *	so the CPU cost does not depend on the number of points. Scalar reaches the material as PerInstanceRandom
+ *	(the instanced vertex factory forwards the instance Origin.w; not available together with PerInstanceCustomData),
+ *	and the material maps it to a colour, so changing the colour map needs no re-upload.
+ *	With bUseImpostors each point is a single camera-facing quad instead; the material resolves the exact sphere
+ *	(see Shaders/CustomHLSL/SphereImpostor.usf). This component has no collision.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), ClassGroup= Rendering)
+class VISMESH_API UVisMeshScatterComponent : public UVisMeshComponentBase
+{
+	GENERATED_BODY()
+
+public:
+	explicit UVisMeshScatterComponent(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 *	Replace all points.
+	 *	@param	Positions	Point positions in local space
+	 *	@param	Radii		Per-point radius, or empty to use DefaultRadius for every point
+	 *	@param	Scalars		Per-point scalar for color mapping, or empty for zero
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetPoints(const TArray<FVector>& Positions, const TArray<float>& Radii, const TArray<float>& Scalars);
+
+	/** C++ 专用：零拷贝替换全部点。点数不变时只上传数据，不重建 Proxy */
+	void SetPoints(TArray<FVisMeshScatterPoint>&& InPoints);
+
+	/** 替换从 FirstPoint 开始的若干个点，只上传这一段 */
+	void UpdatePoints(int32 FirstPoint, TArrayView<const FVisMeshScatterPoint> InPoints);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void ClearPoints();
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	int32 GetNumPoints() const { return Points.Num(); }
+
+	const TArray<FVisMeshScatterPoint>& GetPoints() const { return Points; }
+
+	/** Radius used by SetPoints when no radii are given */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scatter", meta = (ClampMin = "0.0"))
+	float DefaultRadius = 5.0f;
+
+	/** Multiplier applied to every point radius on the GPU (changing it does not re-upload the points) */
+	UPROPERTY(EditAnywhere, Category = "Scatter", meta = (ClampMin = "0.0"))
+	float RadiusScale = 1.0f;
+
+	/** Icosphere subdivision level of each point: 0 = 20 triangles, 1 = 80, 2 = 320 */
+	UPROPERTY(EditAnywhere, Category = "Scatter", meta = (ClampMin = "0", ClampMax = "2", EditCondition = "!bUseImpostors"))
+	int32 SphereSubdivisions = 0;
+
+	/**
+	 *	Draw each point as a camera-facing quad (4 vertices, 2 triangles) and ray-trace the sphere in the pixel shader.
+	 *	Requires a Masked material with Pixel Depth Offset built on SphereImpostor.usf.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Scatter")
+	bool bUseImpostors = false;
+
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetUseImpostors(bool bInUseImpostors);
+
+	//~ Begin UPrimitiveComponent Interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	//~ End UPrimitiveComponent Interface.
+
+	//~ Begin UMeshComponent Interface.
+	virtual int32 GetNumMaterials() const override;
+	//~ End UMeshComponent Interface.
+
+	//~ Begin USceneComponent Interface.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End USceneComponent Interface.
+
+private:
+	/** 将 Points 中 [FirstPoint, FirstPoint + Count) 发送到渲染线程 */
+	void SendPoints(int32 FirstPoint, int32 Count);
+
+	/** 按点中心与半径更新包围盒 (只扩大时 bExpandOnly 为 true) */
+	void UpdatePointBounds(TArrayView<const FVisMeshScatterPoint> InPoints, bool bExpandOnly);
+
+	/** CPU 端点数据，用于重建 Proxy */
+	TArray<FVisMeshScatterPoint> Points;
+
+	/** Proxy 中点缓冲区的大小，点数变化时需要重建 */
+	int32 ProxyNumPoints = 0;
+
+	/** 点中心的包围盒与最大半径，CalcBounds 中再乘以 RadiusScale */
+	FBox PositionBounds = FBox(ForceInit);
+	float MaxRadius = 0.f;
+};
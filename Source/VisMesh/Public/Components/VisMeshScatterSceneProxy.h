@@ -0,0 +1,59 @@
+#pragma once
+#include "RenderBase/VisMeshSceneProxyBase.h"
+#include "RenderBase/VisMeshRenderResources.h"
+#include "Components/VisMeshScatterComponent.h"
+
+class FVisMeshInstancedVertexFactory;
+
+/** Scatter scene proxy：点数据 Structured Buffer + Compute 展开的球体 / Impostor 四边形实例 (视锥剔除 + Indirect Draw) */
+class FVisMeshScatterSceneProxy final : public FVisMeshSceneProxyBase
+{
+public:
+	FVisMeshScatterSceneProxy(UVisMeshScatterComponent* Component);
+
+	virtual SIZE_T GetTypeHash() const override;
+
+	virtual uint32 GetMemoryFootprint(void) const override;
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+
+	virtual bool CanBeOccluded() const override;
+
+	virtual void CreateRenderThreadResources() override;
+
+	virtual void DestroyRenderThreadResources() override;
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const override;
+
+	virtual void DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily) override;
+
+	/** 上传从 FirstPoint 开始的若干个点 (点数不变) */
+	void UpdatePoints_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstPoint, const TArray<FVisMeshScatterPoint>& InPoints);
+
+private:
+	int32 NumPoints;
+	float RadiusScale;
+	int32 SphereSubdivisions;
+	bool bUseImpostors;
+
+	/** 创建渲染资源时上传的初始点数据，上传后释放 */
+	TArray<FVisMeshScatterPoint> InitialPoints;
+
+	FVisMeshStructuredBuffer* PointBuffer = nullptr;
+
+	/** 实例网格：单位球 (以原点为中心，半径为 1)，Impostor 模式下为 (±1, ±1, -1) 四边形 */
+	FVisMeshTypedVertexBuffer* MeshPositionBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* MeshTangentBuffer = nullptr;
+	FVisMeshIndexBuffer* MeshIndexBuffer = nullptr;
+	int32 NumMeshVertices = 0;
+
+	/** 每帧由 Compute 写入的可见实例，容量为 NumPoints */
+	FVisMeshInstanceBuffer* InstanceBuffer = nullptr;
+	FVisMeshInstancedVertexFactory* VertexFactory = nullptr;
+
+	TRefCountPtr<FRDGPooledBuffer> IndirectArgsBuffer;
+
+	UMaterialInterface* Material;
+
+	FMaterialRelevance MaterialRelevance;
+};
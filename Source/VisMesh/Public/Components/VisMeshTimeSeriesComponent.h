@@ -0,0 +1,105 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderBase/VisMeshComponentBase.h"
+
+#include "VisMeshTimeSeriesComponent.generated.h"
+
+/**
+ *	Streaming multi-channel time series drawn as one ribbon per channel.
+ *	Samples live in a GPU ring buffer (Capacity frames of NumChannels values). Appending N frames uploads only those
+ *	N * NumChannels values and advances the head; the ribbons are rebuilt from the head offset in a compute pass,
+ *	so no vertices are moved or regenerated on the CPU. The newest sample is at X = (Capacity - 1) * SampleSpacing,
+ *	channel c at Y = c * ChannelSpacing. This component has no collision.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), ClassGroup= Rendering)
+class VISMESH_API UVisMeshTimeSeriesComponent : public UVisMeshComponentBase
+{
+	GENERATED_BODY()
+
+public:
+	explicit UVisMeshTimeSeriesComponent(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 *	Resize the ring buffer. All samples are cleared and the render state is recreated.
+	 *	@param	InNumChannels	Number of channels (values per frame)
+	 *	@param	InCapacity		Number of frames kept per channel (must be >= 2)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetStreamLayout(int32 InNumChannels, int32 InCapacity);
+
+	/**
+	 *	Append frames of samples. Frames holds N * NumChannels values, frame-major (all channels of the oldest new frame first).
+	 *	Only the appended values are uploaded; when more than Capacity frames are given only the newest Capacity are kept.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void AppendSamples(const TArray<float>& Frames);
+
+	/** Remove all samples without recreating the render state */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void ClearSamples();
+
+	/** Per-channel colour written to the vertex colours (cycled when there are fewer colours than channels) */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetChannelColors(const TArray<FLinearColor>& InColors);
+
+	int32 GetNumChannels() const { return NumChannels; }
+	int32 GetCapacity() const { return Capacity; }
+	int32 GetHead() const { return Head; }
+	int32 GetCount() const { return Count; }
+	const TArray<float>& GetSamples() const { return Samples; }
+	const TArray<FLinearColor>& GetChannelColors() const { return ChannelColors; }
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries")
+	float SampleSpacing = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries")
+	float ChannelSpacing = 100.0f;
+
+	/** 采样值到 Z 的缩放 */
+	UPROPERTY(EditAnywhere, Category = "TimeSeries")
+	float ValueScale = 10.0f;
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries")
+	float LineWidth = 2.0f;
+
+	//~ Begin UPrimitiveComponent Interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	//~ End UPrimitiveComponent Interface.
+
+	//~ Begin UMeshComponent Interface.
+	virtual int32 GetNumMaterials() const override;
+	//~ End UMeshComponent Interface.
+
+	//~ Begin USceneComponent Interface.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End USceneComponent Interface.
+
+private:
+	/** 将从 FirstSlot 开始的 NumFrames 帧发送到渲染线程 (可能跨过环尾) */
+	void SendFrames(int32 FirstSlot, int32 NumFrames);
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries", meta = (ClampMin = "1"))
+	int32 NumChannels = 1;
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries", meta = (ClampMin = "2"))
+	int32 Capacity = 1024;
+
+	UPROPERTY(EditAnywhere, Category = "TimeSeries")
+	TArray<FLinearColor> ChannelColors;
+
+	/** CPU 端的环形缓冲区 Samples[Slot * NumChannels + Channel]，用于重建 Proxy */
+	TArray<float> Samples;
+
+	/** 下一次写入的槽位 */
+	int32 Head = 0;
+
+	/** 有效帧数 (<= Capacity) */
+	int32 Count = 0;
+
+	/** 出现过的采样值范围，只扩大 (包围盒) */
+	float MinValue = 0.f;
+	float MaxValue = 0.f;
+};
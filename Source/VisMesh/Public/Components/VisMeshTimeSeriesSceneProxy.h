@@ -0,0 +1,62 @@
+#pragma once
+#include "RenderBase/VisMeshSceneProxyBase.h"
+#include "RenderBase/VisMeshRenderResources.h"
+
+class UVisMeshTimeSeriesComponent;
+
+/** Time series scene proxy：采样环形缓冲区 + Compute 重建的 Ribbon 顶点流 */
+class FVisMeshTimeSeriesSceneProxy final : public FVisMeshSceneProxyBase
+{
+public:
+	FVisMeshTimeSeriesSceneProxy(UVisMeshTimeSeriesComponent* Component);
+
+	virtual SIZE_T GetTypeHash() const override;
+
+	virtual uint32 GetMemoryFootprint(void) const override;
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+
+	virtual bool CanBeOccluded() const override;
+
+	virtual void CreateRenderThreadResources() override;
+
+	virtual void DestroyRenderThreadResources() override;
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, class FMeshElementCollector& Collector) const override;
+
+	virtual void DispatchComputePass_RenderThread(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily) override;
+
+	/** 上传从 FirstSlot 开始的若干帧 (已在环尾拆分)，并更新 Head / Count */
+	void AppendFrames_RenderThread(FRHICommandListBase& RHICmdList, int32 FirstSlot, const TArray<float>& Frames, int32 NewHead, int32 NewCount);
+
+	/** 替换全部通道颜色 (每个通道一个) */
+	void UpdateChannelColors_RenderThread(FRHICommandListBase& RHICmdList, const TArray<FColor>& InChannelColors);
+
+private:
+	int32 NumChannels;
+	int32 Capacity;
+	int32 Head;
+	int32 Count;
+	float SampleSpacing;
+	float ChannelSpacing;
+	float ValueScale;
+	float LineWidth;
+
+	/** 创建渲染资源时上传的初始数据，上传后释放 */
+	TArray<float> InitialSamples;
+	TArray<FColor> InitialChannelColors;
+
+	FVisMeshTypedVertexBuffer* SampleBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* PositionBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* TangentBuffer = nullptr;
+	FVisMeshTypedVertexBuffer* ColorBuffer = nullptr;
+	FVisMeshIndexBuffer* IndexBuffer = nullptr;
+	FLocalVertexFactory* VertexFactory = nullptr;
+
+	/** Head 或采样变化后需要重建顶点 */
+	bool bRibbonDirty = true;
+
+	UMaterialInterface* Material;
+
+	FMaterialRelevance MaterialRelevance;
+};
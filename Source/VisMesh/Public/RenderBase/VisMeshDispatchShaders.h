@@ -151,4 +151,134 @@ public:
 	END_SHADER_PARAMETER_STRUCT()
 
 	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
-};
\ No newline at end of file
+};
+
+class FPopulateBarChartInstanceBufferCS : public FGlobalShader
+{
+	SHADER_USE_PARAMETER_STRUCT(FPopulateBarChartInstanceBufferCS, FGlobalShader);
+	DECLARE_EXPORTED_GLOBAL_SHADER(FPopulateBarChartInstanceBufferCS, VISMESH_API);
+
+public:
+	static constexpr uint32 ThreadGroupSize = 256;
+	
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, VISMESH_API)
+		SHADER_PARAMETER_SRV(Buffer<float2>, BarValues)
+		SHADER_PARAMETER_SRV(Buffer<float2>, PreviousBarValues)
+		SHADER_PARAMETER(float, TransitionAlpha)
+		SHADER_PARAMETER_SRV(Buffer<float4>, BarRects)
+		SHADER_PARAMETER(int, UseBarRects)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutInstanceOriginBuffer)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutInstanceTransforms)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, OutIndirectArgs)
+
+		SHADER_PARAMETER(float, XSpace)
+		SHADER_PARAMETER(float, YSpace)
+		SHADER_PARAMETER(float, BarWidth)
+		SHADER_PARAMETER(int, NumColumns)
+		SHADER_PARAMETER(int, NumInstances)
+		SHADER_PARAMETER(FMatrix44f, ViewProjectionMatrix)
+		SHADER_PARAMETER(FMatrix44f, ModelMatrix)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class FVisMeshHeightfieldDisplaceCS : public FGlobalShader
+{
+	SHADER_USE_PARAMETER_STRUCT(FVisMeshHeightfieldDisplaceCS, FGlobalShader);
+	DECLARE_EXPORTED_GLOBAL_SHADER(FVisMeshHeightfieldDisplaceCS, VISMESH_API);
+
+public:
+	static constexpr uint32 ThreadGroupSize = 256;
+	
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, VISMESH_API)
+		SHADER_PARAMETER_SRV(Buffer<float>, Heights)
+		SHADER_PARAMETER_UAV(RWBuffer<float>, OutPositions)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutTangents)
+		SHADER_PARAMETER_UAV(RWBuffer<float2>, OutTexCoords)
+
+		SHADER_PARAMETER(int, NumX)
+		SHADER_PARAMETER(int, NumY)
+		SHADER_PARAMETER(int, FirstRow)
+		SHADER_PARAMETER(int, NumRows)
+		SHADER_PARAMETER(float, GridSpacing)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class FVisMeshTimeSeriesRibbonCS : public FGlobalShader
+{
+	SHADER_USE_PARAMETER_STRUCT(FVisMeshTimeSeriesRibbonCS, FGlobalShader);
+	DECLARE_EXPORTED_GLOBAL_SHADER(FVisMeshTimeSeriesRibbonCS, VISMESH_API);
+
+public:
+	static constexpr uint32 ThreadGroupSize = 256;
+	
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, VISMESH_API)
+		SHADER_PARAMETER_SRV(Buffer<float>, Samples)
+		SHADER_PARAMETER_UAV(RWBuffer<float>, OutPositions)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutTangents)
+
+		SHADER_PARAMETER(int, NumChannels)
+		SHADER_PARAMETER(int, Capacity)
+		SHADER_PARAMETER(int, Head)
+		SHADER_PARAMETER(int, Count)
+		SHADER_PARAMETER(float, SampleSpacing)
+		SHADER_PARAMETER(float, ChannelSpacing)
+		SHADER_PARAMETER(float, ValueScale)
+		SHADER_PARAMETER(float, LineWidth)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class FPopulateScatterPointInstanceBufferCS : public FGlobalShader
+{
+	SHADER_USE_PARAMETER_STRUCT(FPopulateScatterPointInstanceBufferCS, FGlobalShader);
+	DECLARE_EXPORTED_GLOBAL_SHADER(FPopulateScatterPointInstanceBufferCS, VISMESH_API);
+
+public:
+	static constexpr uint32 ThreadGroupSize = 256;
+	
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, VISMESH_API)
+		SHADER_PARAMETER_SRV(StructuredBuffer<FVisMeshScatterPoint>, Points)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutInstanceOriginBuffer)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutInstanceTransforms)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, OutIndirectArgs)
+
+		SHADER_PARAMETER(int, NumPoints)
+		SHADER_PARAMETER(float, RadiusScale)
+		SHADER_PARAMETER(uint32, IndexCountPerInstance)
+		SHADER_PARAMETER(int, UseImpostors)
+		SHADER_PARAMETER(FVector3f, CameraPosition)
+		SHADER_PARAMETER(FMatrix44f, ViewProjectionMatrix)
+		SHADER_PARAMETER(FMatrix44f, ModelMatrix)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
+
+class FVisMeshPolylineExpandCS : public FGlobalShader
+{
+	SHADER_USE_PARAMETER_STRUCT(FVisMeshPolylineExpandCS, FGlobalShader);
+	DECLARE_EXPORTED_GLOBAL_SHADER(FVisMeshPolylineExpandCS, VISMESH_API);
+
+public:
+	static constexpr uint32 ThreadGroupSize = 256;
+	
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, VISMESH_API)
+		SHADER_PARAMETER_SRV(Buffer<float4>, Points)
+		SHADER_PARAMETER_SRV(Buffer<uint>, StripFlags)
+		SHADER_PARAMETER_UAV(RWBuffer<float>, OutPositions)
+		SHADER_PARAMETER_UAV(RWBuffer<float4>, OutTangents)
+		SHADER_PARAMETER_UAV(RWBuffer<uint>, OutIndices)
+
+		SHADER_PARAMETER(int, NumPoints)
+		SHADER_PARAMETER(int, FaceCamera)
+		SHADER_PARAMETER(FVector3f, CameraPosition)
+		SHADER_PARAMETER(int, WriteIndices)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment);
+};
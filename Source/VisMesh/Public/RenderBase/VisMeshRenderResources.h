@@ -1,5 +1,6 @@
 #pragma once
 #include "DynamicMeshBuilder.h"
+#include <atomic>
 #include "VisMeshRenderResources.generated.h"
 
 /** Class representing a single section of the proc mesh */
@@ -12,15 +13,26 @@ public:
 	FStaticMeshVertexBuffers VertexBuffers;
 	/** Index buffer for this section */
 	FDynamicMeshIndexBuffer32 IndexBuffer;
+	/** Shared index buffer used instead of IndexBuffer when valid */
+	TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> SharedIndices;
 	/** Vertex factory for this section */
 	FLocalVertexFactory VertexFactory;
 	/** Whether this section is currently visible */
 	bool bSectionVisible;
+	/** First index of the drawn index range */
+	int32 DrawFirstIndex;
+	/** Number of indices drawn, INDEX_NONE draws up to the end of the index buffer */
+	int32 DrawNumIndices;
+
+	const FIndexBuffer* GetIndexBuffer() const { return SharedIndices.IsValid() ? (const FIndexBuffer*)SharedIndices.Get() : &IndexBuffer; }
+	int32 GetNumIndices() const { return SharedIndices.IsValid() ? SharedIndices->GetIndices().Num() : IndexBuffer.Indices.Num(); }
 
 	FVisMeshProxySection(ERHIFeatureLevel::Type InFeatureLevel)
 		: Material(NULL)
 		  , VertexFactory(InFeatureLevel, "FVisMeshProxySection")
 		  , bSectionVisible(true)
+		  , DrawFirstIndex(0)
+		  , DrawNumIndices(INDEX_NONE)
 	{
 	}
 };
@@ -60,6 +72,52 @@ public:
 	{}
 };
 
+/** 激活的标量通道写入的纹理坐标槽位 (UV0-UV3 已被占用)，材质中通过 TexCoord[4].x 读取 */
+static constexpr int32 GVisMeshScalarUVIndex = 4;
+
+/**
+ * 每顶点的 float 标量通道 (例如温度、压力)
+ * 激活后在 Shader 中通过 1D LUT 与 [Min, Max] 区间映射为颜色，调整色表/区间只需更新材质参数
+ */
+USTRUCT(BlueprintType)
+struct FVisMeshScalarChannel
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<float> Values;
+};
+
+/**
+ * 不可变的共享索引数组 (例如同尺寸的网格)
+ * 引用它的所有 Section 共用这一份索引和一个 GPU IndexBuffer，GPU 资源在首次渲染时创建，最后一个引用释放时在渲染线程销毁
+ */
+class VISMESH_API FVisMeshSharedIndices : public FIndexBuffer
+{
+public:
+	explicit FVisMeshSharedIndices(TArray<int32>&& InIndices)
+		: Indices(MoveTemp(InIndices))
+	{
+	}
+
+	/** 创建共享对象，最后一个引用释放时在渲染线程上释放 GPU 资源 */
+	static TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> Create(TArray<int32>&& InIndices);
+
+	/** 游戏线程：第一个使用者负责请求初始化 GPU 资源 */
+	void BeginInitOnce();
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+
+	const TArray<int32>& GetIndices() const { return Indices; }
+
+private:
+	const TArray<int32> Indices;
+	std::atomic<bool> bInitRequested = false;
+};
+
 /** 
  * 纯数据容器，采用 SOA 布局,用于在 API 间传递网格数据 
  */
@@ -92,10 +150,34 @@ struct FVisMeshData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<int32> Triangles; // 这里用 int32 方便蓝图，内部转 uint32
 
+	/** 可选的标量通道，每个通道长度与 Positions 相同 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FVisMeshScalarChannel> Scalars;
+
+	/**
+	 * 共享索引 (例如网格生成器)：有效时 Triangles 为空，CPU 端读取与渲染都直接使用这一份，不拷贝
+	 * 读取索引应使用 GetTriangles()，修改索引前先调用 MakeTrianglesUnique()
+	 */
+	TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> SharedIndices;
+
 	/** 辅助函数：快速检查数据有效性 */
 	bool IsValid() const { return Positions.Num() > 0; }
 	int32 NumVertices() const { return Positions.Num(); }
 
+	/** 当前的索引：共享索引或 Triangles */
+	const TArray<int32>& GetTriangles() const { return SharedIndices.IsValid() ? SharedIndices->GetIndices() : Triangles; }
+	int32 NumIndices() const { return GetTriangles().Num(); }
+
+	/** 将共享索引拷贝到 Triangles 并解除共享，之后可以直接修改 Triangles */
+	void MakeTrianglesUnique()
+	{
+		if (SharedIndices.IsValid())
+		{
+			Triangles = SharedIndices->GetIndices();
+			SharedIndices.Reset();
+		}
+	}
+
 	/** 辅助函数：清理数据 */
 	void Reset()
 	{
@@ -108,6 +190,8 @@ struct FVisMeshData
 		UV2.Reset();
 		UV3.Reset();
 		Triangles.Reset();
+		Scalars.Reset();
+		SharedIndices.Reset();
 	}
 };
 
@@ -129,6 +213,35 @@ struct FVisMeshSection
 
 	UPROPERTY()
 	bool bSectionVisible = true;
+
+	/** 当前用于颜色映射的标量通道 (Data.Scalars 的下标)，INDEX_NONE 表示不使用 */
+	UPROPERTY()
+	int32 ActiveScalarChannel = INDEX_NONE;
+
+	/** 只绘制 Data.Triangles 中的一段 (首个索引, 索引数量)，INDEX_NONE 表示绘制到末尾 */
+	UPROPERTY()
+	int32 DrawFirstIndex = 0;
+
+	UPROPERTY()
+	int32 DrawNumIndices = INDEX_NONE;
+
+	/** 裁剪到索引缓冲区内的绘制范围，碰撞也只使用这一段 */
+	int32 GetDrawFirstIndex() const { return FMath::Clamp(DrawFirstIndex, 0, Data.NumIndices()); }
+	int32 GetDrawNumIndices() const
+	{
+		const int32 MaxIndices = Data.NumIndices() - GetDrawFirstIndex();
+		return DrawNumIndices == INDEX_NONE ? MaxIndices : FMath::Clamp(DrawNumIndices, 0, MaxIndices);
+	}
+
+	/** 返回激活的标量通道数据，无效时返回 nullptr */
+	const TArray<float>* GetActiveScalarValues() const
+	{
+		if (Data.Scalars.IsValidIndex(ActiveScalarChannel) && Data.Scalars[ActiveScalarChannel].Values.Num() == Data.NumVertices())
+		{
+			return &Data.Scalars[ActiveScalarChannel].Values;
+		}
+		return nullptr;
+	}
     
 	FVisMeshSection() : SectionLocalBox(ForceInit) {}
 
@@ -138,6 +251,9 @@ struct FVisMeshSection
 		SectionLocalBox.Init();
 		bEnableCollision = false;
 		bSectionVisible = true;
+		ActiveScalarChannel = INDEX_NONE;
+		DrawFirstIndex = 0;
+		DrawNumIndices = INDEX_NONE;
 	}
 };
 
@@ -148,6 +264,19 @@ public:
 	int32 TargetSection;
 	/** New vertex information */
 	FVisMeshData Data;
+	/** Values of the active scalar channel, empty if the section has none */
+	TArray<float> ScalarValues;
+};
+
+class FVisMeshSectionRangeUpdateData
+{
+public:
+	/** Section to update */
+	int32 TargetSection;
+	/** Updated vertex ranges (first vertex, vertex count), sorted and non-overlapping */
+	TArray<FIntPoint> Ranges;
+	/** Vertices of all ranges concatenated, only the attributes that changed are filled */
+	FVisMeshData Data;
 };
 
 class FPositionUAVVertexBuffer : public FVertexBuffer
@@ -172,6 +301,91 @@ private:
 	FUnorderedAccessViewRHIRef UAV;
 };
 
+/**
+ * Typed Buffer，可作为顶点流绑定并通过 SRV 读取
+ * bUnorderedAccess 为 true 时由 Compute Shader 写入 (例如 Heightfield 的位置/切线/UV)，否则由 CPU 通过 Lock 更新
+ */
+class FVisMeshTypedVertexBuffer : public FVertexBuffer
+{
+public:
+	FVisMeshTypedVertexBuffer(int32 InNumElements, EPixelFormat InFormat, bool bInUnorderedAccess)
+		: NumElements(InNumElements)
+		, Format(InFormat)
+		, bUnorderedAccess(bInUnorderedAccess)
+	{
+	}
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+
+	virtual void ReleaseRHI() override;
+
+	/** 渲染线程：写入 [FirstElement, FirstElement + Num) */
+	void Update(FRHICommandListBase& RHICmdList, int32 FirstElement, const void* Data, int32 Num);
+
+	uint32 GetElementSize() const { return GPixelFormats[Format].BlockBytes; }
+	FRHIShaderResourceView* GetSRV() const { return SRV; }
+	FRHIUnorderedAccessView* GetUAV() const { return UAV; }
+
+private:
+	int32 NumElements;
+	EPixelFormat Format;
+	bool bUnorderedAccess;
+	FShaderResourceViewRHIRef SRV;
+	FUnorderedAccessViewRHIRef UAV;
+};
+
+/**
+ * Structured Buffer，元素为任意 POD 结构 (Stride 字节)，只供 Compute Shader 通过 SRV 读取
+ * 由 CPU 通过 Lock 更新 (例如散点图的点数据)
+ */
+class FVisMeshStructuredBuffer : public FRenderResource
+{
+public:
+	FVisMeshStructuredBuffer(int32 InNumElements, uint32 InStride)
+		: NumElements(InNumElements)
+		, Stride(InStride)
+	{
+	}
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+
+	virtual void ReleaseRHI() override;
+
+	/** 渲染线程：写入 [FirstElement, FirstElement + Num) */
+	void Update(FRHICommandListBase& RHICmdList, int32 FirstElement, const void* Data, int32 Num);
+
+	FRHIShaderResourceView* GetSRV() const { return SRV; }
+
+private:
+	int32 NumElements;
+	uint32 Stride;
+	FBufferRHIRef BufferRHI;
+	FShaderResourceViewRHIRef SRV;
+};
+
+/**
+ * 32 位索引缓冲区，由 Compute Shader 通过 UAV (R32_UINT) 写入，例如多段线在 GPU 上生成的 Ribbon 索引
+ */
+class FVisMeshRWIndexBuffer : public FIndexBuffer
+{
+public:
+	explicit FVisMeshRWIndexBuffer(int32 InNumIndices)
+		: NumIndices(InNumIndices)
+	{
+	}
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+
+	virtual void ReleaseRHI() override;
+
+	int32 GetNumIndices() const { return NumIndices; }
+	FRHIUnorderedAccessView* GetUAV() const { return UAV; }
+
+private:
+	int32 NumIndices;
+	FUnorderedAccessViewRHIRef UAV;
+};
+
 // 对应 LocalVertexFactory.ush 中的 Attributes 8-12
 struct FInstancedVisMeshDataType
 {
@@ -9,9 +9,14 @@
 class UMaterialInterface;
 class UVisMeshProceduralComponent;
 struct FVisMeshTangent;
+struct FVisMeshData;
 
 class UStaticMesh;
 class UStaticMeshComponent;
+class UTexture2D;
+
+/** Called on the game thread when an asynchronous copy has been applied */
+DECLARE_DYNAMIC_DELEGATE(FOnVisMeshCopyFinished);
 
 /** Options for creating cap geometry when slicing */
 UENUM()
@@ -25,6 +30,21 @@ enum class EVisMeshSliceCapOption : uint8
 	UseLastSectionForCap
 };
 
+/** A polyline of a plane / mesh cross section */
+USTRUCT(BlueprintType)
+struct FVisMeshPolyline
+{
+	GENERATED_BODY()
+
+	/** Points of the polyline. For a closed polyline the first point is not repeated at the end. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Polyline)
+	TArray<FVector> Points;
+
+	/** Whether the last point connects back to the first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Polyline)
+	bool bClosed = false;
+};
+
 /**
  * 
  */
@@ -44,6 +64,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh", meta=(AutoCreateRefTerm = "SmoothingGroups,UVs" ))
 	static void CalculateTangentsForMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles, const TArray<FVector2D>& UVs, TArray<FVector>& Normals, TArray<FVisMeshTangent>& Tangents);
 
+	/**
+	 *	Generate normals and tangents in place for SOA mesh data, in parallel.
+	 *	Tangents follow the MikkTSpace accumulation (angle weighted, projected onto the vertex normal, bitangent sign from UV0).
+	 *	Coincident vertices share normals when the adjacent face lies within SmoothingAngle (degrees) of the vertex's own faces.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void CalculateTangentsForMeshData(UPARAM(ref) FVisMeshData& MeshData, float SmoothingAngle = 180.f);
+
 	/** Add a quad, specified by four indices, to a triangle index buffer as two triangles. */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void ConvertQuadToTriangles(UPARAM(ref) TArray<int32>& Triangles, int32 Vert0, int32 Vert1, int32 Vert2, int32 Vert3);
@@ -83,14 +111,55 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void CreateGridMeshSplit(int32 NumX, int32 NumY, TArray<int32>& Triangles, TArray<FVector>& Vertices, TArray<FVector2D>& UVs, TArray<FVector2D>& UV1s, float GridSpacing = 16.0f);
 
+	/**
+	*	Same layout as CreateGridMeshWelded, written in parallel into preallocated SOA data (flat normals and tangents included).
+	*	Grids of the same size share one cached index array (OutData.SharedIndices, Triangles stays empty; read it with
+	*	GetTriangles), and one GPU index buffer once added to a VisMeshComponent.
+	*	@param	NumX			Number of vertices in X direction (must be >= 2)
+	*	@param	NumY			Number of vertices in y direction (must be >= 2)
+	*	@out	OutData			Output mesh data
+	*	@param	GridSpacing		Size of each quad in world units
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void CreateGridMeshWeldedData(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing = 16.0f);
+
+	/**
+	*	Same layout as CreateGridMeshSplit (UV0 and UV1), written in parallel into preallocated SOA data with a shared cached index array
+	*	(OutData.SharedIndices, Triangles stays empty).
+	*	@param	NumX			Number of vertices in X direction (must be >= 2)
+	*	@param	NumY			Number of vertices in y direction (must be >= 2)
+	*	@out	OutData			Output mesh data
+	*	@param	GridSpacing		Size of each quad in world units
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void CreateGridMeshSplitData(int32 NumX, int32 NumY, FVisMeshData& OutData, float GridSpacing = 16.0f);
+
 	/** Grab geometry data from a StaticMesh asset. */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void GetSectionFromStaticMesh(UStaticMesh* InMesh, int32 LODIndex, int32 SectionIndex, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents);
 
+	/**
+	 *	Grab geometry data (positions, normals, tangents, all UV channels and vertex colors) from a StaticMesh asset section.
+	 *	Sections that reference every vertex of their vertex range are copied as a block, others are compacted in parallel.
+	 *	@return	false if the mesh, LOD or section is invalid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static bool GetSectionDataFromStaticMesh(UStaticMesh* InMesh, int32 LODIndex, int32 SectionIndex, FVisMeshData& OutData);
+
 	/** Copy materials from StaticMeshComponent to VisMeshComponent. */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void CopyVisMeshFromStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent, int32 LODIndex, UVisMeshProceduralComponent* ProcMeshComponent, bool bCreateCollision);
 
+	/**
+	 *	Asynchronous variant of CopyVisMeshFromStaticMeshComponent that copies every LOD.
+	 *	All sections of all LODs are extracted on worker threads, then moved into the components on the game thread
+	 *	(one render state / collision update per component).
+	 *	@param	LODComponents	LODComponents[i] receives LOD i of the static mesh, null entries are skipped
+	 *	@param	OnFinished		Called on the game thread once all components are updated
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void CopyVisMeshFromStaticMeshComponentAsync(UStaticMeshComponent* StaticMeshComponent, const TArray<UVisMeshProceduralComponent*>& LODComponents, bool bCreateCollision, FOnVisMeshCopyFinished OnFinished);
+
 	/** Grab geometry data from a VisMeshComponent. */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void GetSectionFromVisMesh(UVisMeshProceduralComponent* InProcMesh, int32 SectionIndex, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents);
@@ -109,6 +178,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void SliceVisMesh(UVisMeshProceduralComponent* InProcMesh, FVector PlanePosition, FVector PlaneNormal, bool bCreateOtherHalf, UVisMeshProceduralComponent*& OutOtherHalfProcMesh, EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial);
 
+	/**
+	 *	Clip the VisMeshComponent (including simple convex collision) against a set of planes in a single pass, keeping
+	 *	only the geometry on the positive side of every plane. Each section is traversed once and collision is rebuilt once,
+	 *	so this is much cheaper than calling SliceVisMesh once per plane.
+	 *	@param	InProcMesh				VisMeshComponent to clip
+	 *	@param	PlanePositions			Point on each plane, in world space
+	 *	@param	PlaneNormals			Normal of each plane, in world space. Must have the same length as PlanePositions.
+	 *	Where the kept region touches several planes (e.g. a box corner inside the mesh), each plane's cap is the mesh
+	 *	cross-section on that plane clipped by the other planes, so caps meet along the plane-plane edges.
+	 *	@param	CapOption				If and how to create 'cap' geometry on the clipping planes (all caps go into one section)
+	 *	@param	CapMaterial				If creating a new section for the cap, assign this material to that section
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void ClipVisMeshByPlanes(UVisMeshProceduralComponent* InProcMesh, const TArray<FVector>& PlanePositions, const TArray<FVector>& PlaneNormals, EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial);
+
+	/**
+	 *	Clip the VisMeshComponent to the inside of an oriented box (section box). Equivalent to ClipVisMeshByPlanes with the six inward-facing box faces.
+	 *	@param	BoxTransform			World transform of the box (scale is ignored, use BoxExtent)
+	 *	@param	BoxExtent				Half size of the box along each local axis
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void ClipVisMeshByBox(UVisMeshProceduralComponent* InProcMesh, FTransform BoxTransform, FVector BoxExtent, EVisMeshSliceCapOption CapOption, UMaterialInterface* CapMaterial);
+
+	/**
+	 *	Compute the cross section of the VisMeshComponent with a plane without modifying the component.
+	 *	Only triangles crossing the plane are visited, and neither half of the mesh is rebuilt.
+	 *	@param	InProcMesh				VisMeshComponent to intersect
+	 *	@param	PlanePosition			Point on the plane, in world space
+	 *	@param	PlaneNormal				Normal of the plane, in world space
+	 *	@param	OutPolylines			Intersection polylines in world space, closed where the mesh is closed
+	 *	@param	bCreateCap				If true, also triangulate the area enclosed by the closed polylines
+	 *	@param	OutCapVertices			Cap vertex positions in world space (empty if bCreateCap is false)
+	 *	@param	OutCapTriangles			Cap index buffer, facing along -PlaneNormal like the caps of SliceVisMesh
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static void GetVisMeshCrossSection(UVisMeshProceduralComponent* InProcMesh, FVector PlanePosition, FVector PlaneNormal, TArray<FVisMeshPolyline>& OutPolylines, bool bCreateCap, TArray<FVector>& OutCapVertices, TArray<int32>& OutCapTriangles);
+
 	/** * Generate a wireframe-style box composed of 12 beam-like boxes.
 	 * Useful for selection highlights or debug visuals.
 	 * @param BoxRadius      The half-extents of the full bounding box (Center to Edge).
@@ -116,4 +222,11 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
 	static void GenerateWireframeBoxMesh(FVector BoxRadius, float LineThickness, TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FVisMeshTangent>& Tangents);
+
+	/**
+	 *	Build a Width x 1 colour lookup texture by linearly interpolating evenly spaced colour stops.
+	 *	Use with UVisMeshProceduralComponent::SetColorMap to colour a scalar channel in the material.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static UTexture2D* CreateColorMapTexture(const TArray<FLinearColor>& ColorStops, int32 Width = 256);
 };
@@ -0,0 +1,127 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Utils/KismetVisMeshLibrary.h"
+
+#include "VisMeshPlaneSlicer.generated.h"
+
+class UMaterialInterface;
+class UVisMeshProceduralComponent;
+
+/**
+ *	Interactive slicer for a plane with a fixed normal and a moving offset.
+ *
+ *	On creation the triangles of every section are reordered by their minimum projection onto the normal,
+ *	and a max-projection interval tree is built over that order. Moving the plane then costs a binary search
+ *	plus a visit of the triangles that straddle the plane:
+ *	- triangles fully on the kept side are a prefix of the index buffer and are drawn as an index range,
+ *	- only straddling triangles are clipped, into a small companion component that also holds the cap.
+ *	The companion's sections are non-indexed with a power-of-two capacity, so a drag only re-uploads their vertices;
+ *	the scene proxy is rebuilt only when a section outgrows its capacity.
+ *	Collision is not cooked while dragging: call FinishPlaneDrag when the drag ends to cook the sliced collision once.
+ *	If the source mesh geometry changes, the index is rebuilt on the next plane move.
+ */
+UCLASS(BlueprintType)
+class VISMESH_API UVisMeshPlaneSlicer : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 *	Build a slicer for a component. Reorders the triangles of each section once (rendering is unchanged).
+	 *	@param	InProcMesh		Component to slice
+	 *	@param	PlaneNormal		Normal of the slicing plane, in world space. Geometry on the positive side of the plane is kept.
+	 *	@param	InCapOption		Whether to create cap geometry. Caps always go into the companion component.
+	 *	@param	InCapMaterial	Material used for the cap when InCapOption is CreateNewSectionForCap
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	static UVisMeshPlaneSlicer* CreatePlaneSlicer(UVisMeshProceduralComponent* InProcMesh, FVector PlaneNormal, EVisMeshSliceCapOption InCapOption, UMaterialInterface* InCapMaterial);
+
+	/** Move the plane so that it passes through a world space point */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetPlanePosition(FVector PlanePosition);
+
+	/**
+	 *	Move the plane to a local space offset along the normal (distance of the plane from the component origin).
+	 *	Collision cooking of the source component stays deferred until FinishPlaneDrag or ResetSlice is called.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void SetPlaneOffset(float InOffset);
+
+	/** Cook collision for the current slice (source and companion component). Call once when the drag ends. */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void FinishPlaneDrag();
+
+	/** Draw the whole mesh again and remove the companion component */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	void ResetSlice();
+
+	/** Number of triangles drawn directly from the source index buffers for the current offset */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	int32 GetNumKeptTriangles() const;
+
+	/** Companion component holding the clipped straddling triangles and the cap */
+	UFUNCTION(BlueprintCallable, Category = "Components|VisMesh")
+	UVisMeshProceduralComponent* GetFringeComponent() const { return FringeMesh; }
+
+private:
+	/** Per-section projection index */
+	struct FSectionIndex
+	{
+		/** Section in the source component */
+		int32 SectionIndex = INDEX_NONE;
+		/** Minimum projection of each triangle, in (descending) index buffer order */
+		TArray<float> MinProj;
+		/** Implicit max segment tree over the maximum projection of each triangle, leaves start at TreeSize */
+		TArray<float> MaxTree;
+		int32 TreeSize = 0;
+		/** Triangles drawn from the index buffer for the current offset */
+		int32 NumKeptTris = 0;
+	};
+
+	/** Sort triangles and build the projection index for every section */
+	void BuildIndex();
+
+	/** Create the companion component (attached to the source component) if needed */
+	void EnsureFringeMesh();
+
+	/** Destroy the companion component */
+	void DestroyFringeMesh();
+
+	/**
+	 *	Write the fringe sections into the companion component: in place if every section fits its capacity,
+	 *	otherwise rebuild them with larger capacities.
+	 */
+	void UpdateFringeSections(TArray<FVisMeshSection>&& Sections);
+
+	/** Collect the triangles in [First, End) whose maximum projection is above InOffset */
+	static void CollectStraddling(const FSectionIndex& Index, int32 Node, int32 NodeFirst, int32 NodeEnd, int32 First, int32 End, float InOffset, TArray<int32>& OutTris);
+
+	UPROPERTY()
+	TObjectPtr<UVisMeshProceduralComponent> ProcMesh;
+
+	UPROPERTY()
+	TObjectPtr<UVisMeshProceduralComponent> FringeMesh;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInterface> CapMaterial;
+
+	EVisMeshSliceCapOption CapOption = EVisMeshSliceCapOption::NoCap;
+
+	/** Plane normal in component space */
+	FVector LocalNormal = FVector::UpVector;
+
+	/** Current plane offset in component space */
+	float Offset = 0.f;
+
+	TArray<FSectionIndex> SectionIndices;
+
+	/** Geometry revision of ProcMesh that SectionIndices was built from */
+	uint32 IndexedRevision = 0;
+
+	/** Vertex (= index) capacity of each companion section */
+	TArray<int32> FringeCapacities;
+};
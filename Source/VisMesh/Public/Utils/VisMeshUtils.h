@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GeomTools.h"
 #include "RenderBase/VisMeshRenderResources.h"
 
 static constexpr int32 GNumVertsPerBox = 36;
@@ -11,6 +12,100 @@ static constexpr int32 GNumVertsPerBox = 36;
 // 辅助函数：生成单位立方体 (0,0,0 到 1,1,1) 的36个顶点
 static void GetUnitCubeVertices(TArray<FVector3f>& OutVertices);
 
+// 批量 FLinearColor -> FColor 转换，结果与逐个调用 FLinearColor::ToFColor(bSRGB) 完全一致
+// 内部使用 SIMD 计算查找表索引 + sRGB 曲线查找表，并按缓存大小分块并行处理
+// OutColors 的长度必须与 InColors 相同
+VISMESH_API void VisMeshConvertLinearColors(TArrayView<const FLinearColor> InColors, TArrayView<FColor> OutColors, bool bSRGB);
+
+// 并行 SIMD 包围盒归约，结果等价于 FBox(Positions)
+// 只需要计算部分更新范围时，传入 Positions 的切片即可 (例如 MakeArrayView(Positions).Slice(Start, Count))
+VISMESH_API FBox VisMeshComputeBounds(TArrayView<const FVector> Positions);
+
+// 补齐长度与顶点数不一致的属性 (法线 +Z、白色、默认切线、零 UV)，使 SOA 各数组等长
+// CreateMeshSection 与异步拷贝 StaticMesh 共用，保证两条路径得到相同的 Section
+VISMESH_API void VisMeshPadAttributes(FVisMeshData& Data);
+
+// Impostor 球的 CPU 参考实现，与 PopulateScatterPointInstanceBuffer.usf 中的 ComputeSphereImpostorRows 逐项一致，用于校验 GPU 展开结果
+// OutRows 为实例变换的三行 (四边形顶点 (±1, ±1, -1) 乘以这三行再加上 Center)，OutCorners 按 (-1,-1) (1,-1) (-1,1) (1,1) 排列
+// 相机在球内时返回 false (该点不绘制)
+VISMESH_API bool VisMeshExpandSphereImpostor(const FVector3f& Center, float Radius, const FVector3f& CameraPosition, FVector3f OutRows[3], FVector3f OutCorners[4]);
+
+// 并行 exclusive 前缀和：Values[i] 被替换为 Values[0..i) 之和，返回总和
+// 常用于"分类计数 -> 前缀和 -> 并行写入"的压缩流程
+VISMESH_API int32 VisMeshExclusiveScan(TArrayView<int32> Values);
+
+///
+//// Grid
+///
+
+/** 网格生成器的索引排布 (与 UKismetVisMeshLibrary 中的 CreateGridMesh* 一一对应) */
+enum class EVisMeshGridIndexLayout : uint8
+{
+	/** CreateGridMeshTriangles, bWinding = true */
+	Triangles,
+	/** CreateGridMeshTriangles, bWinding = false */
+	TrianglesReversed,
+	/** CreateGridMeshWelded */
+	Welded,
+	/** CreateGridMeshSplit (每个 Quad 4 个独立顶点) */
+	Split
+};
+
+// 返回 (NumX, NumY, Layout) 对应的不可变索引，首次请求时并行生成
+// 缓存只持有弱引用：同尺寸的网格在仍被使用期间共享同一份 CPU 数组和 GPU IndexBuffer，线程安全
+VISMESH_API TSharedPtr<FVisMeshSharedIndices, ESPMode::ThreadSafe> VisMeshGetGridIndices(int32 NumX, int32 NumY, EVisMeshGridIndexLayout Layout);
+
+// 将 (NumX, NumY, Layout) 对应的索引拷贝到 OutIndices (用于需要独立 TArray 的蓝图接口)，不会为此创建共享对象
+VISMESH_API void VisMeshCopyGridIndices(int32 NumX, int32 NumY, EVisMeshGridIndexLayout Layout, TArray<int32>& OutIndices);
+
+///
+//// Decimation (实现位于 VisMeshPolylineDecimation.cpp)
+///
+
+// Douglas-Peucker 折线简化：输出保留点的下标 (递增，首尾总是保留)，删除的点到简化折线的距离不超过 Tolerance
+// 长折线按固定长度分块并行简化 (块边界点总是保留)，结果比串行版本多出至多块数个点
+VISMESH_API void VisMeshDecimateDouglasPeucker(TArrayView<const FVector3f> Points, float Tolerance, TArray<int32>& OutIndices);
+
+// 时间序列的按列最值抽稀：Points 按 X 递增，从 MinX 开始每 ColumnWidth 为一列，每列保留首点、Y 最小点、Y 最大点与尾点
+// 列宽不超过一个像素时，绘制结果与原始折线在像素上一致，且点数不超过 4 * 折线覆盖的列数；输出下标递增
+VISMESH_API void VisMeshDecimateMinMaxColumns(TArrayView<const FVector3f> Points, float MinX, float ColumnWidth, TArray<int32>& OutIndices);
+
+///
+//// Slicing (实现位于 KismetVisMeshLibrary.cpp)
+///
+
+/** 单个 Section 被平面切割后的结果 */
+struct FVisMeshSectionSliceResult
+{
+	/** 平面正侧保留的几何 */
+	FVisMeshSection Kept;
+	/** 平面负侧的几何 (仅在 bCreateOtherHalf 时生成) */
+	FVisMeshSection Other;
+	/** 切割在平面上产生的新边，用于生成 Cap */
+	TArray<FUtilEdge3D> ClipEdges;
+};
+
+// 按源数据的属性布局为目标 SOA 分配空间，之后可用 VisMeshWriteVertex 并行写入
+VISMESH_API void VisMeshAllocateLike(FVisMeshData& Dest, const FVisMeshData& Src, int32 NumVerts, int32 NumIndices);
+
+// 将源顶点写入预分配好的目标 SOA
+VISMESH_API void VisMeshWriteVertex(FVisMeshData& Dest, int32 DestIdx, const FVisMeshData& Src, int32 SrcIdx);
+
+// 用平面切割一个 Section (平面正侧保留)，内部各阶段并行
+VISMESH_API void VisMeshSliceSection(const FVisMeshSection& BaseSection, const FPlane& SlicePlane, bool bCreateOtherHalf, FVisMeshSectionSliceResult& OutResult);
+
+// 由切割平面上的边生成 Cap 几何并追加到 CapSection
+VISMESH_API void VisMeshAppendCap(FVisMeshSection& CapSection, const TArray<FUtilEdge3D>& ClipEdges, const FPlane& SlicePlane);
+
+///
+//// StaticMesh (实现位于 KismetVisMeshLibrary.cpp)
+///
+
+struct FStaticMeshLODResources;
+
+// 将 StaticMesh 一个 LOD 中的 Section 提取到 SOA；不访问 UObject，可在工作线程上调用
+VISMESH_API bool VisMeshExtractStaticMeshSection(const FStaticMeshLODResources& LOD, int32 SectionIndex, FVisMeshData& OutData);
+
 ///
 //// Passes
 ///
@@ -40,4 +135,32 @@ static void AddBoxWireframePass_Miter(FRDGBuilder& GraphBuilder, FRHIUnorderedAc
 								int32 InNumColumns, int32 InNumInstances, float InLineWidth, float InTime, FVector4f InCameraPosition,FVector2f ViewportSize,float TanHalfFOV);
 
 static void AddGenerateScatterPlotSpherePass(FRDGBuilder& GraphBuilder, FRHIUnorderedAccessView* PositionsUAV,
-								FRHIUnorderedAccessView* IndirectArgsBufferUAV, FVector3f BoundsMin, FVector3f BoundsMax, float Radius, int32 NumPoints, float Time, float PulseAmplitude, float PulseSpeed);
\ No newline at end of file
+								FRHIUnorderedAccessView* IndirectArgsBufferUAV, FVector3f BoundsMin, FVector3f BoundsMax, float Radius, int32 NumPoints, float Time, float PulseAmplitude, float PulseSpeed);
+
+// 由每根柱子的 (Height, ColorValue) 生成视锥剔除后的柱状图实例；TransitionAlpha < 1 时从 PreviousBarValues 插值
+// BarRectsSRV 非空时按每个实例的矩形放置，否则按 NumColumns 网格放置
+VISMESH_API void AddBarChartInstancePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* BarValuesSRV, FRHIShaderResourceView* PreviousBarValuesSRV,
+								float TransitionAlpha, FRHIShaderResourceView* BarRectsSRV, bool bUseBarRects, FRHIUnorderedAccessView* InstanceOriginBuffersUAV,
+								FRHIUnorderedAccessView* InstanceTransformsUAV, FRDGBufferUAVRef IndirectArgsBufferUAV, float InXSpace, float InYSpace,
+								float InBarWidth, int32 InNumColumns, int32 InNumInstances, FMatrix44f InProjectionViewMatrix, FMatrix44f InWorldMatrix);
+
+// 由高度缓冲区重建 Heightfield 中 [FirstRow, FirstRow + NumRows) 行的位置、切线 (中心差分法线) 与 UV
+VISMESH_API void AddHeightfieldDisplacePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* HeightsSRV, FRHIUnorderedAccessView* PositionsUAV,
+								FRHIUnorderedAccessView* TangentsUAV, FRHIUnorderedAccessView* TexCoordsUAV, int32 NumX, int32 NumY, float GridSpacing, int32 FirstRow, int32 NumRows);
+
+// 由环形缓冲区中的采样重建时间序列 Ribbon 的位置与切线 (每个采样两个顶点)，滚动由 Head 决定
+VISMESH_API void AddTimeSeriesRibbonPass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* SamplesSRV, FRHIUnorderedAccessView* PositionsUAV,
+								FRHIUnorderedAccessView* TangentsUAV, int32 NumChannels, int32 Capacity, int32 Head, int32 Count,
+								float SampleSpacing, float ChannelSpacing, float ValueScale, float LineWidth);
+
+// 由散点缓冲区 (每点 Position, Radius, Scalar) 生成视锥剔除后的球体实例；IndexCountPerInstance 为实例网格的索引数量
+// bUseImpostors 为 true 时每个点展开为朝向 CameraPosition (组件局部空间) 的四边形，变换与 VisMeshExpandSphereImpostor 一致
+VISMESH_API void AddScatterPointInstancePass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* PointsSRV, FRHIUnorderedAccessView* InstanceOriginBuffersUAV,
+								FRHIUnorderedAccessView* InstanceTransformsUAV, FRDGBufferUAVRef IndirectArgsBufferUAV, int32 NumPoints, float RadiusScale,
+								uint32 IndexCountPerInstance, bool bUseImpostors, FVector3f CameraPosition, FMatrix44f InProjectionViewMatrix, FMatrix44f InWorldMatrix);
+
+// 将多段线 (每点 Position + Width，StripFlags 标记每条线的首尾) 展开为斜接 Ribbon 的位置与切线 (每点两个顶点)
+// bFaceCamera 为 true 时 Ribbon 朝向 CameraPosition (组件局部空间)，否则位于 XY 平面；bWriteIndices 为 true 时同时重写索引 (每点 6 个)
+VISMESH_API void AddPolylineExpandPass(FRDGBuilder& GraphBuilder, FRHIShaderResourceView* PointsSRV, FRHIShaderResourceView* StripFlagsSRV,
+								FRHIUnorderedAccessView* PositionsUAV, FRHIUnorderedAccessView* TangentsUAV, FRHIUnorderedAccessView* IndicesUAV,
+								int32 NumPoints, bool bFaceCamera, FVector3f CameraPosition, bool bWriteIndices);
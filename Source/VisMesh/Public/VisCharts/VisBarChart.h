@@ -8,6 +8,25 @@
 #include "VisBarChart.generated.h"
 
 class UVisMeshProceduralComponent;
+class UVisMeshInstancedComponent;
+
+/** 聚合瓦片的高度取值 */
+UENUM(BlueprintType)
+enum class EVisBarAggregateHeight : uint8
+{
+	Max,
+	Mean,
+	Min
+};
+
+/** 聚合金字塔节点：Level L 的节点覆盖 2^L x 2^L 个格子 */
+struct FVisBarAggregate
+{
+	float Min = MAX_flt;
+	float Max = -MAX_flt;
+	double Sum = 0.0;
+	int32 Count = 0;
+};
 
 UCLASS()
 class VISMESH_API AVisBarChart : public AActor
@@ -35,9 +54,17 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VisMesh")
 	UVisMeshProceduralComponent* SelectionMeshComponent;
 
+	/** 实例化渲染后端 (bUseInstancedRendering 为 true 时使用) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VisMesh")
+	UVisMeshInstancedComponent* InstancedMeshComponent;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh")
 	UMaterialInterface* MainMeshMaterial;
 
+	/** 实例化模式的材质，为空时使用 MainMeshMaterial。柱子的原始数值由顶点工厂经 PerInstanceRandom 传入 (材质不能同时使用 PerInstanceCustomData)，可在材质中做颜色映射 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh")
+	UMaterialInterface* InstancedMeshMaterial;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh")
 	UMaterialInterface* HighlightMeshMaterial;
 
@@ -71,6 +98,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
 	int NumInstances = 1000;
 
+	/** 用实例化代替合并网格：每根柱子只上传 (高度, 数值) 两个 float，实例变换与视锥剔除在 GPU 上完成。在 GenerateBarChart 时生效 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	bool bUseInstancedRendering = false;
+
+	/** 大于 0 时，实例化模式下 GenerateBarChart 收到同样数量的数据会在这段时间 (秒) 内从旧高度/颜色过渡到新数值，插值在 GPU 上完成 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (ClampMin = "0", EditCondition = "bUseInstancedRendering"))
+	float TransitionDuration = 0.f;
+
+	/** 实例化模式下按相机距离把远处的柱子合并为 min/mean/max 聚合瓦片，实例数量由屏幕分辨率而不是数据量决定 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (EditCondition = "bUseInstancedRendering"))
+	bool bUseLODAggregation = false;
+
+	/** 瓦片在屏幕上不超过这个尺寸 (像素) 时不再细分 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (ClampMin = "0.5", EditCondition = "bUseLODAggregation"))
+	float LODTilePixelSize = 4.0f;
+
+	/** 聚合瓦片的高度取值，颜色值始终为均值 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (EditCondition = "bUseLODAggregation"))
+	EVisBarAggregateHeight LODTileHeight = EVisBarAggregateHeight::Max;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Chart Runtime")
 	int32 GridColumnCount = 1;
 
@@ -78,6 +125,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Chart")
 	void GenerateBarChart(const TArray<float>& DataValues);
 
+	/** 只更新部分柱子的数值 (Indices 与 NewValues 一一对应)：每根柱子只重写 24 个顶点，并按区间上传到 GPU */
+	UFUNCTION(BlueprintCallable, Category = "Chart")
+	void UpdateBarValues(const TArray<int32>& Indices, const TArray<float>& NewValues);
+
+	/** 连续区间版本：更新 [FirstIndex, FirstIndex + NewValues.Num()) 的柱子 */
+	UFUNCTION(BlueprintCallable, Category = "Chart")
+	void UpdateBarValueRange(int32 FirstIndex, const TArray<float>& NewValues);
+
 private:
 	TArray<float> CachedDataValues;
 	
@@ -87,8 +142,64 @@ private:
 
 	int32 SelectedIndex = -1;
 
+	/** 当前图表是否由 InstancedMeshComponent 绘制 (上一次 GenerateBarChart 时的 bUseInstancedRendering) */
+	bool bInstancedBars = false;
+
+	/** 当前图表是否使用聚合瓦片 (上一次 GenerateBarChart 时的 bUseLODAggregation) */
+	bool bLODBars = false;
+
+	/** 原始数值的 min/mean/max 金字塔：Level 0 为每个格子 (空格子 Count 为 0)，逐级 2x2 合并，最后一级为 1x1 */
+	TArray<TArray<FVisBarAggregate>> AggregatePyramid;
+
+	/** 数据变化后需要重新选择瓦片 */
+	bool bLODTilesDirty = false;
+
+	/** 上一次选择瓦片时的相机 (图表局部空间) */
+	FVector LastLODCameraLocation = FVector::ZeroVector;
+	FVector LastLODCameraDirection = FVector::ZeroVector;
+	float LastLODFOV = 0.f;
+	FIntPoint LastLODViewportSize = FIntPoint::ZeroValue;
+
+	/** 柱顶高度的最大值金字塔：Level 0 为每个格子的柱顶高度 (空格子为 -MAX_flt)，逐级 2x2 取最大，最后一级为 1x1 */
+	TArray<TArray<float>> HeightPyramid;
+
+	int32 GridRowCount = 0;
+
+	/** 所有柱子底面的最低高度 (负值柱子向下延伸) */
+	float MinBarZ = 0.f;
+
+	/** 每帧缓存一次鼠标拾取结果，Tick 与 HandleClick 共用 */
+	int32 CachedCursorHitIndex = -1;
+
+	uint64 CachedCursorHitFrame = MAX_uint64;
+
 	void HandleClick();
 
+	void BuildHeightPyramid();
+
+	/** 只重新计算包含这些柱子的金字塔节点 (SortedBars 升序且无重复) */
+	void UpdateHeightPyramid(const TArray<int32>& SortedBars);
+
+	/** 按当前数值重写 SortedBars 的顶点，并只上传这些顶点区间 */
+	void ApplyBarValueUpdates(const TArray<int32>& SortedBars);
+
+	/** 实例化模式：生成每根柱子的 (高度, 数值)，bAnimate 为 true 时从当前显示的数值过渡 */
+	void GenerateInstancedBars(bool bAnimate);
+
+	void BuildAggregatePyramid();
+
+	/** 只重新计算包含这些柱子的聚合节点 (SortedBars 升序且无重复) */
+	void UpdateAggregatePyramid(const TArray<int32>& SortedBars);
+
+	/** 相机变化或数据变化时，按瓦片的屏幕尺寸从金字塔顶层向下细分，并上传选中的瓦片 */
+	void UpdateLODTiles();
+
+	/** 写入一根柱子的全部模板顶点位置 */
+	void WriteBarPositions(int32 BarIndex, FVector* OutPositions) const;
+
+	/** 当前帧鼠标下的柱子索引 (同一帧内只做一次 Raycast) */
+	int32 GetBarUnderCursor();
+
 	int32 RaycastOnBarChart(FVector LocalStart, FVector LocalDir) const;
 
 	void GenerateSelectionFrame(float Width, float Height, float Thickness);
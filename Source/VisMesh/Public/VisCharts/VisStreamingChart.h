@@ -0,0 +1,77 @@
+// Copyright ZJU CAD. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "VisStreamingChart.generated.h"
+
+class UVisMeshTimeSeriesComponent;
+
+/**
+ *	Scrolling multi-channel line chart for streaming telemetry.
+ *	Samples are appended to a GPU ring buffer; each append uploads only the new samples and the chart scrolls by
+ *	advancing the ring head, so the cost per append is O(new samples) regardless of the history length.
+ */
+UCLASS()
+class VISMESH_API AVisStreamingChart : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AVisStreamingChart();
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "VisMesh")
+	UVisMeshTimeSeriesComponent* SeriesComponent;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "VisMesh")
+	UMaterialInterface* SeriesMaterial;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (ClampMin = "1"))
+	int32 NumChannels = 64;
+
+	/** 每个通道保留的采样数 (历史长度) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (ClampMin = "2"))
+	int32 SamplesPerChannel = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	float SampleSpacing = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	float ChannelSpacing = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	float HeightMultiplier = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	float LineWidth = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config")
+	TArray<FLinearColor> ChannelColors;
+
+	/** 大于 0 时每秒为每个通道生成这么多个测试采样 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Config", meta = (ClampMin = "0"))
+	float TestSamplesPerSecond = 0.f;
+
+	/** 按当前配置重建环形缓冲区 (清空所有采样) */
+	UFUNCTION(BlueprintCallable, Category = "Chart")
+	void ResetStream();
+
+	/** 追加若干帧：Frames 为 N * NumChannels 个值，每帧包含所有通道 */
+	UFUNCTION(BlueprintCallable, Category = "Chart")
+	void AppendSamples(const TArray<float>& Frames);
+
+private:
+	/** 测试信号的累计时间与尚未生成的采样数 */
+	double TestTime = 0.0;
+	double PendingTestSamples = 0.0;
+};